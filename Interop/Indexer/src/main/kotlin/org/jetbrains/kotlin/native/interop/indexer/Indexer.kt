@@ -20,6 +20,7 @@ import clang.*
 import clang.CXIdxEntityKind.*
 import clang.CXTypeKind.*
 import kotlinx.cinterop.*
+import java.io.File
 
 private class StructDeclImpl(spelling: String, override val location: Location) : StructDecl(spelling) {
     override var def: StructDefImpl? = null
@@ -76,6 +77,8 @@ private class ObjCCategoryImpl(
 
 internal class NativeIndexImpl(val library: NativeLibrary, val verbose: Boolean = false) : NativeIndex() {
 
+    val includedFiles = mutableSetOf<String>()
+
     private sealed class DeclarationID {
         data class USR(val usr: String) : DeclarationID()
         object VaList : DeclarationID()
@@ -987,22 +990,39 @@ internal class NativeIndexImpl(val library: NativeLibrary, val verbose: Boolean
 
 }
 
-fun buildNativeIndexImpl(library: NativeLibrary, verbose: Boolean): IndexerResult {
+fun buildNativeIndexImpl(
+        library: NativeLibrary,
+        verbose: Boolean,
+        precompiledHeadersCacheDir: File?
+): IndexerResult {
     val result = NativeIndexImpl(library, verbose)
-    val compilation = indexDeclarations(result)
-    return IndexerResult(result, compilation)
+    val precompiledHeadersCache = precompiledHeadersCacheDir?.let { PrecompiledHeadersCache(it) }
+    val compilation = indexDeclarations(result, precompiledHeadersCache)
+    return IndexerResult(result, compilation, result.includedFiles)
 }
 
-private fun indexDeclarations(nativeIndex: NativeIndexImpl): CompilationWithPCH {
+private fun indexDeclarations(
+        nativeIndex: NativeIndexImpl,
+        precompiledHeadersCache: PrecompiledHeadersCache?
+): CompilationWithPCH {
     withIndex { index ->
-        val translationUnit = nativeIndex.library.copyWithArgsForPCH().parse(
-                index,
-                options = CXTranslationUnit_DetailedPreprocessingRecord or CXTranslationUnit_ForSerialization
-        )
+        val compilationForPCH = nativeIndex.library.copyWithArgsForPCH()
+        val options = CXTranslationUnit_DetailedPreprocessingRecord or CXTranslationUnit_ForSerialization
+        val cacheEntry = precompiledHeadersCache?.Entry(compilationForPCH)
+        val cachedTranslationUnit = cacheEntry?.load(index)
+        val translationUnit = cachedTranslationUnit
+                ?: cacheEntry?.parse(index, options)
+                ?: compilationForPCH.parse(index, options)
         try {
             translationUnit.ensureNoCompileErrors()
 
-            val compilation = nativeIndex.library.withPrecompiledHeader(translationUnit)
+            val compilation = if (cacheEntry != null) {
+                if (cachedTranslationUnit == null) cacheEntry.save(translationUnit)
+                CompilationWithPCH(nativeIndex.library.compilerArgs, cacheEntry.precompiledHeader.absolutePath,
+                        nativeIndex.library.language)
+            } else {
+                nativeIndex.library.withPrecompiledHeader(translationUnit)
+            }
 
             val headers = getFilteredHeaders(nativeIndex, index, translationUnit)
 
@@ -1010,7 +1030,16 @@ private fun indexDeclarations(nativeIndex: NativeIndexImpl): CompilationWithPCH
                 nativeIndex.getHeaderId(it)
             }
 
+            val importedASTFiles = mutableListOf<String>()
             indexTranslationUnit(index, translationUnit, 0, object : Indexer {
+                override fun ppIncludedFile(info: CXIdxIncludedFileInfo) {
+                    nativeIndex.includedFiles += info.file!!.path
+                }
+
+                override fun importedASTFile(info: CXIdxImportedASTFileInfo) {
+                    importedASTFiles += info.file!!.path
+                }
+
                 override fun indexDeclaration(info: CXIdxDeclInfo) {
                     val file = memScoped {
                         val fileVar = alloc<CXFileVar>()
@@ -1024,6 +1053,9 @@ private fun indexDeclarations(nativeIndex: NativeIndexImpl): CompilationWithPCH
                 }
             })
 
+            // Clang modules: headers are not #included into the translation unit, but built into module files.
+            nativeIndex.includedFiles += getModulesInputHeaders(index, importedASTFiles)
+
             visitChildren(clang_getTranslationUnitCursor(translationUnit)) { cursor, _ ->
                 val file = getContainingFile(cursor)
                 if (file in headers && nativeIndex.library.includesDeclaration(cursor)) {
@@ -77,6 +77,35 @@ private fun getModulesASTFiles(index: CXIndex, compilation: ModularCompilation,
     return result.toList()
 }
 
+/**
+ * Returns paths of the headers the modules at [astFiles], and the modules imported by them, were built from.
+ * Module files are only rebuilt when clang runs, so they cannot be used to tell whether their headers changed.
+ */
+internal fun getModulesInputHeaders(index: CXIndex, astFiles: Collection<String>): Set<String> {
+    val result = mutableSetOf<String>()
+    val visited = mutableSetOf<String>()
+    val toVisit = astFiles.toMutableList()
+    while (toVisit.isNotEmpty()) {
+        val astFile = toVisit.removeAt(toVisit.lastIndex)
+        if (!visited.add(astFile)) continue
+        val moduleTranslationUnit = clang_createTranslationUnit(index, astFile)!!
+        try {
+            indexTranslationUnit(index, moduleTranslationUnit, 0, object : Indexer {
+                override fun ppIncludedFile(info: CXIdxIncludedFileInfo) {
+                    result += info.file!!.path
+                }
+
+                override fun importedASTFile(info: CXIdxImportedASTFileInfo) {
+                    toVisit += info.file!!.path
+                }
+            })
+        } finally {
+            clang_disposeTranslationUnit(moduleTranslationUnit)
+        }
+    }
+    return result
+}
+
 private fun getModulesHeaders(
         index: CXIndex,
         translationUnit: CXTranslationUnit,
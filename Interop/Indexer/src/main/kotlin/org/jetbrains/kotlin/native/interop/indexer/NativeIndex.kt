@@ -16,6 +16,8 @@
 
 package org.jetbrains.kotlin.native.interop.indexer
 
+import java.io.File
+
 enum class Language(val sourceFileExtension: String) {
     C("c"),
     OBJECTIVE_C("m")
@@ -83,12 +85,24 @@ data class NativeLibrary(override val includes: List<String>,
                          val headerExclusionPolicy: HeaderExclusionPolicy,
                          val headerFilter: NativeLibraryHeaderFilter) : Compilation
 
-data class IndexerResult(val index: NativeIndex, val compilation: CompilationWithPCH)
+/**
+ * @property includedFiles paths of all the files #included into the translation unit the index has been built from,
+ * including the headers of the Clang modules imported by it.
+ */
+data class IndexerResult(
+        val index: NativeIndex,
+        val compilation: CompilationWithPCH,
+        val includedFiles: Set<String>
+)
 
 /**
  * Retrieves the definitions from given C header file using given compiler arguments (e.g. defines).
  */
-fun buildNativeIndex(library: NativeLibrary, verbose: Boolean): IndexerResult = buildNativeIndexImpl(library, verbose)
+fun buildNativeIndex(
+        library: NativeLibrary,
+        verbose: Boolean,
+        precompiledHeadersCacheDir: File? = null
+): IndexerResult = buildNativeIndexImpl(library, verbose, precompiledHeadersCacheDir)
 
 /**
  * This class describes the IR of definitions from C header file(s).
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.kotlin.native.interop.indexer
+
+import clang.*
+import kotlinx.cinterop.*
+import java.io.File
+import java.nio.file.Files
+import java.nio.file.StandardCopyOption
+import java.security.MessageDigest
+
+/**
+ * Directory of translation units saved with `clang_saveTranslationUnit` and reused across cinterop invocations.
+ *
+ * A saved translation unit is addressed by the hash of the preamble and compiler arguments it has been parsed from,
+ * so libraries sharing the same header set share it. Its source file is kept next to it: clang validates
+ * all the input files (including the source one) when loading the saved unit and refuses it if any has changed.
+ *
+ * Files are published with an atomic rename, so the directory can be shared by cinterop processes running in parallel.
+ */
+internal class PrecompiledHeadersCache(private val directory: File) {
+
+    inner class Entry(val compilation: Compilation) {
+        private val key: String = MessageDigest.getInstance("SHA-1").run {
+            listOf(clang_getClangVersion().convertAndDispose(), compilation.language.name)
+                    .plus(compilation.preambleLines)
+                    .plus(compilation.compilerArgs)
+                    .forEach {
+                        update(it.toByteArray())
+                        update(0)
+                    }
+            digest().joinToString("") { (it.toInt() and 0xff).toString(16).padStart(2, '0') }
+        }
+
+        val sourceFile = File(directory, "$key.${compilation.language.sourceFileExtension}")
+        val precompiledHeader = File(directory, "$key.pch")
+
+        /**
+         * Loads the translation unit saved by a previous run, or returns `null` if there is none or it is out of date.
+         */
+        fun load(index: CXIndex): CXTranslationUnit? {
+            if (!precompiledHeader.isFile) return null
+
+            val translationUnit = memScoped {
+                val resultVar = alloc<CXTranslationUnitVar>()
+                val errorCode = clang_createTranslationUnit2(index, precompiledHeader.absolutePath, resultVar.ptr)
+                if (errorCode != CXErrorCode.CXError_Success) return null
+                resultVar.value ?: return null
+            }
+
+            if (translationUnit.getDiagnostics().any { it.isError() }) {
+                clang_disposeTranslationUnit(translationUnit)
+                return null
+            }
+            return translationUnit
+        }
+
+        fun parse(index: CXIndex, options: Int): CXTranslationUnit {
+            if (!sourceFile.isFile) {
+                publish(sourceFile) { file ->
+                    file.bufferedWriter().use { it.appendPreamble(compilation) }
+                }
+            }
+            return parseTranslationUnit(index, sourceFile, compilation.compilerArgs, options)
+        }
+
+        fun save(translationUnit: CXTranslationUnit) {
+            publish(precompiledHeader) { file ->
+                clang_saveTranslationUnit(translationUnit, file.absolutePath, 0)
+            }
+        }
+    }
+
+    private fun publish(file: File, write: (File) -> Unit) {
+        directory.mkdirs()
+        val temporaryFile = createTempFile(file.name, ".tmp", directory)
+        try {
+            write(temporaryFile)
+            Files.move(temporaryFile.toPath(), file.toPath(),
+                    StandardCopyOption.ATOMIC_MOVE, StandardCopyOption.REPLACE_EXISTING)
+        } finally {
+            temporaryFile.delete()
+        }
+    }
+}
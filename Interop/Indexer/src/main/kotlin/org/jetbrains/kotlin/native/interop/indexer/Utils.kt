@@ -142,7 +142,7 @@ internal fun CXTranslationUnit.getDiagnostics(): Sequence<Diagnostic> {
 internal fun CXTranslationUnit.getCompileErrors(): Sequence<String> =
         getDiagnostics().filter { it.isError() }.map { it.format }
 
-private fun Diagnostic.isError() = (severity == CXDiagnosticSeverity.CXDiagnostic_Error) ||
+internal fun Diagnostic.isError() = (severity == CXDiagnosticSeverity.CXDiagnostic_Error) ||
         (severity == CXDiagnosticSeverity.CXDiagnostic_Fatal)
 
 internal fun CXTranslationUnit.hasCompileErrors() = (this.getCompileErrors().firstOrNull() != null)
@@ -30,6 +30,23 @@ internal fun createStablePointer(any: Any): COpaquePointer = newGlobalRef(any).t
 
 internal fun disposeStablePointer(pointer: COpaquePointer) = deleteGlobalRef(pointer.toLong())
 
+internal fun createStablePointers(
+        objects: Array<out Any>,
+        startIndex: Int,
+        endIndex: Int,
+        destination: CPointer<COpaquePointerVar>
+) {
+    for (index in startIndex until endIndex) {
+        destination[index - startIndex] = createStablePointer(objects[index])
+    }
+}
+
+internal fun disposeStablePointers(pointers: CPointer<COpaquePointerVar>, count: Int) {
+    for (index in 0 until count) {
+        pointers[index]?.let { disposeStablePointer(it) }
+    }
+}
+
 @PublishedApi
 internal fun derefStablePointer(pointer: COpaquePointer): Any = derefGlobalRef(pointer.toLong())
 
@@ -83,6 +83,159 @@ internal object nativeMemUtils {
         unsafe.copyMemory(source, charArrayBaseOffset, null, dest.address, length.toLong() * 2)
     }
 
+    // Bulk transfers with `stride` being the distance in bytes between consecutive elements in native memory.
+
+    fun getByteArray(source: NativePointed, dest: ByteArray, destIndex: Int, length: Int, stride: Int) {
+        checkRange(destIndex, length, dest.size)
+        if (stride == 1) {
+            unsafe.copyMemory(null, source.address, dest, byteArrayBaseOffset + destIndex, length.toLong())
+        } else {
+            for (index in 0 until length) {
+                dest[destIndex + index] = unsafe.getByte(source.address + index.toLong() * stride)
+            }
+        }
+    }
+
+    fun putByteArray(source: ByteArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int) {
+        checkRange(sourceIndex, length, source.size)
+        if (stride == 1) {
+            unsafe.copyMemory(source, byteArrayBaseOffset + sourceIndex, null, dest.address, length.toLong())
+        } else {
+            for (index in 0 until length) {
+                unsafe.putByte(dest.address + index.toLong() * stride, source[sourceIndex + index])
+            }
+        }
+    }
+
+    fun getShortArray(source: NativePointed, dest: ShortArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(destIndex, length, dest.size)
+        if (stride == 2 && !swapBytes) {
+            unsafe.copyMemory(null, source.address, dest, shortArrayBaseOffset + destIndex.toLong() * 2, length.toLong() * 2)
+        } else {
+            for (index in 0 until length) {
+                val address = source.address + index.toLong() * stride
+                dest[destIndex + index] = if (swapBytes) java.lang.Short.reverseBytes(unsafe.getShort(address)) else unsafe.getShort(address)
+            }
+        }
+    }
+
+    fun putShortArray(source: ShortArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(sourceIndex, length, source.size)
+        if (stride == 2 && !swapBytes) {
+            unsafe.copyMemory(source, shortArrayBaseOffset + sourceIndex.toLong() * 2, null, dest.address, length.toLong() * 2)
+        } else {
+            for (index in 0 until length) {
+                val address = dest.address + index.toLong() * stride
+                val value = source[sourceIndex + index]
+                if (swapBytes) unsafe.putShort(address, java.lang.Short.reverseBytes(value)) else unsafe.putShort(address, value)
+            }
+        }
+    }
+
+    fun getIntArray(source: NativePointed, dest: IntArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(destIndex, length, dest.size)
+        if (stride == 4 && !swapBytes) {
+            unsafe.copyMemory(null, source.address, dest, intArrayBaseOffset + destIndex.toLong() * 4, length.toLong() * 4)
+        } else {
+            for (index in 0 until length) {
+                val address = source.address + index.toLong() * stride
+                dest[destIndex + index] = if (swapBytes) Integer.reverseBytes(unsafe.getInt(address)) else unsafe.getInt(address)
+            }
+        }
+    }
+
+    fun putIntArray(source: IntArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(sourceIndex, length, source.size)
+        if (stride == 4 && !swapBytes) {
+            unsafe.copyMemory(source, intArrayBaseOffset + sourceIndex.toLong() * 4, null, dest.address, length.toLong() * 4)
+        } else {
+            for (index in 0 until length) {
+                val address = dest.address + index.toLong() * stride
+                val value = source[sourceIndex + index]
+                if (swapBytes) unsafe.putInt(address, Integer.reverseBytes(value)) else unsafe.putInt(address, value)
+            }
+        }
+    }
+
+    fun getLongArray(source: NativePointed, dest: LongArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(destIndex, length, dest.size)
+        if (stride == 8 && !swapBytes) {
+            unsafe.copyMemory(null, source.address, dest, longArrayBaseOffset + destIndex.toLong() * 8, length.toLong() * 8)
+        } else {
+            for (index in 0 until length) {
+                val address = source.address + index.toLong() * stride
+                dest[destIndex + index] = if (swapBytes) java.lang.Long.reverseBytes(unsafe.getLong(address)) else unsafe.getLong(address)
+            }
+        }
+    }
+
+    fun putLongArray(source: LongArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(sourceIndex, length, source.size)
+        if (stride == 8 && !swapBytes) {
+            unsafe.copyMemory(source, longArrayBaseOffset + sourceIndex.toLong() * 8, null, dest.address, length.toLong() * 8)
+        } else {
+            for (index in 0 until length) {
+                val address = dest.address + index.toLong() * stride
+                val value = source[sourceIndex + index]
+                if (swapBytes) unsafe.putLong(address, java.lang.Long.reverseBytes(value)) else unsafe.putLong(address, value)
+            }
+        }
+    }
+
+    fun getFloatArray(source: NativePointed, dest: FloatArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(destIndex, length, dest.size)
+        if (stride == 4 && !swapBytes) {
+            unsafe.copyMemory(null, source.address, dest, floatArrayBaseOffset + destIndex.toLong() * 4, length.toLong() * 4)
+        } else {
+            for (index in 0 until length) {
+                val address = source.address + index.toLong() * stride
+                dest[destIndex + index] = if (swapBytes) java.lang.Float.intBitsToFloat(Integer.reverseBytes(unsafe.getInt(address))) else unsafe.getFloat(address)
+            }
+        }
+    }
+
+    fun putFloatArray(source: FloatArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(sourceIndex, length, source.size)
+        if (stride == 4 && !swapBytes) {
+            unsafe.copyMemory(source, floatArrayBaseOffset + sourceIndex.toLong() * 4, null, dest.address, length.toLong() * 4)
+        } else {
+            for (index in 0 until length) {
+                val address = dest.address + index.toLong() * stride
+                val value = source[sourceIndex + index]
+                if (swapBytes) unsafe.putInt(address, Integer.reverseBytes(java.lang.Float.floatToRawIntBits(value))) else unsafe.putFloat(address, value)
+            }
+        }
+    }
+
+    fun getDoubleArray(source: NativePointed, dest: DoubleArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(destIndex, length, dest.size)
+        if (stride == 8 && !swapBytes) {
+            unsafe.copyMemory(null, source.address, dest, doubleArrayBaseOffset + destIndex.toLong() * 8, length.toLong() * 8)
+        } else {
+            for (index in 0 until length) {
+                val address = source.address + index.toLong() * stride
+                dest[destIndex + index] = if (swapBytes) java.lang.Double.longBitsToDouble(java.lang.Long.reverseBytes(unsafe.getLong(address))) else unsafe.getDouble(address)
+            }
+        }
+    }
+
+    fun putDoubleArray(source: DoubleArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) {
+        checkRange(sourceIndex, length, source.size)
+        if (stride == 8 && !swapBytes) {
+            unsafe.copyMemory(source, doubleArrayBaseOffset + sourceIndex.toLong() * 8, null, dest.address, length.toLong() * 8)
+        } else {
+            for (index in 0 until length) {
+                val address = dest.address + index.toLong() * stride
+                val value = source[sourceIndex + index]
+                if (swapBytes) unsafe.putLong(address, java.lang.Long.reverseBytes(java.lang.Double.doubleToRawLongBits(value))) else unsafe.putDouble(address, value)
+            }
+        }
+    }
+
+    private fun checkRange(index: Int, length: Int, size: Int) {
+        if (index < 0 || length < 0 || index.toLong() + length > size) throw ArrayIndexOutOfBoundsException()
+    }
+
     fun zeroMemory(dest: NativePointed, length: Int): Unit =
             unsafe.setMemory(dest.address, length.toLong(), 0)
 
@@ -115,4 +268,9 @@ internal object nativeMemUtils {
 
     private val byteArrayBaseOffset = unsafe.arrayBaseOffset(ByteArray::class.java).toLong()
     private val charArrayBaseOffset = unsafe.arrayBaseOffset(CharArray::class.java).toLong()
+    private val shortArrayBaseOffset = unsafe.arrayBaseOffset(ShortArray::class.java).toLong()
+    private val intArrayBaseOffset = unsafe.arrayBaseOffset(IntArray::class.java).toLong()
+    private val longArrayBaseOffset = unsafe.arrayBaseOffset(LongArray::class.java).toLong()
+    private val floatArrayBaseOffset = unsafe.arrayBaseOffset(FloatArray::class.java).toLong()
+    private val doubleArrayBaseOffset = unsafe.arrayBaseOffset(DoubleArray::class.java).toLong()
 }
@@ -23,6 +23,35 @@ import java.nio.file.Paths
 internal fun decodeFromUtf8(bytes: ByteArray) = String(bytes)
 internal fun encodeToUtf8(str: String) = str.toByteArray()
 
+internal fun createUtf8CString(string: String): CValues<ByteVar> = CString(encodeToUtf8(string))
+
+internal fun decodeUtf8CString(pointer: CPointer<ByteVar>): String {
+    var length = 0
+    while (pointer[length] != 0.toByte()) {
+        ++length
+    }
+
+    val bytes = ByteArray(length)
+    nativeMemUtils.getByteArray(pointer.pointed, bytes, length)
+    return decodeFromUtf8(bytes)
+}
+
+internal fun decodeUtf16CString(pointer: CPointer<ShortVar>): String {
+    var length = 0
+    while (pointer[length] != 0.toShort()) {
+        ++length
+    }
+
+    val chars = CharArray(length)
+    nativeMemUtils.getCharArray(pointer.pointed, chars, length)
+    return String(chars)
+}
+
+private val arenaChunkPools = ThreadLocal.withInitial { ArenaChunkPool() }
+
+internal val arenaChunkPool: ArenaChunkPool
+    get() = arenaChunkPools.get()
+
 fun bitsToFloat(bits: Int): Float = java.lang.Float.intBitsToFloat(bits)
 fun bitsToDouble(bits: Long): Double = java.lang.Double.longBitsToDouble(bits)
 
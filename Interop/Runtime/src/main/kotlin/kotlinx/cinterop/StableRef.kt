@@ -38,6 +38,39 @@ public inline class StableRef<out T : Any> @PublishedApi internal constructor(
          */
         fun <T : Any> create(any: T) = StableRef<T>(createStablePointer(any))
 
+        /**
+         * Creates handles for objects of [objects] in the range from [startIndex] (inclusive) to [endIndex] (exclusive)
+         * and stores them to [destination] as C pointers, in a single call to the runtime.
+         *
+         * Each of the handles should be disposed, e.g. with [disposeAll].
+         *
+         * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+         * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+         */
+        fun createAll(
+                objects: Array<out Any>,
+                destination: CPointer<COpaquePointerVar>,
+                startIndex: Int = 0,
+                endIndex: Int = objects.size
+        ) {
+            if (startIndex < 0 || endIndex > objects.size) {
+                throw IndexOutOfBoundsException("startIndex: $startIndex, endIndex: $endIndex, size: ${objects.size}")
+            }
+            if (startIndex > endIndex) {
+                throw IllegalArgumentException("startIndex: $startIndex > endIndex: $endIndex")
+            }
+            createStablePointers(objects, startIndex, endIndex, destination)
+        }
+
+        /**
+         * Disposes [count] handles stored as C pointers at [pointers], in a single call to the runtime.
+         * They must not be used after that.
+         */
+        fun disposeAll(pointers: CPointer<COpaquePointerVar>, count: Int) {
+            require(count >= 0) { "count: $count" }
+            disposeStablePointers(pointers, count)
+        }
+
         /**
          * Creates [StableRef] from given raw value.
          *
@@ -69,17 +69,107 @@ public abstract class AutofreeScope : DeferScope(), NativePlacement {
     abstract override fun alloc(size: Long, align: Int): NativePointed
 }
 
+/**
+ * Size of the native memory chunks [ArenaBase] places its allocations into.
+ */
+private const val ARENA_CHUNK_SIZE = 4096L
+
+/**
+ * Allocations larger than this (or with stricter alignment than [ARENA_MAX_CHUNK_ALIGN])
+ * don't go to chunks and are requested from the parent placement directly.
+ */
+private const val ARENA_MAX_CHUNK_ALLOCATION_SIZE = ARENA_CHUNK_SIZE / 4
+private const val ARENA_MAX_CHUNK_ALIGN = 64
+
+/**
+ * Maximum number of free chunks kept by the [ArenaChunkPool] of a single thread.
+ */
+private const val ARENA_CHUNK_POOL_CAPACITY = 8
+
+private fun alignUp(value: Long, align: Int): Long = (value + align - 1) and (align - 1).toLong().inv()
+
+/**
+ * Free list of zero-filled [ARENA_CHUNK_SIZE]-byte chunks allocated from [nativeHeap],
+ * linked through their first word.
+ * Each thread has its own pool (see [arenaChunkPool]), so the pool requires no synchronization.
+ * Chunks left in the pool when a thread terminates are not reclaimed.
+ */
+internal class ArenaChunkPool {
+    private var head: NativePointed? = null
+    private var size = 0
+
+    fun take(): NativePointed {
+        val chunk = head ?: return nativeHeap.alloc(ARENA_CHUNK_SIZE, pointerSize)
+        head = interpretNullableOpaquePointed(nativeMemUtils.getNativePtr(chunk))
+        nativeMemUtils.putNativePtr(chunk, nativeNullPtr)
+        --size
+        return chunk
+    }
+
+    /**
+     * Returns the [chunk] to the pool. Only first [usedSize] bytes of the chunk are assumed to be dirty.
+     */
+    fun recycle(chunk: NativePointed, usedSize: Long) {
+        if (size >= ARENA_CHUNK_POOL_CAPACITY) {
+            nativeHeap.free(chunk)
+            return
+        }
+        nativeMemUtils.zeroMemory(chunk, usedSize.toInt())
+        nativeMemUtils.putNativePtr(chunk, head.rawPtr)
+        head = chunk
+        ++size
+    }
+}
+
 public open class ArenaBase(private val parent: NativeFreeablePlacement = nativeHeap) : AutofreeScope() {
 
-    private var lastChunk: NativePointed? = null
+    // Chunks are linked through their first word, allocations are bump-pointer placed after it.
+    private var currentChunk: NativePointed? = null
+    private var currentChunkTop = 0L
+
+    // Allocations not fitting into chunks, each prepended with a pointer to the previous one.
+    private var lastLargeChunk: NativePointed? = null
 
     final override fun alloc(size: Long, align: Int): NativePointed {
+        val chunk = currentChunk
+        if (chunk != null) {
+            val chunkStart = chunk.rawPtr.toLong()
+            val offset = alignUp(chunkStart + currentChunkTop, align) - chunkStart
+            if (offset + size <= ARENA_CHUNK_SIZE) {
+                currentChunkTop = offset + size
+                return interpretOpaquePointed(chunk.rawPtr + offset)
+            }
+        }
+
+        return allocSlowPath(size, align)
+    }
+
+    private fun allocSlowPath(size: Long, align: Int): NativePointed {
+        if (size > ARENA_MAX_CHUNK_ALLOCATION_SIZE || align > ARENA_MAX_CHUNK_ALIGN) {
+            return allocLarge(size, align)
+        }
+
+        val chunk = if (parent === nativeHeap) {
+            arenaChunkPool.take()
+        } else {
+            parent.alloc(ARENA_CHUNK_SIZE, pointerSize)
+        }
+        nativeMemUtils.putNativePtr(chunk, currentChunk.rawPtr)
+        currentChunk = chunk
+
+        val chunkStart = chunk.rawPtr.toLong()
+        val offset = alignUp(chunkStart + pointerSize, align) - chunkStart
+        currentChunkTop = offset + size
+        return interpretOpaquePointed(chunk.rawPtr + offset)
+    }
+
+    private fun allocLarge(size: Long, align: Int): NativePointed {
         // Reserve space for a pointer:
         val gapForPointer = maxOf(pointerSize, align)
 
         val chunk = parent.alloc(size = gapForPointer + size, align = gapForPointer)
-        nativeMemUtils.putNativePtr(chunk, lastChunk.rawPtr)
-        lastChunk = chunk
+        nativeMemUtils.putNativePtr(chunk, lastLargeChunk.rawPtr)
+        lastLargeChunk = chunk
         return interpretOpaquePointed(chunk.rawPtr + gapForPointer.toLong())
     }
 
@@ -87,12 +177,29 @@ public open class ArenaBase(private val parent: NativeFreeablePlacement = native
     internal fun clearImpl() {
         this.executeAllDeferred()
 
-        var chunk = lastChunk
+        var chunk = currentChunk
+        var usedSize = currentChunkTop
+        val pool = if (chunk != null && parent === nativeHeap) arenaChunkPool else null
+        while (chunk != null) {
+            val nextChunk = nativeMemUtils.getNativePtr(chunk)
+            if (pool != null) {
+                pool.recycle(chunk, usedSize)
+            } else {
+                parent.free(chunk)
+            }
+            chunk = interpretNullableOpaquePointed(nextChunk)
+            usedSize = ARENA_CHUNK_SIZE
+        }
+        currentChunk = null
+        currentChunkTop = 0L
+
+        chunk = lastLargeChunk
         while (chunk != null) {
             val nextChunk = nativeMemUtils.getNativePtr(chunk)
             parent.free(chunk)
             chunk = interpretNullableOpaquePointed(nextChunk)
         }
+        lastLargeChunk = null
     }
 
 }
@@ -212,11 +319,7 @@ public fun NativePlacement.allocArrayOf(elements: ByteArray): CArrayPointer<Byte
 
 public fun NativePlacement.allocArrayOf(vararg elements: Float): CArrayPointer<FloatVar> {
     val res = allocArray<FloatVar>(elements.size)
-    var index = 0
-    while (index < elements.size) {
-        res[index] = elements[index]
-        ++index
-    }
+    elements.copyToNative(res)
     return res
 }
 
@@ -371,7 +474,7 @@ public fun DoubleArray.toCValues() = cValuesOf(*this)
 public fun <T : CPointed> Array<CPointer<T>?>.toCValues() = cValuesOf(*this)
 public fun <T : CPointed> List<CPointer<T>?>.toCValues() = this.toTypedArray().toCValues()
 
-private class CString(val bytes: ByteArray): CValues<ByteVar>() {
+internal class CString(val bytes: ByteArray): CValues<ByteVar>() {
     override val size get() = bytes.size + 1
     override val align get() = 1
 
@@ -390,13 +493,13 @@ private class CString(val bytes: ByteArray): CValues<ByteVar>() {
  * @return the value of zero-terminated UTF-8-encoded C string constructed from given [kotlin.String].
  */
 public val String.cstr: CValues<ByteVar>
-    get() = CString(encodeToUtf8(this))
+    get() = createUtf8CString(this)
 
 /**
  * @return the value of zero-terminated UTF-8-encoded C string constructed from given [kotlin.String].
  */
 public val String.utf8: CValues<ByteVar>
-    get() = CString(encodeToUtf8(this))
+    get() = createUtf8CString(this)
 
 /**
  * Convert this list of Kotlin strings to C array of C strings,
@@ -481,22 +584,10 @@ public val String.utf32: CValues<IntVar>
     get() = U32CString(this.toCharArray())
 
 
-// TODO: optimize
 /**
  * @return the [kotlin.String] decoded from given zero-terminated UTF-8-encoded C string.
  */
-public fun CPointer<ByteVar>.toKStringFromUtf8(): String {
-    val nativeBytes = this
-
-    var length = 0
-    while (nativeBytes[length] != 0.toByte()) {
-        ++length
-    }
-
-    val bytes = ByteArray(length)
-    nativeMemUtils.getByteArray(nativeBytes.pointed, bytes, length)
-    return decodeFromUtf8(bytes)
-}
+public fun CPointer<ByteVar>.toKStringFromUtf8(): String = decodeUtf8CString(this)
 
 /**
  * @return the [kotlin.String] decoded from given zero-terminated UTF-8-encoded C string.
@@ -506,21 +597,7 @@ public fun CPointer<ByteVar>.toKString(): String = this.toKStringFromUtf8()
 /**
  * @return the [kotlin.String] decoded from given zero-terminated UTF-16-encoded C string.
  */
-public fun CPointer<ShortVar>.toKStringFromUtf16(): String {
-    val nativeBytes = this
-
-    var length = 0
-    while (nativeBytes[length] != 0.toShort()) {
-        ++length
-    }
-    val chars = CharArray(length)
-    var index = 0
-    while (index < length) {
-        chars[index] = nativeBytes[index].toChar()
-        ++index
-    }
-    return String(chars)
-}
+public fun CPointer<ShortVar>.toKStringFromUtf16(): String = decodeUtf16CString(this)
 
 /**
  * @return the [kotlin.String] decoded from given zero-terminated UTF-32-encoded C string.
@@ -637,3 +714,197 @@ public fun COpaquePointer.readBytes(count: Int): ByteArray {
     nativeMemUtils.getByteArray(this.reinterpret<ByteVar>().pointed, result, count)
     return result
 }
+
+/**
+ * Copies [count] bytes from native memory starting at this pointer into the [destination] array
+ * starting at [destinationOffset].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ */
+public fun CPointer<ByteVar>.copyFromNative(
+        destination: ByteArray,
+        destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset,
+        stride: Int = 1
+) {
+    nativeMemUtils.getByteArray(this.pointed, destination, destinationOffset, count, stride)
+}
+
+/**
+ * Copies bytes of this array in range [startIndex]..[endIndex] to native memory starting at [destination].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ */
+public fun ByteArray.copyToNative(
+        destination: CPointer<ByteVar>,
+        startIndex: Int = 0,
+        endIndex: Int = this.size,
+        stride: Int = 1
+) {
+    nativeMemUtils.putByteArray(this, startIndex, destination.pointed, endIndex - startIndex, stride)
+}
+
+/**
+ * Copies [count] elements from native memory starting at this pointer into the [destination] array
+ * starting at [destinationOffset].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when reading data of non-native endianness.
+ */
+public fun CPointer<ShortVar>.copyFromNative(
+        destination: ShortArray,
+        destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset,
+        stride: Int = 2,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.getShortArray(this.pointed, destination, destinationOffset, count, stride, swapBytes)
+}
+
+/**
+ * Copies elements of this array in range [startIndex]..[endIndex] to native memory starting at [destination].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when writing data of non-native endianness.
+ */
+public fun ShortArray.copyToNative(
+        destination: CPointer<ShortVar>,
+        startIndex: Int = 0,
+        endIndex: Int = this.size,
+        stride: Int = 2,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.putShortArray(this, startIndex, destination.pointed, endIndex - startIndex, stride, swapBytes)
+}
+
+/**
+ * Copies [count] elements from native memory starting at this pointer into the [destination] array
+ * starting at [destinationOffset].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when reading data of non-native endianness.
+ */
+public fun CPointer<IntVar>.copyFromNative(
+        destination: IntArray,
+        destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset,
+        stride: Int = 4,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.getIntArray(this.pointed, destination, destinationOffset, count, stride, swapBytes)
+}
+
+/**
+ * Copies elements of this array in range [startIndex]..[endIndex] to native memory starting at [destination].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when writing data of non-native endianness.
+ */
+public fun IntArray.copyToNative(
+        destination: CPointer<IntVar>,
+        startIndex: Int = 0,
+        endIndex: Int = this.size,
+        stride: Int = 4,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.putIntArray(this, startIndex, destination.pointed, endIndex - startIndex, stride, swapBytes)
+}
+
+/**
+ * Copies [count] elements from native memory starting at this pointer into the [destination] array
+ * starting at [destinationOffset].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when reading data of non-native endianness.
+ */
+public fun CPointer<LongVar>.copyFromNative(
+        destination: LongArray,
+        destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset,
+        stride: Int = 8,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.getLongArray(this.pointed, destination, destinationOffset, count, stride, swapBytes)
+}
+
+/**
+ * Copies elements of this array in range [startIndex]..[endIndex] to native memory starting at [destination].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when writing data of non-native endianness.
+ */
+public fun LongArray.copyToNative(
+        destination: CPointer<LongVar>,
+        startIndex: Int = 0,
+        endIndex: Int = this.size,
+        stride: Int = 8,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.putLongArray(this, startIndex, destination.pointed, endIndex - startIndex, stride, swapBytes)
+}
+
+/**
+ * Copies [count] elements from native memory starting at this pointer into the [destination] array
+ * starting at [destinationOffset].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when reading data of non-native endianness.
+ */
+public fun CPointer<FloatVar>.copyFromNative(
+        destination: FloatArray,
+        destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset,
+        stride: Int = 4,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.getFloatArray(this.pointed, destination, destinationOffset, count, stride, swapBytes)
+}
+
+/**
+ * Copies elements of this array in range [startIndex]..[endIndex] to native memory starting at [destination].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when writing data of non-native endianness.
+ */
+public fun FloatArray.copyToNative(
+        destination: CPointer<FloatVar>,
+        startIndex: Int = 0,
+        endIndex: Int = this.size,
+        stride: Int = 4,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.putFloatArray(this, startIndex, destination.pointed, endIndex - startIndex, stride, swapBytes)
+}
+
+/**
+ * Copies [count] elements from native memory starting at this pointer into the [destination] array
+ * starting at [destinationOffset].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when reading data of non-native endianness.
+ */
+public fun CPointer<DoubleVar>.copyFromNative(
+        destination: DoubleArray,
+        destinationOffset: Int = 0,
+        count: Int = destination.size - destinationOffset,
+        stride: Int = 8,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.getDoubleArray(this.pointed, destination, destinationOffset, count, stride, swapBytes)
+}
+
+/**
+ * Copies elements of this array in range [startIndex]..[endIndex] to native memory starting at [destination].
+ *
+ * @param stride the distance in bytes between consecutive elements in native memory.
+ * @param swapBytes whether to reverse the byte order of each element, e.g. when writing data of non-native endianness.
+ */
+public fun DoubleArray.copyToNative(
+        destination: CPointer<DoubleVar>,
+        startIndex: Int = 0,
+        endIndex: Int = this.size,
+        stride: Int = 8,
+        swapBytes: Boolean = false
+) {
+    nativeMemUtils.putDoubleArray(this, startIndex, destination.pointed, endIndex - startIndex, stride, swapBytes)
+}
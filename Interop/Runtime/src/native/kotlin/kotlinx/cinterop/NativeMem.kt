@@ -56,65 +56,66 @@ internal object nativeMemUtils {
     @TypedIntrinsic(IntrinsicType.INTEROP_READ_PRIMITIVE) external fun getVector(mem: NativePointed): Vector128
     @TypedIntrinsic(IntrinsicType.INTEROP_WRITE_PRIMITIVE) external fun putVector(mem: NativePointed, value: Vector128)
 
-    // TODO: optimize
     fun getByteArray(source: NativePointed, dest: ByteArray, length: Int) {
-        val sourceArray = source.reinterpret<ByteVar>().ptr
-        var index = 0
-        while (index < length) {
-            dest[index] = sourceArray[index]
-            ++index
-        }
+        copyFromNativeMemory(dest, 0, source.rawPtr, length, 1, false)
     }
 
-    // TODO: optimize
     fun putByteArray(source: ByteArray, dest: NativePointed, length: Int) {
-        val destArray = dest.reinterpret<ByteVar>().ptr
-        var index = 0
-        while (index < length) {
-            destArray[index] = source[index]
-            ++index
-        }
+        copyToNativeMemory(source, 0, dest.rawPtr, length, 1, false)
     }
 
-    // TODO: optimize
     fun getCharArray(source: NativePointed, dest: CharArray, length: Int) {
-        val sourceArray = source.reinterpret<ShortVar>().ptr
-        var index = 0
-        while (index < length) {
-            dest[index] = sourceArray[index].toChar()
-            ++index
-        }
+        copyFromNativeMemory(dest, 0, source.rawPtr, length, 2, false)
     }
 
-    // TODO: optimize
     fun putCharArray(source: CharArray, dest: NativePointed, length: Int) {
-        val destArray = dest.reinterpret<ShortVar>().ptr
-        var index = 0
-        while (index < length) {
-            destArray[index] = source[index].toShort()
-            ++index
-        }
+        copyToNativeMemory(source, 0, dest.rawPtr, length, 2, false)
     }
 
-    // TODO: optimize
+    // Bulk transfers with `stride` being the distance in bytes between consecutive elements in native memory.
+
+    fun getByteArray(source: NativePointed, dest: ByteArray, destIndex: Int, length: Int, stride: Int) =
+            copyFromNativeMemory(dest, destIndex, source.rawPtr, length, stride, false)
+
+    fun putByteArray(source: ByteArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int) =
+            copyToNativeMemory(source, sourceIndex, dest.rawPtr, length, stride, false)
+
+    fun getShortArray(source: NativePointed, dest: ShortArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) =
+            copyFromNativeMemory(dest, destIndex, source.rawPtr, length, stride, swapBytes)
+
+    fun putShortArray(source: ShortArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) =
+            copyToNativeMemory(source, sourceIndex, dest.rawPtr, length, stride, swapBytes)
+
+    fun getIntArray(source: NativePointed, dest: IntArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) =
+            copyFromNativeMemory(dest, destIndex, source.rawPtr, length, stride, swapBytes)
+
+    fun putIntArray(source: IntArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) =
+            copyToNativeMemory(source, sourceIndex, dest.rawPtr, length, stride, swapBytes)
+
+    fun getLongArray(source: NativePointed, dest: LongArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) =
+            copyFromNativeMemory(dest, destIndex, source.rawPtr, length, stride, swapBytes)
+
+    fun putLongArray(source: LongArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) =
+            copyToNativeMemory(source, sourceIndex, dest.rawPtr, length, stride, swapBytes)
+
+    fun getFloatArray(source: NativePointed, dest: FloatArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) =
+            copyFromNativeMemory(dest, destIndex, source.rawPtr, length, stride, swapBytes)
+
+    fun putFloatArray(source: FloatArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) =
+            copyToNativeMemory(source, sourceIndex, dest.rawPtr, length, stride, swapBytes)
+
+    fun getDoubleArray(source: NativePointed, dest: DoubleArray, destIndex: Int, length: Int, stride: Int, swapBytes: Boolean) =
+            copyFromNativeMemory(dest, destIndex, source.rawPtr, length, stride, swapBytes)
+
+    fun putDoubleArray(source: DoubleArray, sourceIndex: Int, dest: NativePointed, length: Int, stride: Int, swapBytes: Boolean) =
+            copyToNativeMemory(source, sourceIndex, dest.rawPtr, length, stride, swapBytes)
+
     fun zeroMemory(dest: NativePointed, length: Int): Unit {
-        val destArray = dest.reinterpret<ByteVar>().ptr
-        var index = 0
-        while (index < length) {
-            destArray[index] = 0
-            ++index
-        }
+        memset(dest.rawPtr, 0, length.toLong())
     }
 
-    // TODO: optimize
     fun copyMemory(dest: NativePointed, length: Int, src: NativePointed): Unit {
-        val destArray = dest.reinterpret<ByteVar>().ptr
-        val srcArray = src.reinterpret<ByteVar>().ptr
-        var index = 0
-        while (index < length) {
-            destArray[index] = srcArray[index]
-            ++index
-        }
+        memcpy(dest.rawPtr, src.rawPtr, length.toLong())
     }
 
     fun alloc(size: Long, align: Int): NativePointed {
@@ -130,21 +131,7 @@ internal object nativeMemUtils {
     }
 }
 
-public fun CPointer<UShortVar>.toKStringFromUtf16(): String {
-    val nativeBytes = this
-
-    var length = 0
-    while (nativeBytes[length] != 0.toUShort()) {
-        ++length
-    }
-    val chars = kotlin.CharArray(length)
-    var index = 0
-    while (index < length) {
-        chars[index] = nativeBytes[index].toShort().toChar()
-        ++index
-    }
-    return String(chars)
-}
+public fun CPointer<UShortVar>.toKStringFromUtf16(): String = decodeUtf16CString(this)
 
 public fun CPointer<ShortVar>.toKString(): String = this.toKStringFromUtf16()
 
@@ -156,6 +143,68 @@ private external fun malloc(size: Long, align: Int): NativePtr
 @SymbolName("Kotlin_interop_free")
 private external fun cfree(ptr: NativePtr)
 
+@SymbolName("Kotlin_interop_memset")
+private external fun memset(ptr: NativePtr, value: Int, size: Long)
+
+@SymbolName("Kotlin_interop_memcpy")
+private external fun memcpy(dest: NativePtr, src: NativePtr, size: Long)
+
+@SymbolName("Kotlin_Arrays_copyFromNativeMemory8")
+private external fun copyFromNativeMemory(dest: ByteArray, destIndex: Int, source: NativePtr,
+                                          count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyToNativeMemory8")
+private external fun copyToNativeMemory(source: ByteArray, sourceIndex: Int, dest: NativePtr,
+                                        count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyFromNativeMemory16")
+private external fun copyFromNativeMemory(dest: CharArray, destIndex: Int, source: NativePtr,
+                                          count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyToNativeMemory16")
+private external fun copyToNativeMemory(source: CharArray, sourceIndex: Int, dest: NativePtr,
+                                        count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyFromNativeMemory16")
+private external fun copyFromNativeMemory(dest: ShortArray, destIndex: Int, source: NativePtr,
+                                          count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyToNativeMemory16")
+private external fun copyToNativeMemory(source: ShortArray, sourceIndex: Int, dest: NativePtr,
+                                        count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyFromNativeMemory32")
+private external fun copyFromNativeMemory(dest: IntArray, destIndex: Int, source: NativePtr,
+                                          count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyToNativeMemory32")
+private external fun copyToNativeMemory(source: IntArray, sourceIndex: Int, dest: NativePtr,
+                                        count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyFromNativeMemory64")
+private external fun copyFromNativeMemory(dest: LongArray, destIndex: Int, source: NativePtr,
+                                          count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyToNativeMemory64")
+private external fun copyToNativeMemory(source: LongArray, sourceIndex: Int, dest: NativePtr,
+                                        count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyFromNativeMemory32")
+private external fun copyFromNativeMemory(dest: FloatArray, destIndex: Int, source: NativePtr,
+                                          count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyToNativeMemory32")
+private external fun copyToNativeMemory(source: FloatArray, sourceIndex: Int, dest: NativePtr,
+                                        count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyFromNativeMemory64")
+private external fun copyFromNativeMemory(dest: DoubleArray, destIndex: Int, source: NativePtr,
+                                          count: Int, stride: Int, swapBytes: Boolean)
+
+@SymbolName("Kotlin_Arrays_copyToNativeMemory64")
+private external fun copyToNativeMemory(source: DoubleArray, sourceIndex: Int, dest: NativePtr,
+                                        count: Int, stride: Int, swapBytes: Boolean)
+
 @TypedIntrinsic(IntrinsicType.INTEROP_READ_BITS)
 external fun readBits(ptr: NativePtr, offset: Long, size: Int, signed: Boolean): Long
 @TypedIntrinsic(IntrinsicType.INTEROP_WRITE_BITS)
@@ -23,6 +23,17 @@ internal external fun createStablePointer(any: Any): COpaquePointer
 @SymbolName("Kotlin_Interop_disposeStablePointer")
 internal external fun disposeStablePointer(pointer: COpaquePointer)
 
+@SymbolName("Kotlin_Interop_createStablePointers")
+internal external fun createStablePointers(
+        objects: Array<out Any>,
+        startIndex: Int,
+        endIndex: Int,
+        destination: CPointer<COpaquePointerVar>
+)
+
+@SymbolName("Kotlin_Interop_disposeStablePointers")
+internal external fun disposeStablePointers(pointers: CPointer<COpaquePointerVar>, count: Int)
+
 @PublishedApi
 @SymbolName("Kotlin_Interop_derefStablePointer")
 internal external fun derefStablePointer(pointer: COpaquePointer): Any
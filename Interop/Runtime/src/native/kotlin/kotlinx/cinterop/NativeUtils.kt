@@ -16,6 +16,7 @@
 
 package kotlinx.cinterop
 
+import kotlin.native.concurrent.ThreadLocal
 import kotlin.native.internal.Intrinsic
 import kotlin.native.internal.TypedIntrinsic
 import kotlin.native.internal.IntrinsicType
@@ -23,6 +24,63 @@ import kotlin.native.internal.IntrinsicType
 internal fun decodeFromUtf8(bytes: ByteArray): String = bytes.decodeToString()
 internal fun encodeToUtf8(str: String): ByteArray = str.encodeToByteArray()
 
+internal fun createUtf8CString(string: String): CValues<ByteVar> = Utf8CString(string)
+
+internal fun decodeUtf8CString(pointer: CPointer<ByteVar>): String = toKStringFromUtf8Impl(pointer.rawValue)
+
+internal fun decodeUtf16CString(pointer: CPointer<*>): String = toKStringFromUtf16Impl(pointer.rawValue)
+
+/**
+ * Zero-terminated UTF-8 C string encoded directly into the destination memory,
+ * without creating an intermediate [ByteArray].
+ */
+private class Utf8CString(private val string: String) : CValues<ByteVar>() {
+    override val size get() = utf8Size(string) + 1
+    override val align get() = 1
+
+    // Optimization to avoid unneeded virtual calls in base class implementation.
+    override fun getPointer(scope: AutofreeScope): CPointer<ByteVar> {
+        val utf8Size = utf8Size(string)
+        val result = interpretCPointer<ByteVar>(scope.alloc(utf8Size + 1, 1).rawPtr)!!
+        encodeToUtf8Memory(string, result.rawValue, utf8Size)
+        return result
+    }
+
+    override fun place(placement: CPointer<ByteVar>): CPointer<ByteVar> {
+        encodeToUtf8Memory(string, placement.rawValue, utf8Size(string))
+        return placement
+    }
+}
+
+/**
+ * Calls [block] with zero-terminated UTF-8 encoding of this string and its size in bytes
+ * excluding the terminating zero, e.g. to pass the string to C functions taking `(const char*, size_t)`.
+ *
+ * The string is encoded directly into the memory of temporary [memScoped] arena,
+ * so short strings don't cause any heap allocations.
+ * The pointer must not be used after [block] returns.
+ */
+public inline fun <R> String.useUtf8(block: (bytes: CPointer<ByteVar>, size: Int) -> R): R = memScoped {
+    val size = utf8Size(this@useUtf8)
+    val bytes = allocArray<ByteVar>(size + 1)
+    encodeToUtf8Memory(this@useUtf8, bytes.rawValue, size)
+    block(bytes, size)
+}
+
+@PublishedApi
+@SymbolName("Kotlin_String_getUtf8Size")
+internal external fun utf8Size(string: String): Int
+
+@PublishedApi
+@SymbolName("Kotlin_String_encodeToUtf8Memory")
+internal external fun encodeToUtf8Memory(string: String, destination: NativePtr, size: Int)
+
+@SymbolName("Kotlin_CPointer_toKStringFromUtf8")
+private external fun toKStringFromUtf8Impl(pointer: NativePtr): String
+
+@SymbolName("Kotlin_CPointer_toKStringFromUtf16")
+private external fun toKStringFromUtf16Impl(pointer: NativePtr): String
+
 @TypedIntrinsic(IntrinsicType.INTEROP_BITS_TO_FLOAT)
 external fun bitsToFloat(bits: Int): Float
 
@@ -46,6 +104,14 @@ external fun <R : Number> Number.narrow(): R
 @TypedIntrinsic(IntrinsicType.INTEROP_CONVERT) external fun <R : Any> UInt.convert(): R
 @TypedIntrinsic(IntrinsicType.INTEROP_CONVERT) external fun <R : Any> ULong.convert(): R
 
+@ThreadLocal
+private object ArenaChunkPoolHolder {
+    val pool = ArenaChunkPool()
+}
+
+internal val arenaChunkPool: ArenaChunkPool
+    get() = ArenaChunkPoolHolder.pool
+
 @Target(AnnotationTarget.FUNCTION, AnnotationTarget.PROPERTY_GETTER, AnnotationTarget.PROPERTY_SETTER, AnnotationTarget.FILE)
 @Retention(AnnotationRetention.SOURCE)
 internal annotation class JvmName(val name: String)
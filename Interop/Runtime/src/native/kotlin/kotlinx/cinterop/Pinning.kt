@@ -33,6 +33,18 @@ data class Pinned<out T : Any> internal constructor(private val stablePtr: COpaq
 
 }
 
+/**
+ * Handle of an object pinned by [useScopedPinned]. Unlike [Pinned], it owns nothing and is not allocated.
+ */
+@Suppress("NON_PUBLIC_PRIMARY_CONSTRUCTOR_OF_INLINE_CLASS")
+inline class ScopedPinned<out T : Any> @PublishedApi internal constructor(private val obj: Any) {
+
+    /**
+     * Returns the underlying pinned object.
+     */
+    fun get(): T = @Suppress("UNCHECKED_CAST") (obj as T)
+}
+
 fun <T : Any> T.pin() = Pinned<T>(createStablePointer(this))
 
 inline fun <T : Any, R> T.usePinned(block: (Pinned<T>) -> R): R {
@@ -44,6 +56,16 @@ inline fun <T : Any, R> T.usePinned(block: (Pinned<T>) -> R): R {
     }
 }
 
+/**
+ * Same as [usePinned], but doesn't create a stable pointer to the object, so it doesn't
+ * involve any reference counter updates.
+ *
+ * This is safe because the memory manager never moves objects and the receiver is referenced
+ * from the caller's stack frame until [block] completes.
+ * Addresses obtained from the handle must not be used after [block] returns.
+ */
+inline fun <T : Any, R> T.useScopedPinned(block: (ScopedPinned<T>) -> R): R = block(ScopedPinned<T>(this))
+
 fun Pinned<ByteArray>.addressOf(index: Int): CPointer<ByteVar> = this.get().addressOfElement(index)
 fun ByteArray.refTo(index: Int): CValuesRef<ByteVar> = this.usingPinned { addressOf(index) }
 
@@ -75,6 +97,26 @@ fun FloatArray.refTo(index: Int): CValuesRef<FloatVar> = this.usingPinned { addr
 fun Pinned<DoubleArray>.addressOf(index: Int): CPointer<DoubleVar> = this.get().addressOfElement(index)
 fun DoubleArray.refTo(index: Int): CValuesRef<DoubleVar> = this.usingPinned { addressOf(index) }
 
+/**
+ * Returns the address of UTF-16 code unit at [index] of the pinned string, so that the string can be passed
+ * to C functions taking `const uint16_t*` without copying.
+ * The memory is not zero-terminated and must not be modified.
+ * [index] may be equal to the string length, e.g. to get a valid pointer for an empty string.
+ */
+fun Pinned<String>.addressOf(index: Int): CPointer<UShortVar> = this.get().addressOfElement(index)
+
+fun ScopedPinned<ByteArray>.addressOf(index: Int): CPointer<ByteVar> = this.get().addressOfElement(index)
+fun ScopedPinned<ShortArray>.addressOf(index: Int): CPointer<ShortVar> = this.get().addressOfElement(index)
+fun ScopedPinned<IntArray>.addressOf(index: Int): CPointer<IntVar> = this.get().addressOfElement(index)
+fun ScopedPinned<LongArray>.addressOf(index: Int): CPointer<LongVar> = this.get().addressOfElement(index)
+fun ScopedPinned<UByteArray>.addressOf(index: Int): CPointer<UByteVar> = this.get().addressOfElement(index)
+fun ScopedPinned<UShortArray>.addressOf(index: Int): CPointer<UShortVar> = this.get().addressOfElement(index)
+fun ScopedPinned<UIntArray>.addressOf(index: Int): CPointer<UIntVar> = this.get().addressOfElement(index)
+fun ScopedPinned<ULongArray>.addressOf(index: Int): CPointer<ULongVar> = this.get().addressOfElement(index)
+fun ScopedPinned<FloatArray>.addressOf(index: Int): CPointer<FloatVar> = this.get().addressOfElement(index)
+fun ScopedPinned<DoubleArray>.addressOf(index: Int): CPointer<DoubleVar> = this.get().addressOfElement(index)
+fun ScopedPinned<String>.addressOf(index: Int): CPointer<UShortVar> = this.get().addressOfElement(index)
+
 private inline fun <T : Any, P : CPointed> T.usingPinned(
         crossinline block: Pinned<T>.() -> CPointer<P>
 ) = object : CValuesRef<P>() {
@@ -115,3 +157,6 @@ private external fun FloatArray.addressOfElement(index: Int): CPointer<FloatVar>
 
 @SymbolName("Kotlin_Arrays_getDoubleArrayAddressOfElement")
 private external fun DoubleArray.addressOfElement(index: Int): CPointer<DoubleVar>
+
+@SymbolName("Kotlin_String_getAddressOfElement")
+private external fun String.addressOfElement(index: Int): CPointer<UShortVar>
@@ -26,6 +26,7 @@ const val NODEFAULTLIBS = "no-default-libs"
 const val NOENDORSEDLIBS = "no-endorsed-libs"
 const val PURGE_USER_LIBS = "Xpurge-user-libs"
 const val TEMP_DIR = "Xtemporary-files-dir"
+const val INTEROP_CACHE_DIR = "Xinterop-cache-dir"
 
 // TODO: unify camel and snake cases.
 // Possible solution is to accept both cases
@@ -96,6 +97,8 @@ class CInteropArguments(argParser: ArgParser =
     val linkerOption = argParser.option(ArgType.String, "linker-option",
             description = "additional linker option").multiple()
     val linker by argParser.option(ArgType.String, description = "use specified linker")
+    val interopCacheDir by argParser.option(ArgType.String, INTEROP_CACHE_DIR,
+            description = "reuse the bindings and precompiled headers generated for unchanged headers, keeping them in the given directory")
 }
 
 class JSInteropArguments(argParser: ArgParser = ArgParser("jsinterop",
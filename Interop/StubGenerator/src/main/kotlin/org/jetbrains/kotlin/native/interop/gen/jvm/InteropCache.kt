@@ -0,0 +1,112 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.kotlin.native.interop.gen.jvm
+
+import java.io.File
+import java.nio.file.AtomicMoveNotSupportedException
+import java.nio.file.FileAlreadyExistsException
+import java.nio.file.Files
+import java.nio.file.StandardCopyOption
+import java.security.MessageDigest
+
+/**
+ * Persistent on-disk cache of the files generated by cinterop.
+ *
+ * An entry is addressed by a key built from everything that affects the bindings except for the header contents
+ * (see [InteropCacheKeyBuilder]). Each entry also records SHA-1 of every file the headers translation unit
+ * has been built from, and it is reused only if none of these files has changed since.
+ *
+ * Entries are published with an atomic directory rename, so the cache can be shared by cinterop processes
+ * running in parallel.
+ */
+internal class InteropCache(private val root: File) {
+
+    /**
+     * Returns the directory with the files stored for [key], or `null` if there is no up-to-date entry.
+     */
+    fun lookup(key: String): File? {
+        val entry = File(root, key)
+        val dependencies = File(entry, DEPENDENCIES_FILE_NAME)
+        if (!dependencies.isFile) return null
+
+        val upToDate = dependencies.readLines().filter { it.isNotEmpty() }.all { line ->
+            val hash = line.substringBefore(' ')
+            val path = line.substringAfter(' ')
+            File(path).let { it.isFile && sha1(it) == hash }
+        }
+        return entry.takeIf { upToDate }
+    }
+
+    /**
+     * Stores [files] (mapped from their names within the entry) for [key].
+     * [dependencies] are the files the entry should be invalidated by.
+     */
+    fun store(key: String, dependencies: Collection<String>, files: Map<String, File>) {
+        root.mkdirs()
+        val temporaryEntry = Files.createTempDirectory(root.toPath(), "$key-").toFile()
+        try {
+            files.forEach { (name, file) ->
+                file.copyTo(File(temporaryEntry, name), overwrite = true)
+            }
+            File(temporaryEntry, DEPENDENCIES_FILE_NAME).printWriter().use { writer ->
+                dependencies.sorted().forEach { path ->
+                    writer.println("${sha1(File(path))} $path")
+                }
+            }
+
+            val entry = File(root, key)
+            if (entry.exists()) entry.deleteRecursively()
+            try {
+                Files.move(temporaryEntry.toPath(), entry.toPath(), StandardCopyOption.ATOMIC_MOVE)
+            } catch (e: FileAlreadyExistsException) {
+                // Another process has just stored the same entry.
+            } catch (e: AtomicMoveNotSupportedException) {
+                // The cache is just an optimization, so don't fail the build.
+            }
+        } finally {
+            temporaryEntry.deleteRecursively()
+        }
+    }
+
+    companion object {
+        const val DEPENDENCIES_FILE_NAME = "dependencies.txt"
+    }
+}
+
+/**
+ * Accumulates the inputs of cinterop into the [InteropCache] key.
+ */
+internal class InteropCacheKeyBuilder {
+    private val digest = MessageDigest.getInstance("SHA-1")
+
+    fun add(value: String) = apply {
+        digest.update(value.toByteArray())
+        // Separate values so that e.g. ["ab", "c"] and ["a", "bc"] give different keys.
+        digest.update(0)
+    }
+
+    fun add(values: Collection<String>) = apply {
+        add(values.size.toString())
+        values.forEach { add(it) }
+    }
+
+    fun build(): String = digest.digest().toHexString()
+}
+
+private fun sha1(file: File): String {
+    val digest = MessageDigest.getInstance("SHA-1")
+    file.inputStream().use { input ->
+        val buffer = ByteArray(DEFAULT_BUFFER_SIZE)
+        while (true) {
+            val read = input.read(buffer)
+            if (read < 0) break
+            digest.update(buffer, 0, read)
+        }
+    }
+    return digest.digest().toHexString()
+}
+
+private fun ByteArray.toHexString() = joinToString("") { (it.toInt() and 0xff).toString(16).padStart(2, '0') }
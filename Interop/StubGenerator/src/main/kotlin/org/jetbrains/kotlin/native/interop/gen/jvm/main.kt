@@ -16,6 +16,7 @@
 
 package org.jetbrains.kotlin.native.interop.gen.jvm
 
+import org.jetbrains.kotlin.konan.CompilerVersion
 import org.jetbrains.kotlin.konan.TempFiles
 import org.jetbrains.kotlin.konan.exec.Command
 import org.jetbrains.kotlin.konan.util.DefFile
@@ -39,6 +40,8 @@ fun main(args: Array<String>) {
     processCLib(args)
 }
 
+private const val INTEROP_CACHE_MANIFEST = "manifest.properties"
+
 fun interop(
         flavor: String, args: Array<String>,
         additionalArgs: Map<String, Any> = mapOf()
@@ -227,7 +230,46 @@ private fun processCLib(args: Array<String>, additionalArgs: Map<String, Any> =
 
     val library = buildNativeLibrary(tool, def, cinteropArguments, imports)
 
-    val (nativeIndex, compilation) = buildNativeIndex(library, verbose)
+    val outKtFile = run {
+        val outKtFileName = fqParts.last() + ".kt"
+        val outKtFileRelative = (fqParts + outKtFileName).joinToString("/")
+        File(ktGenRoot, outKtFileRelative)
+    }
+    val outBitcodeFile = File(nativeLibsDir, "$libName.bc")
+
+    // Only the source code mode for native is cached: its results are plain files.
+    val interopCache = cinteropArguments.interopCacheDir
+            ?.takeIf { flavor == KotlinPlatform.NATIVE && mode == GenerationMode.SOURCE_CODE }
+            ?.let { InteropCache(File(it)) }
+    val interopCacheKey = interopCache?.let {
+        InteropCacheKeyBuilder()
+                .add(CompilerVersion.CURRENT.toString())
+                .add(tool.target.name)
+                .add(defFile?.readText() ?: "")
+                .add(outKtPkg)
+                .add(libName)
+                .add(library.language.name)
+                .add(library.includes)
+                .add(library.additionalPreambleLines)
+                .add(library.compilerArgs)
+                .add(allLibraryDependencies.map { dependency ->
+                    val includedHeaders = (dependency as? KonanLibrary)?.includedHeaders ?: emptyList()
+                    "${dependency.libraryName}: ${includedHeaders.joinToString(" ")}"
+                })
+                .build()
+    }
+    if (interopCache != null && interopCacheKey != null) {
+        interopCache.lookup(interopCacheKey)?.let { entry ->
+            if (verbose) println("Reusing cached interop stubs from $entry")
+            File(entry, outKtFile.name).copyTo(outKtFile, overwrite = true)
+            File(entry, outBitcodeFile.name).copyTo(outBitcodeFile, overwrite = true)
+            manifestAddend?.let { File(entry, INTEROP_CACHE_MANIFEST).copyTo(it, overwrite = true) }
+            return argsToCompiler(staticLibraries, libraryPaths)
+        }
+    }
+
+    val precompiledHeadersCacheDir = cinteropArguments.interopCacheDir?.let { File(it, "precompiledHeaders") }
+    val (nativeIndex, compilation, includedFiles) = buildNativeIndex(library, verbose, precompiledHeadersCacheDir)
 
     val moduleName = File(cinteropArguments.output).nameWithoutExtension
 
@@ -264,11 +306,8 @@ private fun processCLib(args: Array<String>, additionalArgs: Map<String, Any> =
     val stubIrContext = StubIrContext(logger, configuration, nativeIndex, imports, flavor, libName)
     val stubIrOutput = run {
         val outKtFileCreator = {
-            val outKtFileName = fqParts.last() + ".kt"
-            val outKtFileRelative = (fqParts + outKtFileName).joinToString("/")
-            val file = File(ktGenRoot, outKtFileRelative)
-            file.parentFile.mkdirs()
-            file
+            outKtFile.parentFile.mkdirs()
+            outKtFile
         }
         val driverOptions = StubIrDriver.DriverOptions(mode, entryPoint, moduleName, File(outCFile.absolutePath), outKtFileCreator)
         val stubIrDriver = StubIrDriver(stubIrContext, driverOptions)
@@ -307,7 +346,7 @@ private fun processCLib(args: Array<String>, additionalArgs: Map<String, Any> =
             outOFile.absolutePath
         }
         KotlinPlatform.NATIVE -> {
-            val outLib = File(nativeLibsDir, "$libName.bc")
+            val outLib = outBitcodeFile
             val compilerCmd = arrayOf(compiler, *compilerArgs,
                     "-emit-llvm", "-c", outCFile.absolutePath, "-o", outLib.absolutePath)
 
@@ -316,6 +355,17 @@ private fun processCLib(args: Array<String>, additionalArgs: Map<String, Any> =
         }
     }
 
+    if (interopCache != null && interopCacheKey != null) {
+        val manifestFile = File(tempFiles.create(libName, ".properties").absolutePath)
+        def.manifestAddendProperties.storeProperties(manifestFile)
+        val dependencies = includedFiles + listOfNotNull(defFile?.absolutePath)
+        interopCache.store(interopCacheKey, dependencies, mapOf(
+                outKtFile.name to outKtFile,
+                outBitcodeFile.name to outBitcodeFile,
+                INTEROP_CACHE_MANIFEST to manifestFile
+        ))
+    }
+
     return when (stubIrOutput) {
         is StubIrDriver.Result.SourceCode -> {
             argsToCompiler(staticLibraries, libraryPaths)
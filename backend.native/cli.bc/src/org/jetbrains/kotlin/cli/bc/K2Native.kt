@@ -156,6 +156,7 @@ class K2Native : CLICompiler<K2NativeCompilerArguments>() {
                 put(STATIC_FRAMEWORK, selectFrameworkType(configuration, arguments, outputKind))
                 put(OVERRIDE_CLANG_OPTIONS, arguments.clangOptions.toNonNullList())
                 put(ALLOCATION_MODE, arguments.allocator)
+                put(BOX_CACHE_RANGES, parseBoxCacheRanges(arguments, configuration))
 
                 put(PRINT_IR, arguments.printIr)
                 put(PRINT_IR_WITH_DESCRIPTORS, arguments.printIrWithDescriptors)
@@ -185,6 +186,10 @@ class K2Native : CLICompiler<K2NativeCompilerArguments>() {
                         configuration.report(STRONG_WARNING, "Relaxed memory model is not yet fully functional")
                         MemoryModel.RELAXED
                     }
+                    "tracing" -> {
+                        configuration.report(STRONG_WARNING, "Tracing memory model is experimental")
+                        MemoryModel.TRACING
+                    }
                     "strict" -> MemoryModel.STRICT
                     else -> {
                         configuration.report(ERROR, "Unsupported memory model ${arguments.memoryModel}")
@@ -340,6 +345,32 @@ private fun parseCachedLibraries(
     }
 }.toMap()
 
+private fun parseBoxCacheRanges(
+        arguments: K2NativeCompilerArguments,
+        configuration: CompilerConfiguration
+): Map<BoxCache, Pair<Int, Int>> = arguments.boxCacheRanges?.asList().orEmpty().mapNotNull {
+    val typeAndRange = it.split(":")
+    val cache = BoxCache.values().firstOrNull { cache -> cache.name.equals(typeAndRange[0], ignoreCase = true) }
+    val bounds = typeAndRange.getOrNull(1)?.split("..")?.map { bound -> bound.toIntOrNull() }
+    if (typeAndRange.size != 2 || cache == null || bounds?.size != 2 || bounds.any { bound -> bound == null }) {
+        configuration.report(
+                ERROR,
+                "incorrect $BOX_CACHE format: expected '<type>:<from>..<to>', got '$it'"
+        )
+        return@mapNotNull null
+    }
+    val (from, to) = bounds.map { bound -> bound!! }
+    if (from <= to && (from < cache.minValue || to > cache.maxValue || to.toLong() - from >= MAX_BOX_CACHE_SIZE)) {
+        configuration.report(
+                ERROR,
+                "$BOX_CACHE range for ${typeAndRange[0]} must be within ${cache.minValue}..${cache.maxValue} " +
+                        "and have at most $MAX_BOX_CACHE_SIZE values, got '$it'"
+        )
+        return@mapNotNull null
+    }
+    cache to (from to to)
+}.toMap()
+
 private fun parseLibrariesToCache(
         arguments: K2NativeCompilerArguments,
         configuration: CompilerConfiguration,
@@ -47,7 +47,7 @@ class K2NativeCompilerArguments : CommonCompilerArguments() {
     @Argument(value = "-manifest", valueDescription = "<path>", description = "Provide a maniferst addend file")
     var manifestFile: String? = null
 
-    @Argument(value="-memory-model", valueDescription = "<model>", description = "Memory model to use, 'strict' and 'relaxed' are currently supported")
+    @Argument(value="-memory-model", valueDescription = "<model>", description = "Memory model to use, 'strict', 'relaxed' and 'tracing' are currently supported")
     var memoryModel: String? = "strict"
 
     @Argument(value="-module-name", deprecatedName = "-module_name", valueDescription = "<name>", description = "Specify a name for the compilation module")
@@ -102,6 +102,16 @@ class K2NativeCompilerArguments : CommonCompilerArguments() {
     // Make sure to prepend them with -X.
     // Keep the list lexically sorted.
 
+    @Argument(
+            value = BOX_CACHE,
+            valueDescription = "<type>:<from>..<to>",
+            description = "Range of values boxed without allocation, where type is one of\n" +
+                    "boolean, byte, short, char, int, long, float and double.\n" +
+                    "Float and double caches only hold integral values, empty range (e.g. 1..0) disables the cache",
+            delimiter = ""
+    )
+    var boxCacheRanges: Array<String>? = null
+
     @Argument(
             value = "-Xcache-directory",
             valueDescription = "<path>",
@@ -257,6 +267,7 @@ class K2NativeCompilerArguments : CommonCompilerArguments() {
             }
 }
 
+const val BOX_CACHE = "-Xbox-cache"
 const val EMBED_BITCODE_FLAG = "-Xembed-bitcode"
 const val EMBED_BITCODE_MARKER_FLAG = "-Xembed-bitcode-marker"
 const val STATIC_FRAMEWORK_FLAG = "-Xstatic-framework"
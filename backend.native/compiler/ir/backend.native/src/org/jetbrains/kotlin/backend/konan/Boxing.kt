@@ -176,26 +176,28 @@ private fun initCache(cache: BoxCache, context: Context, cacheName: String,
     val staticData = context.llvm.staticData
     val llvmType = staticData.getLLVMType(kotlinType.defaultType)
 
-    val (start, end) = context.config.target.getBoxCacheRange(cache)
+    val (start, end) = context.config.getBoxCacheRange(cache)
     // Constancy of these globals allows LLVM's constant propagation and DCE
     // to remove fast path of boxing function in case of empty range.
-    staticData.placeGlobal(rangeStartName, createConstant(llvmType, start), true)
+    staticData.placeGlobal(rangeStartName, createConstant(cache, llvmType, start), true)
             .setConstant(true)
-    staticData.placeGlobal(rangeEndName, createConstant(llvmType, end), true)
+    staticData.placeGlobal(rangeEndName, createConstant(cache, llvmType, end), true)
             .setConstant(true)
-    val values = (start..end).map { staticData.createInitializer(kotlinType, createConstant(llvmType, it)) }
+    val values = (start..end).map { staticData.createInitializer(kotlinType, createConstant(cache, llvmType, it)) }
     val llvmBoxType = structType(context.llvm.runtime.objHeaderType, llvmType)
     staticData.placeGlobalConstArray(cacheName, llvmBoxType, values, true).llvm
 }
 
-private fun createConstant(llvmType: LLVMTypeRef, value: Int): ConstValue =
-        constValue(LLVMConstInt(llvmType, value.toLong(), 1)!!)
+private fun createConstant(cache: BoxCache, llvmType: LLVMTypeRef, value: Int): ConstValue = when (cache) {
+    BoxCache.FLOAT, BoxCache.DOUBLE -> constValue(LLVMConstReal(llvmType, value.toDouble())!!)
+    else -> constValue(LLVMConstInt(llvmType, value.toLong(), 1)!!)
+}
 
 // When start is greater than end then `inRange` check is always false
 // and can be eliminated by LLVM.
 private val emptyRange = 1 to 0
 
-// Memory usage is around 20kb.
+// Memory usage is around 30kb.
 private val BoxCache.defaultRange get() = when (this) {
     BoxCache.BOOLEAN -> (0 to 1)
     BoxCache.BYTE -> (-128 to 127)
@@ -203,6 +205,8 @@ private val BoxCache.defaultRange get() = when (this) {
     BoxCache.CHAR -> (0 to 255)
     BoxCache.INT -> (-128 to 127)
     BoxCache.LONG -> (-128 to 127)
+    BoxCache.FLOAT -> (-128 to 127)
+    BoxCache.DOUBLE -> (-128 to 127)
 }
 
 private fun KonanTarget.getBoxCacheRange(cache: BoxCache): Pair<Int, Int> = when (this) {
@@ -210,6 +214,10 @@ private fun KonanTarget.getBoxCacheRange(cache: BoxCache): Pair<Int, Int> = when
     else                    -> cache.defaultRange
 }
 
+// Ranges given with -Xbox-cache take precedence over the target defaults.
+private fun KonanConfig.getBoxCacheRange(cache: BoxCache): Pair<Int, Int> =
+        configuration.get(KonanConfigKeys.BOX_CACHE_RANGES)?.get(cache) ?: target.getBoxCacheRange(cache)
+
 internal fun IrBuiltIns.getKotlinClass(cache: BoxCache): IrClass = when (cache) {
     BoxCache.BOOLEAN -> booleanClass
     BoxCache.BYTE -> byteClass
@@ -217,9 +225,25 @@ internal fun IrBuiltIns.getKotlinClass(cache: BoxCache): IrClass = when (cache)
     BoxCache.CHAR -> charClass
     BoxCache.INT -> intClass
     BoxCache.LONG -> longClass
+    BoxCache.FLOAT -> floatClass
+    BoxCache.DOUBLE -> doubleClass
 }.owner
 
+// Limits the size of the data section taken by a cache to several megabytes.
+const val MAX_BOX_CACHE_SIZE = 1 shl 20
+
+/**
+ * Box caches, with the bounds of their ranges. Caches of floating point types only hold integral values,
+ * which are exactly representable within the bounds.
+ */
 // TODO: consider adding box caches for unsigned types.
-enum class BoxCache {
-    BOOLEAN, BYTE, SHORT, CHAR, INT, LONG
+enum class BoxCache(val minValue: Int, val maxValue: Int) {
+    BOOLEAN(0, 1),
+    BYTE(Byte.MIN_VALUE.toInt(), Byte.MAX_VALUE.toInt()),
+    SHORT(Short.MIN_VALUE.toInt(), Short.MAX_VALUE.toInt()),
+    CHAR(Char.MIN_VALUE.toInt(), Char.MAX_VALUE.toInt()),
+    INT(Int.MIN_VALUE, Int.MAX_VALUE),
+    LONG(Int.MIN_VALUE, Int.MAX_VALUE),
+    FLOAT(-(1 shl 24), 1 shl 24),
+    DOUBLE(Int.MIN_VALUE, Int.MAX_VALUE)
 }
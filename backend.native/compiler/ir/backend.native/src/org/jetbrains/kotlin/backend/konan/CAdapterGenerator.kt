@@ -361,6 +361,7 @@ private class ExportedElement(val kind: ElementKind,
             |
             |extern "C" KObjHeader* ${cname}_instance(KObjHeader**);
             |static $objectClassC ${cname}_instance_impl(void) {
+            |  KotlinCodeScope kotlin_scope;
             |  KObjHolder result_holder;
             |  Kotlin_initRuntimeIfNeeded();
             |  KObjHeader* result = ${cname}_instance(result_holder.slot());
@@ -379,6 +380,7 @@ private class ExportedElement(val kind: ElementKind,
         return """
               |extern "C" KObjHeader* $cname(KObjHeader**);
               |static $enumClassC ${cname}_impl(void) {
+              |  KotlinCodeScope kotlin_scope;
               |  KObjHolder result_holder;
               |  Kotlin_initRuntimeIfNeeded();
               |  KObjHeader* result = $cname(result_holder.slot());
@@ -424,6 +426,8 @@ private class ExportedElement(val kind: ElementKind,
         val builder = StringBuilder()
         builder.append("$visibility ${owner.translateType(cfunction[0])} ${cnameImpl}(${cfunction.drop(1).
                 mapIndexed { index, it -> "${owner.translateType(it)} arg${index}" }.joinToString(", ")}) {\n")
+        // Goes first, so that it is destroyed after all the holders.
+        builder.append("  KotlinCodeScope kotlin_scope;\n")
         val args = ArrayList(cfunction.drop(1).mapIndexed { index, pair ->
             translateArgument("arg$index", pair, Direction.C_TO_KOTLIN, builder)
         })
@@ -916,6 +920,8 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         |void LeaveFrame(KObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
         |void Kotlin_initRuntimeIfNeeded();
         |void TerminateWithUnhandledException(KObjHeader*) RUNTIME_NORETURN;
+        |int LeaveSafeRegionsOnEntry() RUNTIME_NOTHROW;
+        |void RestoreSafeRegionsOnExit(int) RUNTIME_NOTHROW;
         |
         |KObjHeader* CreateStringFromCString(const char*, KObjHeader**);
         |char* CreateCStringFromString(const KObjHeader*);
@@ -929,6 +935,17 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         |  ${prefix}_KInt count;
         |};
         |
+        |// Foreign code runs in a safe region of the memory model, which is left while Kotlin code runs.
+        |class KotlinCodeScope {
+        | public:
+        |  KotlinCodeScope() : safeRegions_(LeaveSafeRegionsOnEntry()) {}
+        |  ~KotlinCodeScope() {
+        |    RestoreSafeRegionsOnExit(safeRegions_);
+        |  }
+        | private:
+        |  int safeRegions_;
+        |};
+        |
         |class KObjHolder {
         |public:
         |  KObjHolder() : obj_(nullptr) {
@@ -964,12 +981,14 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         |};
         |
         |static void DisposeStablePointerImpl(${prefix}_KNativePtr ptr) {
+        |  KotlinCodeScope kotlin_scope;
         |  DisposeStablePointer(ptr);
         |}
         |static void DisposeStringImpl(const char* ptr) {
         |  DisposeCString((char*)ptr);
         |}
         |static ${prefix}_KBoolean IsInstanceImpl(${prefix}_KNativePtr ref, const ${prefix}_KType* type) {
+        |  KotlinCodeScope kotlin_scope;
         |  KObjHolder holder;
         |  return IsInstance(DerefStablePointer(ref, holder.slot()), (const KTypeInfo*)type);
         |}
@@ -983,6 +1002,7 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
             val argument = if (needArgument) "value, " else ""
             output("extern \"C\" KObjHeader* Kotlin_box${it.shortNameForPredefinedType}($parameter$maybeComma KObjHeader**);")
             output("static ${translateType(nullableIt)} ${it.createNullableNameForPredefinedType}Impl($parameter) {")
+            output("KotlinCodeScope kotlin_scope;", 1)
             output("KObjHolder result_holder;", 1)
             output("Kotlin_initRuntimeIfNeeded();", 1)
             output("KObjHeader* result = Kotlin_box${it.shortNameForPredefinedType}($argument result_holder.slot());", 1)
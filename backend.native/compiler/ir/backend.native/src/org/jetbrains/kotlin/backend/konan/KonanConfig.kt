@@ -109,7 +109,11 @@ class KonanConfig(val project: Project, val configuration: CompilerConfiguration
 
     internal val runtimeNativeLibraries: List<String> = mutableListOf<String>().apply {
         add(if (debug) "debug.bc" else "release.bc")
-        add(if (memoryModel == MemoryModel.STRICT) "strict.bc" else "relaxed.bc")
+        add(when (memoryModel) {
+            MemoryModel.STRICT -> "strict.bc"
+            MemoryModel.RELAXED -> "relaxed.bc"
+            MemoryModel.TRACING -> "tracing.bc"
+        })
         if (shouldCoverLibraries || shouldCoverSources) add("profileRuntime.bc")
         if (configuration.get(KonanConfigKeys.ALLOCATION_MODE) == "mimalloc") {
             if (!target.supportsMimallocAllocator()) {
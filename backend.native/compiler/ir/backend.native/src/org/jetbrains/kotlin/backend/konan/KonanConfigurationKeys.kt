@@ -12,6 +12,8 @@ import org.jetbrains.kotlin.konan.target.CompilerOutputKind
 class KonanConfigKeys {
     companion object {
         // Keep the list lexically sorted.
+        val BOX_CACHE_RANGES: CompilerConfigurationKey<Map<BoxCache, Pair<Int, Int>>>
+                = CompilerConfigurationKey.create("ranges of values in box caches")
         val CHECK_DEPENDENCIES: CompilerConfigurationKey<Boolean>
                 = CompilerConfigurationKey.create("check dependencies and download the missing ones")
         val COMPATIBLE_COMPILER_VERSIONS: CompilerConfigurationKey<List<String>>
@@ -7,6 +7,7 @@ import org.jetbrains.kotlin.backend.common.ir.simpleFunctions
 import org.jetbrains.kotlin.backend.common.lower.at
 import org.jetbrains.kotlin.backend.common.lower.irNot
 import org.jetbrains.kotlin.backend.konan.KonanFqNames
+import org.jetbrains.kotlin.backend.konan.MemoryModel
 import org.jetbrains.kotlin.backend.konan.PrimitiveBinaryType
 import org.jetbrains.kotlin.backend.konan.RuntimeNames
 import org.jetbrains.kotlin.backend.konan.ir.*
@@ -48,6 +49,7 @@ internal interface KotlinStubs {
     val irBuiltIns: IrBuiltIns
     val symbols: KonanSymbols
     val target: KonanTarget
+    val memoryModel: MemoryModel
     fun addKotlin(declaration: IrDeclaration)
     fun addC(lines: List<String>)
     fun getUniqueCName(prefix: String): String
@@ -165,7 +167,7 @@ internal fun KotlinStubs.generateCCall(expression: IrCall, builder: IrBuilderWit
         this.addC(listOf("extern const $targetFunctionVariable __asm(\"$cCallSymbolName\");")) // Exported from cinterop stubs.
     }
 
-    callBuilder.emitCBridge()
+    callBuilder.emitCBridge(inSafeRegion = callsForeignCodeInSafeRegion)
 
     return result
 }
@@ -269,16 +271,69 @@ private fun <R> KotlinToCCallBuilder.handleArgumentForVarargParameter(
     else -> stubs.throwCompilerError(argument, "unexpected vararg")
 }
 
-private fun KotlinToCCallBuilder.emitCBridge() {
+private fun KotlinToCCallBuilder.emitCBridge(inSafeRegion: Boolean = false) {
     val cLines = mutableListOf<String>()
 
-    cLines += "${bridgeBuilder.buildCSignature(cBridgeName)} {"
-    cLines += cBridgeBodyLines
-    cLines += "}"
+    if (inSafeRegion) {
+        val cBridgeImplName = "${cBridgeName}_impl"
+        cLines += "static ${bridgeBuilder.buildCSignature(cBridgeImplName)} {"
+        cLines += cBridgeBodyLines
+        cLines += "}"
+        cLines += wrapInSafeRegionSwitch(bridgeBuilder.cBridgeBuilder, cBridgeName, cBridgeImplName,
+                enter = "EnterSafeRegion();", leave = "LeaveSafeRegion();")
+    } else {
+        cLines += "${bridgeBuilder.buildCSignature(cBridgeName)} {"
+        cLines += cBridgeBodyLines
+        cLines += "}"
+    }
 
     stubs.addC(cLines)
 }
 
+/**
+ * Threads running foreign code are in safe regions, so that they don't hold off stop-the-world collections
+ * of the relaxed and tracing memory models for as long as they stay there.
+ * On Apple targets foreign code can get back to Kotlin through Objective-C methods and blocks, which
+ * don't leave the safe region, so foreign calls are made without it there.
+ */
+private val KotlinStubs.callsForeignCodeInSafeRegion: Boolean
+    get() = memoryModel != MemoryModel.STRICT && !target.family.isAppleFamily
+
+private val safeRegionDeclarations = listOf(
+        "void EnterSafeRegion(void);",
+        "void LeaveSafeRegion(void);",
+        "int LeaveSafeRegionsOnEntry(void);",
+        "void RestoreSafeRegionsOnExit(int);"
+)
+
+/**
+ * Defines [name] function of [signature] which calls [implName] of the same signature
+ * between [enter] and [leave] statements.
+ */
+private fun wrapInSafeRegionSwitch(
+        signature: CFunctionBuilder,
+        name: String,
+        implName: String,
+        enter: String,
+        leave: String
+): List<String> {
+    val cLines = mutableListOf<String>()
+    cLines += safeRegionDeclarations
+    cLines += "${signature.buildSignature(name)} {"
+    cLines += enter
+    val implCall = signature.buildCallWithSameArguments(implName)
+    if (signature.returnsVoid) {
+        cLines += "$implCall;"
+        cLines += leave
+    } else {
+        cLines += "${signature.declareResult("result")} = $implCall;"
+        cLines += leave
+        cLines += "return result;"
+    }
+    cLines += "}"
+    return cLines
+}
+
 private fun KotlinToCCallBuilder.buildCall(
         targetFunctionName: String,
         returnValuePassing: ValueReturning
@@ -478,9 +533,20 @@ private fun CCallbackBuilder.buildCFunction(): String {
 
     val cLines = mutableListOf<String>()
 
-    cLines += "${cFunctionBuilder.buildSignature(result)} {"
-    cLines += cBodyLines
-    cLines += "}"
+    if (!isObjCMethod && stubs.callsForeignCodeInSafeRegion) {
+        // Called from foreign code, so leaves its safe region for the time of the call.
+        val implName = "${result}_impl"
+        cLines += "static ${cFunctionBuilder.buildSignature(implName)} {"
+        cLines += cBodyLines
+        cLines += "}"
+        cLines += wrapInSafeRegionSwitch(cFunctionBuilder, result, implName,
+                enter = "int safeRegions = LeaveSafeRegionsOnEntry();",
+                leave = "RestoreSafeRegionsOnExit(safeRegions);")
+    } else {
+        cLines += "${cFunctionBuilder.buildSignature(result)} {"
+        cLines += cBodyLines
+        cLines += "}"
+    }
 
     stubs.addC(cLines)
 
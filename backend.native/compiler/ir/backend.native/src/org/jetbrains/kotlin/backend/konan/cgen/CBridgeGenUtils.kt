@@ -59,6 +59,12 @@ internal class CFunctionBuilder {
         append(')')
     })
 
+    val returnsVoid: Boolean get() = returnType == CTypes.void
+
+    fun declareResult(name: String): String = returnType.render(name)
+
+    fun buildCallWithSameArguments(name: String): String = parameters.joinToString(prefix = "$name(", postfix = ")") { it.name }
+
 }
 
 internal class KotlinBridgeBuilder(
@@ -141,7 +147,7 @@ internal class KotlinCBridgeBuilder(
         isKotlinToC: Boolean
 ) {
     private val kotlinBridgeBuilder = KotlinBridgeBuilder(startOffset, endOffset, cName, stubs, isExternal = isKotlinToC)
-    private val cBridgeBuilder = CFunctionBuilder()
+    val cBridgeBuilder = CFunctionBuilder()
 
     val kotlinIrBuilder: IrBuilderWithScope get() = kotlinBridgeBuilder.irBuilder
 
@@ -322,7 +322,7 @@ internal class FunctionGenerationContext(val function: LLVMValueRef,
     }
 
     private fun updateReturnRef(value: LLVMValueRef, address: LLVMValueRef) {
-        if (context.memoryModel == MemoryModel.STRICT)
+        if (context.memoryModel != MemoryModel.RELAXED)
             store(value, address)
         else
             call(context.llvm.updateReturnRefFunction, listOf(address, value))
@@ -330,12 +330,16 @@ internal class FunctionGenerationContext(val function: LLVMValueRef,
 
     private fun updateRef(value: LLVMValueRef, address: LLVMValueRef, onStack: Boolean) {
         if (onStack) {
-            if (context.memoryModel == MemoryModel.STRICT)
+            if (context.memoryModel != MemoryModel.RELAXED)
                 store(value, address)
             else
                 call(context.llvm.updateStackRefFunction, listOf(address, value))
         } else {
-            call(context.llvm.updateHeapRefFunction, listOf(address, value))
+            // Tracing memory model doesn't count references from the heap.
+            if (context.memoryModel == MemoryModel.TRACING)
+                store(value, address)
+            else
+                call(context.llvm.updateHeapRefFunction, listOf(address, value))
         }
     }
 
@@ -622,6 +626,10 @@ internal class FunctionGenerationContext(val function: LLVMValueRef,
         return LLVMBuildExtractElement(builder, vector, index, name)!!
     }
 
+    fun insertElement(vector: LLVMValueRef, element: LLVMValueRef, index: LLVMValueRef, name: String = ""): LLVMValueRef {
+        return LLVMBuildInsertElement(builder, vector, element, index, name)!!
+    }
+
     fun filteringExceptionHandler(codeContext: CodeContext): ExceptionHandler {
         val lpBlock = basicBlockInFunction("filteringExceptionHandler", position()?.start)
 
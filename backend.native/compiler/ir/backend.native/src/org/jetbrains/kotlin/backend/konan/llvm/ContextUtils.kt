@@ -453,6 +453,7 @@ internal class Llvm(val context: Context, val llvmModule: LLVMModuleRef) {
     val addTLSRecord = importRtFunction("AddTLSRecord")
     val clearTLSRecord = importRtFunction("ClearTLSRecord")
     val lookupTLS = importRtFunction("LookupTLS")
+    val addGlobalRoot = importRtFunction("AddGlobalRoot")
     val initRuntimeIfNeeded = importRtFunction("Kotlin_initRuntimeIfNeeded")
     val mutationCheck = importRtFunction("MutationCheck")
     val freezeSubgraph = importRtFunction("FreezeSubgraph")
@@ -534,6 +535,12 @@ internal class Llvm(val context: Context, val llvmModule: LLVMModuleRef) {
             "cold", "noreturn", "nounwind"
     )
 
+    val llvmFmaVector4f = llvmIntrinsic(
+            "llvm.fma.v4f32",
+            functionType(vector128Type, false, vector128Type, vector128Type, vector128Type),
+            "nounwind", "readnone"
+    )
+
     val llvmEhTypeidFor = llvmIntrinsic(
             "llvm.eh.typeid.for",
             functionType(int32Type, false, int8TypePtr),
@@ -1,6 +1,7 @@
 package org.jetbrains.kotlin.backend.konan.llvm
 
 import kotlinx.cinterop.cValuesOf
+import kotlinx.cinterop.toCValues
 import llvm.*
 import org.jetbrains.kotlin.backend.konan.RuntimeNames
 import org.jetbrains.kotlin.backend.konan.descriptors.getAnnotationStringValue
@@ -50,6 +51,27 @@ internal enum class IntrinsicType {
     EXTRACT_ELEMENT,
     ARE_EQUAL_BY_VALUE,
     IEEE_754_EQUALS,
+    // Vector128
+    VECTOR_FLOAT_PLUS,
+    VECTOR_FLOAT_MINUS,
+    VECTOR_FLOAT_TIMES,
+    VECTOR_FLOAT_DIV,
+    VECTOR_FLOAT_FMA,
+    VECTOR_FLOAT_MIN,
+    VECTOR_FLOAT_MAX,
+    VECTOR_FLOAT_EQUALS,
+    VECTOR_FLOAT_LESS,
+    VECTOR_INT_PLUS,
+    VECTOR_INT_MINUS,
+    VECTOR_INT_TIMES,
+    VECTOR_INT_MIN,
+    VECTOR_INT_MAX,
+    VECTOR_INT_EQUALS,
+    VECTOR_INT_LESS,
+    VECTOR_AND,
+    VECTOR_OR,
+    VECTOR_XOR,
+    VECTOR_SHUFFLE,
     // OBJC
     OBJC_GET_MESSENGER,
     OBJC_GET_MESSENGER_STRET,
@@ -228,6 +250,26 @@ internal class IntrinsicGenerator(private val environment: IntrinsicGeneratorEnv
                 IntrinsicType.FLOAT_TRUNCATE -> emitFloatTruncate(callSite, args)
                 IntrinsicType.ARE_EQUAL_BY_VALUE -> emitAreEqualByValue(args)
                 IntrinsicType.IEEE_754_EQUALS -> emitIeee754Equals(args)
+                IntrinsicType.VECTOR_FLOAT_PLUS -> emitVectorFloatOp(args) { first, second -> fadd(first, second) }
+                IntrinsicType.VECTOR_FLOAT_MINUS -> emitVectorFloatOp(args) { first, second -> fsub(first, second) }
+                IntrinsicType.VECTOR_FLOAT_TIMES -> emitVectorFloatOp(args) { first, second -> LLVMBuildFMul(builder, first, second, "")!! }
+                IntrinsicType.VECTOR_FLOAT_DIV -> emitVectorFloatOp(args) { first, second -> LLVMBuildFDiv(builder, first, second, "")!! }
+                IntrinsicType.VECTOR_FLOAT_FMA -> call(context.llvm.llvmFmaVector4f, args)
+                IntrinsicType.VECTOR_FLOAT_MIN -> emitVectorFloatOp(args) { first, second -> select(fcmpLt(first, second), first, second) }
+                IntrinsicType.VECTOR_FLOAT_MAX -> emitVectorFloatOp(args) { first, second -> select(fcmpGt(first, second), first, second) }
+                IntrinsicType.VECTOR_FLOAT_EQUALS -> emitVectorFloatOp(args) { first, second -> emitVectorMask(fcmpEq(first, second)) }
+                IntrinsicType.VECTOR_FLOAT_LESS -> emitVectorFloatOp(args) { first, second -> emitVectorMask(fcmpLt(first, second)) }
+                IntrinsicType.VECTOR_INT_PLUS -> emitVectorIntOp(args) { first, second -> add(first, second) }
+                IntrinsicType.VECTOR_INT_MINUS -> emitVectorIntOp(args) { first, second -> sub(first, second) }
+                IntrinsicType.VECTOR_INT_TIMES -> emitVectorIntOp(args) { first, second -> LLVMBuildMul(builder, first, second, "")!! }
+                IntrinsicType.VECTOR_INT_MIN -> emitVectorIntOp(args) { first, second -> select(icmpLt(first, second), first, second) }
+                IntrinsicType.VECTOR_INT_MAX -> emitVectorIntOp(args) { first, second -> select(icmpGt(first, second), first, second) }
+                IntrinsicType.VECTOR_INT_EQUALS -> emitVectorIntOp(args) { first, second -> emitVectorMask(icmpEq(first, second)) }
+                IntrinsicType.VECTOR_INT_LESS -> emitVectorIntOp(args) { first, second -> emitVectorMask(icmpLt(first, second)) }
+                IntrinsicType.VECTOR_AND -> emitVectorIntOp(args) { first, second -> and(first, second) }
+                IntrinsicType.VECTOR_OR -> emitVectorIntOp(args) { first, second -> or(first, second) }
+                IntrinsicType.VECTOR_XOR -> emitVectorIntOp(args) { first, second -> xor(first, second) }
+                IntrinsicType.VECTOR_SHUFFLE -> emitVectorShuffle(args)
                 IntrinsicType.OBJC_GET_MESSENGER -> emitObjCGetMessenger(args, isStret = false)
                 IntrinsicType.OBJC_GET_MESSENGER_STRET -> emitObjCGetMessenger(args, isStret = true)
                 IntrinsicType.OBJC_GET_OBJC_CLASS -> emitGetObjCClass(callSite)
@@ -529,6 +571,50 @@ internal class IntrinsicGenerator(private val environment: IntrinsicGeneratorEnv
     private fun FunctionGenerationContext.emitNot(args: List<LLVMValueRef>) =
             not(args[0])
 
+    /*
+     * Vector128 is represented as <4 x float>, so integer lane operations work on its <4 x i32> reinterpretation.
+     */
+    private val vector4i32Type get() = LLVMVectorType(int32Type, 4)!!
+
+    private inline fun FunctionGenerationContext.emitVectorFloatOp(
+            args: List<LLVMValueRef>, op: (LLVMValueRef, LLVMValueRef) -> LLVMValueRef
+    ): LLVMValueRef {
+        val (first, second) = args
+        return bitcast(vector128Type, op(first, second))
+    }
+
+    private inline fun FunctionGenerationContext.emitVectorIntOp(
+            args: List<LLVMValueRef>, op: (LLVMValueRef, LLVMValueRef) -> LLVMValueRef
+    ): LLVMValueRef {
+        val (first, second) = args.map { bitcast(vector4i32Type, it) }
+        return bitcast(vector128Type, op(first, second))
+    }
+
+    // Lanes of the comparison result are all ones when the predicate holds and all zeros otherwise.
+    private fun FunctionGenerationContext.emitVectorMask(predicate: LLVMValueRef): LLVMValueRef =
+            sext(predicate, vector4i32Type)
+
+    private fun FunctionGenerationContext.emitVectorShuffle(args: List<LLVMValueRef>): LLVMValueRef {
+        val vector = args[0]
+        val indices = args.drop(1)
+        val elementCount = indices.size
+        val isConstantMask = indices.all {
+            LLVMIsAConstantInt(it) != null && LLVMConstIntGetSExtValue(it) in 0 until elementCount
+        }
+        if (isConstantMask) {
+            val mask = LLVMConstVector(indices.toCValues(), elementCount)
+            return LLVMBuildShuffleVector(builder, vector, LLVMGetUndef(vector.type), mask, "")!!
+        }
+        // Lane selectors known only at runtime: move the lanes one by one.
+        val lanes = bitcast(vector4i32Type, vector)
+        var result = LLVMGetUndef(vector4i32Type)!!
+        indices.forEachIndexed { lane, index ->
+            emitThrowIfOOB(index, Int32(elementCount).llvm)
+            result = insertElement(result, extractElement(lanes, index), Int32(lane).llvm)
+        }
+        return bitcast(vector128Type, result)
+    }
+
     private fun FunctionGenerationContext.emitPlus(args: List<LLVMValueRef>): LLVMValueRef {
         val (first, second) = args
         return if (first.type.isFloatingPoint()) {
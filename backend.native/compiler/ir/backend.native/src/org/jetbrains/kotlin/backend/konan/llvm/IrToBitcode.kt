@@ -399,6 +399,18 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
                         call(context.llvm.addTLSRecord, listOf(memory, context.llvm.tlsKey,
                                 Int32(context.llvm.tlsCount).llvm))
                     }
+                    // Tracing memory model doesn't count references from globals, so they have to be roots.
+                    if (context.memoryModel == MemoryModel.TRACING) {
+                        context.llvm.fileInitializers
+                                .forEach { irField ->
+                                    if (irField.type.binaryTypeIsReference() && irField.storageKind != FieldStorageKind.THREAD_LOCAL) {
+                                        val address = context.llvmDeclarations.forStaticField(irField).storageAddressAccess.getAddress(
+                                                functionGenerationContext
+                                        )
+                                        call(context.llvm.addGlobalRoot, listOf(address))
+                                    }
+                                }
+                    }
                     context.llvm.fileInitializers
                             .forEach { irField ->
                                 if (irField.initializer?.expression !is IrConst<*>?) {
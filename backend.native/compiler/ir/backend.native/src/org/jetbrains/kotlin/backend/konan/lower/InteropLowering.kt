@@ -92,6 +92,8 @@ internal abstract class BaseInteropIrTransformer(private val context: Context) :
 
             override val target get() = context.config.target
 
+            override val memoryModel get() = context.memoryModel
+
             override fun reportError(location: IrElement, message: String): Nothing =
                     context.reportCompilationError(message, irFile, location)
 
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package codegen.boxing.box_cache1
+
+import kotlin.native.internal.Debugging
+import kotlin.native.internal.GC
+import kotlin.test.*
+
+// Compiled with -Xbox-cache=int:-1000..1000 -Xbox-cache=long:1..0 -Xbox-cache=double:0..10.
+
+fun <T> areSame(arg1: T, arg2: T): Boolean {
+    return arg1 === arg2
+}
+
+fun configuredRanges() {
+    println((-2000..2000).count { areSame(it, it) })
+    println((-2000L..2000L).count { areSame(it, it) })
+    println(doubleArrayOf(-1.0, -0.0, 0.0, 0.5, 3.0, 10.0, 11.0, Double.NaN).count { areSame(it, it) })
+    // Default range.
+    println(floatArrayOf(-129.0f, -128.0f, -0.0f, 0.0f, 1.5f, 127.0f, 128.0f, Float.NaN).count { areSame(it, it) })
+}
+
+var sink: Any? = null
+
+// Every store releases the box stored before, which the next boxing can reuse.
+fun churnBoxes(count: Int) {
+    for (i in 0 until count) sink = i + 5000
+    sink = null
+}
+
+fun boxPool() {
+    assertEquals(0, GC.boxPoolCapacity)
+    assertFailsWith<IllegalArgumentException> { GC.boxPoolCapacity = -1 }
+    val reusedWithoutPool = Debugging.reusedBoxes
+    churnBoxes(100)
+    assertEquals(reusedWithoutPool, Debugging.reusedBoxes)
+
+    GC.boxPoolCapacity = 64
+    val reused = Debugging.reusedBoxes
+    churnBoxes(100)
+    assertTrue(Debugging.reusedBoxes - reused >= 99)
+
+    val map = HashMap<Int, Int>()
+    for (round in 0 until 3) {
+        for (i in 0 until 10000) map[i + 5000] = i + round
+        for (i in 0 until 10000 step 2) map.remove(i + 5000)
+    }
+    var sum = 0L
+    for ((key, value) in map) {
+        assertEquals(key - 5000 + 2, value)
+        sum += value
+    }
+    println(sum)
+    GC.boxPoolCapacity = 0
+}
+
+fun main() {
+    configuredRanges()
+    boxPool()
+}
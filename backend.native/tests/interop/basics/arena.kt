@@ -0,0 +1,64 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package interop.basics.arena
+
+import kotlin.test.*
+import kotlinx.cinterop.*
+
+private fun NativePointed.address() = this.rawPtr.toLong()
+
+@Test fun alignment() {
+    memScoped {
+        for (align in listOf(1, 2, 4, 8, 16, 32, 64)) {
+            alloc(1, 1)
+            val pointed = alloc(3, align)
+            assertEquals(0L, pointed.address() % align)
+        }
+    }
+}
+
+@Test fun manyAllocations() {
+    memScoped {
+        val vars = List(10000) { alloc<IntVar>().apply { value = it } }
+        vars.forEachIndexed { index, it -> assertEquals(index, it.value) }
+    }
+}
+
+@Test fun largeAllocations() {
+    memScoped {
+        val small = alloc<LongVar>()
+        val large = allocArray<LongVar>(100000)
+        small.value = 42L
+        for (i in 0 until 100000) large[i] = i.toLong()
+        assertEquals(42L, small.value)
+        assertEquals(99999L, large[99999])
+    }
+}
+
+@Test fun zeroInitializedAfterReuse() {
+    repeat(10) { iteration ->
+        memScoped {
+            val array = allocArray<ByteVar>(1000)
+            for (i in 0 until 1000) {
+                assertEquals(0, array[i])
+                array[i] = (iteration + 1).toByte()
+            }
+        }
+    }
+}
+
+@Test fun arenaClear() {
+    val arena = Arena()
+    repeat(3) {
+        val first = arena.alloc<IntVar>()
+        assertEquals(0, first.value)
+        first.value = 1
+        var deferred = false
+        arena.defer { deferred = true }
+        arena.clear()
+        assertTrue(deferred)
+    }
+}
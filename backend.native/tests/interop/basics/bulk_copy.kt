@@ -0,0 +1,61 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package interop.basics.bulk_copy
+
+import kotlin.test.*
+import kotlinx.cinterop.*
+
+@Test fun contiguous() {
+    memScoped {
+        val source = doubleArrayOf(1.0, 2.0, 3.0, 4.0)
+        val buffer = allocArray<DoubleVar>(4)
+        source.copyToNative(buffer)
+        assertEquals(3.0, buffer[2])
+
+        val destination = DoubleArray(6)
+        buffer.copyFromNative(destination, destinationOffset = 1, count = 4)
+        assertEquals(listOf(0.0, 1.0, 2.0, 3.0, 4.0, 0.0), destination.toList())
+    }
+}
+
+@Test fun strided() {
+    memScoped {
+        val buffer = allocArray<IntVar>(8)
+        intArrayOf(1, 2, 3, 4).copyToNative(buffer, stride = 8)
+        assertEquals(listOf(1, 0, 2, 0, 3, 0, 4, 0), (0 until 8).map { buffer[it] })
+
+        val destination = IntArray(2)
+        (buffer + 2)!!.copyFromNative(destination, stride = 16)
+        assertEquals(listOf(2, 4), destination.toList())
+    }
+}
+
+@Test fun swapBytes() {
+    memScoped {
+        val buffer = allocArray<IntVar>(2)
+        intArrayOf(0x01020304, 0x0a0b0c0d).copyToNative(buffer, swapBytes = true)
+        assertEquals(0x04030201, buffer[0])
+        assertEquals(0x0d0c0b0a, buffer[1])
+
+        val floats = FloatArray(1)
+        val floatBuffer = allocArray<FloatVar>(1)
+        floatArrayOf(1.5f).copyToNative(floatBuffer, swapBytes = true)
+        floatBuffer.copyFromNative(floats, swapBytes = true)
+        assertEquals(1.5f, floats[0])
+    }
+}
+
+@Test fun outOfBounds() {
+    memScoped {
+        val buffer = allocArray<LongVar>(4)
+        assertFailsWith<IndexOutOfBoundsException> {
+            buffer.copyFromNative(LongArray(2), destinationOffset = 1, count = 2)
+        }
+        assertFailsWith<IndexOutOfBoundsException> {
+            LongArray(2).copyToNative(buffer, startIndex = 1, endIndex = 3)
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package interop.basics.cstrings
+
+import kotlin.test.*
+import kotlinx.cinterop.*
+
+val string = "Hello, мир! 😀"
+
+@Test fun cstrRoundTrip() {
+    memScoped {
+        val cString = string.cstr
+        assertEquals(string.encodeToByteArray().size + 1, cString.size)
+        assertEquals(string, cString.ptr.toKString())
+        assertEquals("", "".cstr.ptr.toKString())
+    }
+}
+
+@Test fun useUtf8() {
+    val expected = string.encodeToByteArray()
+    string.useUtf8 { bytes, size ->
+        assertEquals(expected.size, size)
+        assertEquals(expected.toList(), bytes.readBytes(size).toList())
+        assertEquals(0.toByte(), bytes[size])
+    }
+    "".useUtf8 { bytes, size ->
+        assertEquals(0, size)
+        assertEquals(0.toByte(), bytes[0])
+    }
+}
+
+@Test fun malformedUtf16() {
+    // Lone surrogate is replaced with U+FFFD.
+    "a\uD800b".useUtf8 { bytes, size ->
+        assertEquals("a�b", bytes.toKString())
+        assertEquals(5, size)
+    }
+}
+
+@Test fun pinnedUtf16() {
+    string.useScopedPinned {
+        val chars = it.addressOf(0)
+        for (index in string.indices) {
+            assertEquals(string[index].toInt(), chars[index].toInt())
+        }
+        assertEquals(chars + string.length, it.addressOf(string.length))
+    }
+    assertFailsWith<IndexOutOfBoundsException> {
+        string.useScopedPinned { it.addressOf(string.length + 1) }
+    }
+}
+
+@Test fun utf16RoundTrip() {
+    memScoped {
+        assertEquals(string, string.utf16.ptr.toKStringFromUtf16())
+    }
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package interop.basics.pinning
+
+import kotlin.test.*
+import kotlinx.cinterop.*
+
+@Test fun usePinned() {
+    val array = IntArray(10)
+    array.usePinned {
+        assertSame(array, it.get())
+        it.addressOf(3).pointed.value = 42
+    }
+    assertEquals(42, array[3])
+}
+
+@Test fun useScopedPinned() {
+    val array = ByteArray(10)
+    val result = array.useScopedPinned {
+        assertSame(array, it.get())
+        val pointer = it.addressOf(0)
+        for (i in 0 until 10) pointer[i] = i.toByte()
+        pointer[9]
+    }
+    assertEquals(9.toByte(), result)
+    assertEquals((0 until 10).map { it.toByte() }, array.toList())
+}
+
+@Test fun scopedAndStablePinsAreConsistent() {
+    val array = DoubleArray(4)
+    array.usePinned { stable ->
+        array.useScopedPinned { scoped ->
+            assertEquals(stable.addressOf(2), scoped.addressOf(2))
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package interop.basics.stable_refs
+
+import kotlin.test.*
+import kotlinx.cinterop.*
+import kotlin.native.concurrent.*
+
+class Data(val value: Int)
+
+@Test fun createAndDisposeAll() {
+    val objects = Array(100) { Data(it) }
+    memScoped {
+        val pointers = allocArray<COpaquePointerVar>(objects.size)
+        StableRef.createAll(objects, pointers)
+        for (index in objects.indices) {
+            assertSame(objects[index], pointers[index]!!.asStableRef<Data>().get())
+        }
+        StableRef.disposeAll(pointers, objects.size)
+    }
+}
+
+@Test fun createAllRange() {
+    val objects = Array(10) { Data(it) }
+    memScoped {
+        val pointers = allocArray<COpaquePointerVar>(4)
+        StableRef.createAll(objects, pointers, startIndex = 3, endIndex = 7)
+        for (index in 0 until 4) {
+            assertEquals(index + 3, pointers[index]!!.asStableRef<Data>().get().value)
+        }
+        StableRef.disposeAll(pointers, 4)
+
+        assertFailsWith<IndexOutOfBoundsException> {
+            StableRef.createAll(objects, pointers, startIndex = 8, endIndex = 11)
+        }
+        assertFailsWith<IllegalArgumentException> {
+            StableRef.createAll(objects, pointers, startIndex = 5, endIndex = 4)
+        }
+    }
+}
+
+@Test fun disposeAllMixed() {
+    val frozen = Data(42).freeze()
+    val objects = arrayOf(Data(1), frozen, "string", frozen)
+    memScoped {
+        val pointers = allocArray<COpaquePointerVar>(objects.size)
+        StableRef.createAll(objects, pointers)
+        assertSame(frozen, pointers[3]!!.asStableRef<Data>().get())
+        StableRef.disposeAll(pointers, objects.size)
+    }
+}
+
+class Node(var next: Node? = null)
+
+private fun createFrozenCycle(): Node {
+    val node = Node()
+    node.next = Node(node)
+    return node.freeze()
+}
+
+@Test fun createAllCountsRepeatedReferences() {
+    val data = Data(7)
+    val cycle = createFrozenCycle()
+    // Members of the frozen cycle share a container, so they are counted as one run.
+    val objects = arrayOf<Any>(data, data, data, cycle, cycle.next!!, cycle, data)
+    memScoped {
+        val pointers = allocArray<COpaquePointerVar>(objects.size)
+        StableRef.createAll(objects, pointers)
+        for (index in 0 until objects.size - 1) {
+            pointers[index]!!.asStableRef<Any>().dispose()
+        }
+        assertSame(data, pointers[objects.size - 1]!!.asStableRef<Data>().get())
+        pointers[objects.size - 1]!!.asStableRef<Data>().dispose()
+    }
+    assertSame(cycle, cycle.next!!.next)
+}
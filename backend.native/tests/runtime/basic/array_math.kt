@@ -0,0 +1,84 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.basic.array_math
+
+import kotlin.math.*
+import kotlin.test.*
+
+// The C library functions used as the reference may be off by 1 ulp as well.
+fun assertUlps(expected: Double, actual: Double, ulps: Int = 2) {
+    if (expected == actual) return
+    if (expected.isNaN()) {
+        assertTrue(actual.isNaN(), "Expected NaN, got $actual")
+        return
+    }
+    assertTrue(abs(expected - actual) <= ulps * expected.ulp, "Expected $expected, got $actual")
+}
+
+fun assertUlps(expected: Float, actual: Float, ulps: Int = 2) {
+    if (expected == actual) return
+    if (expected.isNaN()) {
+        assertTrue(actual.isNaN(), "Expected NaN, got $actual")
+        return
+    }
+    assertTrue(abs(expected - actual) <= ulps * expected.ulp, "Expected $expected, got $actual")
+}
+
+val specials = doubleArrayOf(0.0, -0.0, 1.0, -1.0, Double.NaN, Double.POSITIVE_INFINITY, Double.NEGATIVE_INFINITY,
+        Double.MIN_VALUE, Double.MAX_VALUE, 709.9, -745.5, 1e-20, 3e6, -1e300,
+        // Bounds of the finite and nonzero exp() results.
+        709.782712893383973096, -745.133219101941108420)
+
+val values = DoubleArray(1000) { (it - 500) * 0.731 } + specials
+
+fun checkDouble(function: (Double) -> Double, vectorized: DoubleArray.(DoubleArray) -> DoubleArray) {
+    val result = values.vectorized(DoubleArray(values.size))
+    for (i in values.indices) {
+        assertUlps(function(values[i]), result[i])
+    }
+}
+
+fun checkFloat(function: (Float) -> Float, vectorized: FloatArray.(FloatArray) -> FloatArray) {
+    val floats = FloatArray(values.size) { values[it].toFloat() }
+    val result = floats.vectorized(FloatArray(floats.size))
+    for (i in floats.indices) {
+        assertUlps(function(floats[i]), result[i])
+    }
+}
+
+@Test fun functions() {
+    checkDouble(::sin) { sinInto(it) }
+    checkDouble(::cos) { cosInto(it) }
+    checkDouble(::exp) { expInto(it) }
+    checkDouble(::ln) { lnInto(it) }
+    checkDouble(::sqrt) { sqrtInto(it) }
+    checkDouble({ it.pow(1.5) }) { powInto(1.5, it) }
+    checkFloat(::sin) { sinInto(it) }
+    checkFloat(::cos) { cosInto(it) }
+    checkFloat(::exp) { expInto(it) }
+    checkFloat(::ln) { lnInto(it) }
+    checkFloat(::sqrt) { sqrtInto(it) }
+    checkFloat({ it.pow(1.5f) }) { powInto(1.5f, it) }
+    // Sign of zero is kept.
+    assertEquals(-0.0, doubleArrayOf(-0.0).sinInto()[0])
+}
+
+@Test fun ranges() {
+    val array = doubleArrayOf(0.0, 1.0, 4.0, 9.0, 16.0)
+    assertSame(array, array.sqrtInto(startIndex = 1, endIndex = 3))
+    assertEquals(listOf(0.0, 1.0, 2.0, 9.0, 16.0), array.toList())
+
+    // Overlapping ranges in both directions.
+    val long = DoubleArray(1000) { (it * it).toDouble() }
+    long.sqrtInto(long, destinationOffset = 1, endIndex = 999)
+    for (i in 1 until 1000) assertEquals((i - 1).toDouble(), long[i])
+    long.expInto(long, destinationOffset = 0, startIndex = 1)
+    for (i in 0 until 999) assertUlps(exp(i.toDouble()), long[i])
+
+    assertFailsWith<IndexOutOfBoundsException> { array.sinInto(startIndex = 2, endIndex = 6) }
+    assertFailsWith<IndexOutOfBoundsException> { array.sinInto(DoubleArray(2)) }
+    assertFailsWith<IndexOutOfBoundsException> { array.sinInto(startIndex = 3, endIndex = 2) }
+}
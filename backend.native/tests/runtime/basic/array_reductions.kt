@@ -0,0 +1,111 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.basic.array_reductions
+
+import kotlin.math.*
+import kotlin.test.*
+
+// Sizes around the unrolling and the pairwise block boundaries.
+val sizes = listOf(0, 1, 7, 8, 9, 127, 128, 129, 1000, 4099)
+
+fun testIntegers() {
+    for (size in sizes) {
+        val ints = IntArray(size) { it * 0x1234567 - 77 }
+        val longs = LongArray(size) { it * 0x123456789ABL - 77 }
+        assertEquals(ints.sum(), ints.sum(0, size))
+        assertEquals(longs.sum(), longs.sum(0, size))
+        assertEquals(ints.fold(0L) { acc, x -> acc + x.toLong() * x }, ints.dot(ints))
+        assertEquals(longs.fold(0L) { acc, x -> acc + x * x }, longs.dot(longs))
+        if (size > 2) {
+            val range = ints.copyOfRange(1, size - 1)
+            assertEquals(range.sum(), ints.sum(1, size - 1))
+            assertEquals(range.min(), ints.min(1, size - 1))
+            assertEquals(range.max(), ints.max(1, size - 1))
+            val longRange = longs.copyOfRange(1, size - 1)
+            assertEquals(longRange.min(), longs.min(1, size - 1))
+            assertEquals(longRange.max(), longs.max(1, size - 1))
+        }
+    }
+    assertEquals(Int.MIN_VALUE, intArrayOf(Int.MAX_VALUE, 1).sum(0, 2))
+}
+
+fun testFloatingSum() {
+    for (size in sizes) {
+        val doubles = DoubleArray(size) { sin(it.toDouble()) + 0.5 }
+        val floats = FloatArray(size) { doubles[it].toFloat() }
+        // Exact enough reference.
+        val expected = doubles.sum(Summation.KAHAN)
+        for (summation in Summation.values()) {
+            assertTrue(abs(doubles.sum() - doubles.sum(summation)) <= 1e-12 * size, "$summation: $size")
+            assertTrue(abs(expected - floats.sum(summation)) <= 1e-4 * size, "$summation: $size")
+            assertEquals(doubles.sum(summation), doubles.dot(DoubleArray(size) { 1.0 }, summation))
+        }
+    }
+}
+
+fun testCompensated() {
+    // 1 + 1e-16 * 10000 is not representable in the sequential summation.
+    val doubles = DoubleArray(10001) { if (it == 0) 1.0 else 1e-16 }
+    assertTrue(abs(1.000000000001 - doubles.sum(Summation.KAHAN)) <= 1.0.ulp)
+    assertEquals(1.0, doubles.sum())
+
+    // Cancellation.
+    val cancelling = doubleArrayOf(1.0, 1e100, 1.0, -1e100)
+    assertEquals(2.0, cancelling.sum(Summation.KAHAN))
+
+    val floats = FloatArray(1 shl 20) { 0.1f }
+    val exact = floats.size * 0.1f.toDouble()
+    assertTrue(abs(floats.sum(Summation.KAHAN) - exact) <= exact * 1e-7)
+    assertTrue(abs(floats.sum(Summation.PAIRWISE) - exact) <= exact * 1e-6)
+}
+
+fun testFloatingMinMax() {
+    val doubles = doubleArrayOf(3.0, -1.0, 5.0, 2.0, -7.0, 0.0, 4.0, 1.0, 6.0, -2.0)
+    assertEquals(-7.0, doubles.min(0, doubles.size))
+    assertEquals(6.0, doubles.max(0, doubles.size))
+    assertEquals(5.0, doubles.max(0, 4))
+    assertEquals(-1.0, doubles.min(1, 4))
+    doubles[8] = Double.NaN
+    assertTrue(doubles.max(0, doubles.size).isNaN())
+    assertTrue(doubles.min(5, 9).isNaN())
+    assertEquals(-7.0, doubles.min(0, 8))
+
+    val floats = floatArrayOf(1.0f, Float.NEGATIVE_INFINITY, 2.0f)
+    assertEquals(Float.NEGATIVE_INFINITY, floats.min(0, 3))
+    assertEquals(2.0f, floats.max(0, 3))
+
+    // Signed zeros are ordered like in minOf() and maxOf(), no matter which comes first.
+    val zeros = doubleArrayOf(0.0, -0.0, 0.0)
+    assertEquals(-0.0, zeros.min(0, 3))
+    assertEquals(-0.0, zeros.min(1, 3))
+    assertEquals(0.0, zeros.max(0, 2))
+    assertEquals(0.0, zeros.max(1, 3))
+    assertEquals(-0.0, zeros.max(1, 2))
+    val floatZeros = floatArrayOf(-0.0f, 0.0f)
+    assertEquals(minOf(-0.0f, 0.0f), floatZeros.min(0, 2))
+    assertEquals(maxOf(-0.0f, 0.0f), floatZeros.max(0, 2))
+    assertEquals(0.0f, floatZeros.max(0, 2))
+}
+
+fun testErrors() {
+    val ints = IntArray(10)
+    assertFailsWith<IndexOutOfBoundsException> { ints.sum(-1, 5) }
+    assertFailsWith<IndexOutOfBoundsException> { ints.sum(0, 11) }
+    assertFailsWith<IllegalArgumentException> { ints.sum(5, 4) }
+    assertFailsWith<NoSuchElementException> { ints.max(3, 3) }
+    assertFailsWith<NoSuchElementException> { DoubleArray(0).min(0, 0) }
+    assertFailsWith<IllegalArgumentException> { ints.dot(IntArray(9)) }
+    assertFailsWith<IllegalArgumentException> { FloatArray(1).dot(FloatArray(2)) }
+    assertFailsWith<IndexOutOfBoundsException> { DoubleArray(3).sum(Summation.PAIRWISE, 1, 4) }
+}
+
+@Test fun runTest() {
+    testIntegers()
+    testFloatingSum()
+    testCompensated()
+    testFloatingMinMax()
+    testErrors()
+}
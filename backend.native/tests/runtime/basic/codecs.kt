@@ -0,0 +1,97 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.basic.codecs
+
+import kotlin.test.*
+
+fun String.ascii() = ByteArray(length) { this[it].toByte() }
+
+// Sizes around the 12-byte and 16-byte blocks of the vectorized kernels.
+val random = ByteArray(1000) { (it * 2654435761L shr 11).toByte() }
+
+fun testBase64Vectors() {
+    // RFC 4648, section 10.
+    val vectors = listOf("" to "", "f" to "Zg==", "fo" to "Zm8=", "foo" to "Zm9v", "foob" to "Zm9vYg==",
+            "fooba" to "Zm9vYmE=", "foobar" to "Zm9vYmFy")
+    for ((plain, encoded) in vectors) {
+        assertEquals(encoded, Base64.Default.encodeToString(plain.ascii()))
+        assertEquals(encoded.trimEnd('='), Base64.DefaultNoPadding.encodeToString(plain.ascii()))
+        assertEquals(plain, Base64.Default.decode(encoded).stringFromUtf8())
+        assertEquals(plain, Base64.Default.decode(encoded.trimEnd('=')).stringFromUtf8())
+        assertEquals(plain, Base64.UrlSafeNoPadding.decode(encoded.ascii()).stringFromUtf8())
+    }
+    val bytes = byteArrayOf(-5, -17, -1, 62)
+    assertEquals("++//Pg==", Base64.Default.encodeToString(bytes))
+    assertEquals("--__Pg==", Base64.UrlSafe.encodeToString(bytes))
+    assertEquals("--__Pg", Base64.UrlSafeNoPadding.encodeToString(bytes))
+}
+
+fun testBase64RoundTrip() {
+    for (codec in listOf(Base64.Default, Base64.DefaultNoPadding, Base64.UrlSafe, Base64.UrlSafeNoPadding)) {
+        for (size in 0..100) {
+            val bytes = random.copyOf(size)
+            val string = codec.encodeToString(bytes)
+            assertEquals(codec.encodedSize(size), string.length)
+            assertEquals(string, codec.encodeToByteArray(bytes).stringFromUtf8())
+            assertTrue(bytes.contentEquals(codec.decode(string)))
+            assertTrue(bytes.contentEquals(codec.decode(string.ascii())))
+        }
+        val destination = ByteArray(2000)
+        val written = codec.encodeInto(random, destination, 7, 3, 900)
+        assertEquals(codec.encodeToString(random, 3, 900), destination.stringFromUtf8(7, written))
+        val decoded = ByteArray(1000)
+        assertEquals(897, codec.decodeInto(destination, decoded, 5, 7, 7 + written))
+        assertTrue(random.copyOfRange(3, 900).contentEquals(decoded.copyOfRange(5, 902)))
+    }
+}
+
+fun testBase64Errors() {
+    val codec = Base64.Default
+    assertFailsWith<IllegalArgumentException> { codec.decode("Zm9v*mFy") }
+    assertFailsWith<IllegalArgumentException> { codec.decode("Zm9vY") }
+    assertFailsWith<IllegalArgumentException> { codec.decode("Zm9vYg=") }
+    assertFailsWith<IllegalArgumentException> { codec.decode("Zg===") }
+    assertFailsWith<IllegalArgumentException> { codec.decode("Zm9v\nYmFy") }
+    assertFailsWith<IllegalArgumentException> { codec.decode("Zm9v_mFy") }
+    assertFailsWith<IllegalArgumentException> { Base64.UrlSafe.decode("Zm9v+mFy") }
+    // Characters beyond Latin-1 in the vectorized part.
+    assertFailsWith<IllegalArgumentException> { codec.decode("Zm9vYmFyZm9vYmFřZm9vYmFy") }
+    assertFailsWith<IndexOutOfBoundsException> { codec.encodeInto(random, ByteArray(10)) }
+    assertFailsWith<IndexOutOfBoundsException> { codec.decodeInto("Zm9vYmFy", ByteArray(5), 3) }
+    assertFailsWith<IndexOutOfBoundsException> { codec.encodeToString(random, 0, 1001) }
+}
+
+fun testHex() {
+    assertEquals("", Hex.encodeToString(ByteArray(0)))
+    assertEquals("00017f80ff", Hex.encodeToString(byteArrayOf(0, 1, 127, -128, -1)))
+    assertEquals("00017F80FF", Hex.encodeToString(byteArrayOf(0, 1, 127, -128, -1), upperCase = true))
+    for (size in 0..100) {
+        val bytes = random.copyOf(size)
+        val lower = Hex.encodeToString(bytes)
+        val upper = Hex.encodeToString(bytes, upperCase = true)
+        assertEquals(lower.toUpperCase(), upper)
+        assertTrue(bytes.contentEquals(Hex.decode(lower)))
+        assertTrue(bytes.contentEquals(Hex.decode(upper.ascii())))
+    }
+    val destination = ByteArray(100)
+    assertEquals(40, Hex.encodeInto(random, destination, 10, 5, 25))
+    assertEquals(Hex.encodeToString(random, 5, 25), destination.stringFromUtf8(10, 40))
+    val decoded = ByteArray(30)
+    assertEquals(20, Hex.decodeInto(destination, decoded, 3, 10, 50))
+    assertTrue(random.copyOfRange(5, 25).contentEquals(decoded.copyOfRange(3, 23)))
+
+    assertFailsWith<IllegalArgumentException> { Hex.decode("abc") }
+    assertFailsWith<IllegalArgumentException> { Hex.decode("0g") }
+    assertFailsWith<IllegalArgumentException> { Hex.decode("00112233445566778899aabbccddeeff0011223344556677889:aabbccddeeff") }
+    assertFailsWith<IndexOutOfBoundsException> { Hex.decodeInto("0011", ByteArray(1)) }
+}
+
+@Test fun runTest() {
+    testBase64Vectors()
+    testBase64RoundTrip()
+    testBase64Errors()
+    testHex()
+}
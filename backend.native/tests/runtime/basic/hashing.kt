@@ -0,0 +1,74 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.basic.hashing
+
+import kotlin.test.*
+
+fun ByteArray.toHex() = joinToString("") { (it.toInt() and 0xff).toString(16).padStart(2, '0') }
+
+val million = ByteArray(1_000_000) { 'a'.toByte() }
+val random = ByteArray(10_000) { (it * 2654435761L shr 13).toByte() }
+
+fun testCityHash() {
+    assertEquals(-0x651e95c4d06fbfb1L /* 0x9ae16a3b2f90404f */, ByteArray(0).cityHash64())
+    assertEquals(random.copyOfRange(3, 5000).cityHash64(), random.cityHash64(3, 5000))
+    assertNotEquals(random.cityHash64(), random.cityHash64(seed = 1L))
+    assertEquals(random.copyOfRange(100, 200).cityHash64(7L), random.cityHash64(7L, 100, 200))
+    for (string in listOf("", "a", "Hello, World!", "x".repeat(1000))) {
+        assertEquals(string.hashCode(), string.cityHash64().toInt())
+    }
+    assertFailsWith<IndexOutOfBoundsException> { random.cityHash64(0, 10_001) }
+}
+
+fun testCrc32c() {
+    assertEquals(0xe3069283L.toInt(), "123456789".toUtf8().crc32c())
+    assertEquals(0, ByteArray(0).crc32c())
+    // Streaming over unaligned pieces.
+    var crc = 0
+    var from = 0
+    for (length in listOf(1, 7, 8, 13, 100, 1000, 3)) {
+        crc = random.crc32c(from, from + length, crc)
+        from += length
+    }
+    assertEquals(random.crc32c(0, from), crc)
+    assertFailsWith<IllegalArgumentException> { random.crc32c(5, 4) }
+}
+
+fun testSha1() {
+    val sha1 = Sha1()
+    assertEquals("a9993e364706816aba3e25717850c26c9cd0d89d", sha1.update("abc".toUtf8()).digest().toHex())
+    // Digest resets the state.
+    assertEquals("da39a3ee5e6b4b0d3255bfef95601890afd80709", sha1.digest().toHex())
+    assertEquals("34aa973cd4c4daa4f61eeb2bdbad27316534016f", sha1.update(million).digest().toHex())
+    sha1.update(million, 0, 123_457).update(million, 123_457, million.size)
+    assertEquals("34aa973cd4c4daa4f61eeb2bdbad27316534016f", sha1.digest().toHex())
+    sha1.update(random)
+    sha1.reset()
+    assertEquals("da39a3ee5e6b4b0d3255bfef95601890afd80709", sha1.digest().toHex())
+}
+
+fun testSha256() {
+    val sha256 = Sha256()
+    assertEquals("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+            sha256.update("abc".toUtf8()).digest().toHex())
+    assertEquals("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", sha256.digest().toHex())
+    assertEquals("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+            sha256.update("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq".toUtf8()).digest().toHex())
+    for (step in listOf(1, 63, 64, 65, 1000)) {
+        for (from in 0 until million.size step step) {
+            sha256.update(million, from, minOf(from + step, million.size))
+        }
+        assertEquals("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", sha256.digest().toHex())
+    }
+    assertFailsWith<IndexOutOfBoundsException> { sha256.update(random, -1, 5) }
+}
+
+@Test fun runTest() {
+    testCityHash()
+    testCrc32c()
+    testSha1()
+    testSha256()
+}
@@ -61,3 +61,41 @@ fun testNextInt() {
     testReproducibility(getTimeMillis(), { nextInt(1000) })
     testReproducibility(1000L, { nextInt(1024) })
 }
+
+@Test
+fun testDefaultDoubles() {
+    repeat(1000) {
+        val value = Random.nextDouble()
+        assertTrue(value >= 0.0 && value < 1.0, "FAIL: $value is out of [0, 1)")
+    }
+}
+
+@Test
+fun testFillInts() {
+    val array = IntArray(101)
+    Random.fillInts(array, 1, 100)
+    assertEquals(0, array[0])
+    assertEquals(0, array[100])
+    assertTrue(array.slice(1 until 100).toSet().size > 90, "FAIL: too many repeated values")
+
+    assertEquals(Random(42).fillInts(IntArray(10)).toList(), Random(42).fillInts(IntArray(10)).toList())
+    assertFailsWith<IllegalArgumentException> { Random.fillInts(array, 0, 102) }
+    assertFailsWith<IllegalArgumentException> { Random.fillInts(array, 5, 4) }
+}
+
+@Test
+fun testFillDoubles() {
+    val array = Random.fillDoubles(DoubleArray(1000))
+    assertTrue(array.all { it >= 0.0 && it < 1.0 })
+    assertTrue(array.toSet().size > 990, "FAIL: too many repeated values")
+}
+
+@Test
+fun testNextBytes() {
+    val array = ByteArray(19)
+    Random.nextBytes(array, 3, 18)
+    assertEquals(0, array[0])
+    assertEquals(0, array[18])
+    assertTrue(array.slice(3 until 18).any { it != 0.toByte() })
+    assertFailsWith<IllegalArgumentException> { Random.nextBytes(array, -1, 5) }
+}
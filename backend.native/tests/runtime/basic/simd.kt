@@ -17,6 +17,11 @@ import kotlin.test.*
     testEquals()
     testHash()
     testDefaultValue()
+    testFloatArithmetic()
+    testIntArithmetic()
+    testCompare()
+    testShuffle()
+    testArrayLoadStore()
 }
 
 
@@ -102,3 +107,64 @@ private fun funDefaultValue(v: Vector128 = vectorOf(1.0f, 2.0f, 3.0f, 4.0f)) = v
 fun testDefaultValue() {
     assertEquals(vectorOf(1.0f, 2.0f, 3.0f, 4.0f), funDefaultValue())
 }
+
+fun testFloatArithmetic() {
+    val a = vectorOf(1f, 2f, 3f, 4f)
+    val b = vectorOf(8f, -2f, 0.5f, 4f)
+    assertEquals(vectorOf(9f, 0f, 3.5f, 8f), a.plusFloat(b))
+    assertEquals(vectorOf(-7f, 4f, 2.5f, 0f), a.minusFloat(b))
+    assertEquals(vectorOf(8f, -4f, 1.5f, 16f), a.timesFloat(b))
+    assertEquals(vectorOf(0.125f, -1f, 6f, 1f), a.divFloat(b))
+    assertEquals(vectorOf(9f, -2f, 4.5f, 20f), a.fmaFloat(b, a))
+    assertEquals(vectorOf(1f, -2f, 0.5f, 4f), a.minFloat(b))
+    assertEquals(vectorOf(8f, 2f, 3f, 4f), a.maxFloat(b))
+}
+
+fun testIntArithmetic() {
+    val a = vectorOf(1, -2, Int.MAX_VALUE, 7)
+    val b = vectorOf(3, 5, 1, -7)
+    assertEquals(vectorOf(4, 3, Int.MIN_VALUE, 0), a.plusInt(b))
+    assertEquals(vectorOf(-2, -7, Int.MAX_VALUE - 1, 14), a.minusInt(b))
+    assertEquals(vectorOf(3, -10, Int.MAX_VALUE, -49), a.timesInt(b))
+    assertEquals(vectorOf(1, -2, 1, -7), a.minInt(b))
+    assertEquals(vectorOf(3, 5, Int.MAX_VALUE, 7), a.maxInt(b))
+    assertEquals(vectorOf(1, 4, 1, 1), a and b)
+    assertEquals(vectorOf(3, -1, Int.MAX_VALUE, -1), a or b)
+    assertEquals(vectorOf(2, -5, Int.MAX_VALUE - 1, -2), a xor b)
+}
+
+fun testCompare() {
+    val a = vectorOf(1f, 2f, Float.NaN, 4f)
+    val b = vectorOf(1f, 3f, Float.NaN, 0f)
+    assertEquals(vectorOf(-1, 0, 0, 0), a.equalsFloat(b))
+    assertEquals(vectorOf(0, -1, 0, 0), a.lessFloat(b))
+    assertEquals(vectorOf(0, -1, -1, 0), vectorOf(1, -5, 2, 3).lessInt(vectorOf(1, 0, 3, 3)))
+    assertEquals(vectorOf(-1, 0, 0, -1), vectorOf(1, -5, 2, 3).equalsInt(vectorOf(1, 0, 3, 3)))
+}
+
+fun testShuffle() {
+    val v = vectorOf(10, 11, 12, 13)
+    assertEquals(vectorOf(13, 12, 11, 10), v.shuffle(3, 2, 1, 0))
+    assertEquals(vectorOf(10, 10, 13, 13), v.shuffle(0, 0, 3, 3))
+    val indices = intArrayOf(2, 0, 1, 3)
+    assertEquals(vectorOf(12, 10, 11, 13), v.shuffle(indices[0], indices[1], indices[2], indices[3]))
+    assertFailsWith<IndexOutOfBoundsException> {
+        v.shuffle(0, 1, 2, indices.size)
+    }
+}
+
+fun testArrayLoadStore() {
+    val floats = FloatArray(6) { it.toFloat() }
+    assertEquals(vectorOf(1f, 2f, 3f, 4f), floats.getVector128At(1))
+    floats.setVector128At(2, vectorOf(-1f, -2f, -3f, -4f))
+    assertEquals(listOf(0f, 1f, -1f, -2f, -3f, -4f), floats.toList())
+
+    val ints = IntArray(5) { it }
+    assertEquals(vectorOf(0, 1, 2, 3), ints.getVector128At(0))
+    ints.setVector128At(1, ints.getVector128At(0).plusInt(vectorOf(10, 10, 10, 10)))
+    assertEquals(listOf(0, 10, 11, 12, 13), ints.toList())
+
+    assertFailsWith<ArrayIndexOutOfBoundsException> { floats.getVector128At(3) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { ints.setVector128At(-1, vectorOf(0, 0, 0, 0)) }
+    assertFailsWith<ArrayIndexOutOfBoundsException> { IntArray(3).getVector128At(0) }
+}
@@ -230,6 +230,10 @@ fun testFlip() {
     b.flip(64, 67)
     assertContainsOnly(b, setOf(0, 1, 63, 64, 65, 69, 70), 71)
 
+    // Across several elements
+    b.flip(62..129)
+    assertContainsOnly(b, (62..129).toSet() - setOf(63, 64, 65, 69, 70) + setOf(0, 1), 130)
+
     // Access to a negative element must cause an exception.
     try {
         b.flip(-1)
@@ -415,6 +419,22 @@ fun testLogic() {
     assertFalse(b1.intersects(b2))
 }
 
+fun testCardinality() {
+    val b = BitSet(300)
+    assertEquals(b.cardinality(), 0)
+    b.set(3..200)
+    b.set(299)
+    assertEquals(b.cardinality(), 199)
+
+    val indices = mutableListOf<Int>()
+    b.clear(10..190)
+    b.forEachSetBit { indices.add(it) }
+    assertEquals(indices, (3..9).toList() + (191..200).toList() + 299)
+    assertEquals(b.nextClearBit(3), 10)
+    assertEquals(b.previousClearBit(200), 190)
+    assertEquals(b.nextClearBit(299), 300)
+}
+
 // Based on Harmony tests.
 fun testEqualsHashCode() {
     // HashCode.
@@ -452,5 +472,6 @@ fun testEqualsHashCode() {
     testFlip()
     testNextBit()
     testLogic()
+    testCardinality()
     testEqualsHashCode()
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.collections.CompressedBitSet
+
+import kotlin.test.*
+
+fun compressedBitSetOf(indices: Iterable<Int>) = CompressedBitSet().apply { indices.forEach { set(it) } }
+
+fun CompressedBitSet.toList() = mutableListOf<Int>().also { list -> forEachSetBit { list.add(it) } }
+
+fun testSetAndGet() {
+    val b = CompressedBitSet()
+    assertTrue(b.isEmpty)
+    b.set(5)
+    b.set(1_000_000_000)
+    b.set(70_000)
+    assertTrue(b[5])
+    assertTrue(b[70_000])
+    assertTrue(b[1_000_000_000])
+    assertFalse(b[6])
+    assertFalse(b[1_000_000_001])
+    assertEquals(3, b.cardinality())
+    assertEquals(listOf(5, 70_000, 1_000_000_000), b.toList())
+    assertEquals(70_000, b.nextSetBit(6))
+    assertEquals(1_000_000_000, b.nextSetBit(70_001))
+    assertEquals(-1, b.nextSetBit(1_000_000_001))
+
+    b.clear(70_000)
+    assertFalse(b[70_000])
+    assertEquals("[5|1000000000]", b.toString())
+    b.clear()
+    assertTrue(b.isEmpty)
+
+    assertFailsWith<IndexOutOfBoundsException> { b.set(-1) }
+}
+
+fun testDenseChunks() {
+    // More than fits into a sorted array chunk.
+    val b = compressedBitSetOf(0 until 10_000 step 2)
+    assertEquals(5_000, b.cardinality())
+    assertTrue(b[9_998])
+    assertFalse(b[9_999])
+    assertEquals(9_998, b.nextSetBit(9_997))
+    for (i in 0 until 2_000 step 2) b.clear(i)
+    assertEquals(4_000, b.cardinality())
+    assertEquals(2_000, b.nextSetBit(0))
+    assertEquals((2_000 until 10_000 step 2).toList(), b.toList())
+    assertEquals(compressedBitSetOf(2_000 until 10_000 step 2), b)
+}
+
+fun testLogic() {
+    val evens = (0 until 20_000 step 2).toSet() + (1_000_000 until 1_000_010)
+    val triples = (0 until 30_000 step 3).toSet() + 5_000_000
+    fun check(expected: Set<Int>, operation: CompressedBitSet.(CompressedBitSet) -> Unit) {
+        val b = compressedBitSetOf(evens)
+        b.operation(compressedBitSetOf(triples))
+        assertEquals(expected.sorted(), b.toList())
+        assertEquals(compressedBitSetOf(expected), b)
+    }
+    check(evens intersect triples) { and(it) }
+    check(evens union triples) { or(it) }
+    check((evens union triples) - (evens intersect triples)) { xor(it) }
+    check(evens - triples) { andNot(it) }
+
+    assertTrue(compressedBitSetOf(evens).intersects(compressedBitSetOf(triples)))
+    assertFalse(compressedBitSetOf(listOf(1, 70_000)).intersects(compressedBitSetOf(listOf(2, 70_001))))
+    assertEquals(evens.sorted(), compressedBitSetOf(evens).toBitSet().let { bitSet ->
+        mutableListOf<Int>().also { list -> bitSet.forEachSetBit { list.add(it) } }
+    })
+}
+
+@Test fun runTest() {
+    testSetAndGet()
+    testDenseChunks()
+    testLogic()
+}
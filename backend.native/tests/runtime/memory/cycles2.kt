@@ -0,0 +1,120 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.memory.cycles2
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+import kotlin.native.internal.GC
+import kotlin.native.ref.*
+import platform.posix.usleep
+
+class Node(var next: Node? = null) {
+    val payload = IntArray(16)
+}
+
+private fun createLoop(length: Int): WeakReference<Node> {
+    val head = Node()
+    var current = head
+    repeat(length - 1) {
+        current = Node(current)
+    }
+    head.next = current
+    return WeakReference(head)
+}
+
+private fun createLoops(count: Int) = List(count) { createLoop(it % 5 + 1) }
+
+@Test fun garbageCyclesAreCollected() {
+    assertEquals(MemoryModel.RELAXED, Platform.memoryModel)
+    val weakRefs = createLoops(1000)
+    GC.collect()
+    weakRefs.forEach { assertNull(it.get()) }
+}
+
+@Test fun reachableCyclesSurvive() {
+    val head = Node()
+    head.next = Node(head)
+    val weakRef = WeakReference(head.next!!)
+    createLoops(100)
+    GC.collect()
+    assertSame(head, weakRef.get()!!.next)
+    assertSame(weakRef.get(), head.next)
+}
+
+private fun createSharedLoops(count: Int) = List(count) { createLoop(it % 5 + 1).get()!! }
+
+// Keeps the loops out of the test frame, so they become garbage on return.
+private fun createLoopsOn(workers: Array<Worker>): List<WeakReference<Node>> {
+    val futures = workers.map { it.execute(TransferMode.SAFE, { }) { createSharedLoops(1000) } }
+    return futures.flatMap { future -> future.result.map { WeakReference(it) } }
+}
+
+@Test fun cyclesAreCollectedWhileWorkersRun() {
+    val workers = Array(4) { Worker.start() }
+    val futures = workers.map {
+        it.execute(TransferMode.SAFE, { }) {
+            val weakRefs = createLoops(10000)
+            // May give up stopping the world, when another worker is collecting.
+            GC.collect()
+            weakRefs
+        }
+    }
+    val mainWeakRefs = createLoops(10000)
+    val workerWeakRefs = futures.flatMap { it.result }
+    workers.forEach { it.requestTermination().result }
+    // Candidates of the terminated workers are left to the main thread.
+    GC.collect()
+    mainWeakRefs.forEach { assertNull(it.get()) }
+    workerWeakRefs.forEach { assertNull(it.get()) }
+}
+
+@Test fun cyclesAllocatedByOtherThreadsAreCollected() {
+    val workers = Array(4) { Worker.start() }
+    // Loops are created by the workers, but become garbage on the main thread, so their
+    // containers are released by a thread which did not allocate them.
+    val weakRefs = createLoopsOn(workers)
+    GC.collect()
+    weakRefs.forEach { assertNull(it.get()) }
+    workers.forEach { it.requestTermination().result }
+}
+
+@SharedImmutable
+val blocker = Semaphore(0)
+
+@SharedImmutable
+val inForeignCode = AtomicInt(0)
+
+@Test fun cyclesAreCollectedWhileOtherThreadIsBlocked() {
+    val worker = Worker.start()
+    val future = worker.execute(TransferMode.SAFE, { }) { blocker.acquire() }
+    // Let the worker get past spinning and park.
+    usleep(100_000u)
+    val weakRefs = createLoops(1000)
+    GC.collect()
+    weakRefs.forEach { assertNull(it.get()) }
+    blocker.release()
+    future.result
+    worker.requestTermination().result
+}
+
+@Test fun cyclesAreCollectedWhileOtherThreadRunsForeignCode() {
+    // On Apple targets C calls can get back to Kotlin through Objective-C, so they are made outside of safe regions.
+    if (Platform.osFamily in setOf(OsFamily.MACOSX, OsFamily.IOS, OsFamily.TVOS, OsFamily.WATCHOS)) return
+    val worker = Worker.start()
+    val future = worker.execute(TransferMode.SAFE, { }) {
+        inForeignCode.value = 1
+        while (inForeignCode.value == 1) {
+            usleep(10_000u)
+        }
+    }
+    while (inForeignCode.value == 0) {}
+    val weakRefs = createLoops(1000)
+    GC.collect()
+    weakRefs.forEach { assertNull(it.get()) }
+    inForeignCode.value = 0
+    future.result
+    worker.requestTermination().result
+}
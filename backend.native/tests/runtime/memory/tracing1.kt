@@ -0,0 +1,140 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.memory.tracing1
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+import kotlin.native.internal.GC
+import kotlin.native.ref.*
+import platform.posix.usleep
+
+class Node(var next: Node? = null)
+
+var global: Node? = null
+
+object Holder {
+    var node: Node? = null
+}
+
+class WithCompanion {
+    companion object {
+        var node: Node? = null
+    }
+}
+
+@ThreadLocal
+var threadLocal: Node? = null
+
+@SharedImmutable
+val blocker = Semaphore(0)
+
+@SharedImmutable
+val inForeignCode = AtomicInt(0)
+
+// Helpers keep temporaries out of the test frames, which are scanned as roots.
+private fun createGarbage(): WeakReference<Node> {
+    val node = Node()
+    node.next = Node(node)
+    return WeakReference(node)
+}
+
+private fun createCycle(): Node {
+    val node = Node()
+    node.next = Node(node)
+    return node
+}
+
+private fun setRoots(): List<WeakReference<Node>> {
+    global = createCycle()
+    Holder.node = createCycle()
+    WithCompanion.node = createCycle()
+    threadLocal = createCycle()
+    return listOf(global!!, Holder.node!!, WithCompanion.node!!, threadLocal!!).map { WeakReference(it.next!!) }
+}
+
+private fun clearRoots() {
+    global = null
+    Holder.node = null
+    WithCompanion.node = null
+    threadLocal = null
+}
+
+private fun disposeStableRef(pointer: StableRef<Node>): WeakReference<Node> {
+    val weakRef = WeakReference(pointer.get())
+    pointer.dispose()
+    return weakRef
+}
+
+private fun setWorkerThreadLocal(worker: Worker) =
+        worker.execute(TransferMode.SAFE, { }) {
+            threadLocal = createCycle()
+            WeakReference(threadLocal!!.next!!)
+        }.result
+
+@Test fun staticLocationsAreRoots() {
+    assertEquals(MemoryModel.TRACING, Platform.memoryModel)
+    val weakRefs = setRoots()
+    val garbage = createGarbage()
+    GC.collect()
+    assertNull(garbage.get())
+    weakRefs.forEach { assertNotNull(it.get()) }
+    clearRoots()
+    GC.collect()
+    weakRefs.forEach { assertNull(it.get()) }
+}
+
+@Test fun threadLocalsOfOtherThreadsAreRoots() {
+    val worker = Worker.start()
+    val weakRef = setWorkerThreadLocal(worker)
+    // The worker waits for jobs in a safe region, so its TLS is scanned by the main thread.
+    GC.collect()
+    assertNotNull(weakRef.get())
+    worker.execute(TransferMode.SAFE, { }) { threadLocal = null }.result
+    GC.collect()
+    assertNull(weakRef.get())
+    worker.requestTermination().result
+}
+
+@Test fun stablePointersAreRoots() {
+    val pointer = StableRef.create(Node(Node()))
+    GC.collect()
+    assertNotNull(pointer.get().next)
+    val weakRef = disposeStableRef(pointer)
+    GC.collect()
+    assertNull(weakRef.get())
+}
+
+@Test fun collectionProceedsWhileOtherThreadIsBlocked() {
+    val worker = Worker.start()
+    val future = worker.execute(TransferMode.SAFE, { }) { blocker.acquire() }
+    // Let the worker get past spinning and park.
+    usleep(100_000u)
+    val weakRef = createGarbage()
+    GC.collect()
+    assertNull(weakRef.get())
+    blocker.release()
+    future.result
+    worker.requestTermination().result
+}
+
+@Test fun collectionProceedsWhileOtherThreadRunsForeignCode() {
+    // On Apple targets C calls can get back to Kotlin through Objective-C, so they are made outside of safe regions.
+    if (Platform.osFamily in setOf(OsFamily.MACOSX, OsFamily.IOS, OsFamily.TVOS, OsFamily.WATCHOS)) return
+    val worker = Worker.start()
+    val future = worker.execute(TransferMode.SAFE, { }) {
+        inForeignCode.value = 1
+        while (inForeignCode.value == 1) {
+            usleep(10_000u)
+        }
+    }
+    while (inForeignCode.value == 0) {}
+    val weakRef = createGarbage()
+    GC.collect()
+    assertNull(weakRef.get())
+    inForeignCode.value = 0
+    future.result
+    worker.requestTermination().result
+}
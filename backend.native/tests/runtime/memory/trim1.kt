@@ -0,0 +1,54 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.memory.trim1
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+import kotlin.native.internal.Debugging
+import kotlin.native.internal.GC
+
+private fun allocate() = List(100000) { IntArray(16) }.size
+
+@Test fun residentMemoryIsReported() {
+    val rss = GC.residentMemory
+    val peak = GC.peakResidentMemory
+    when (Platform.osFamily) {
+        OsFamily.LINUX, OsFamily.MACOSX -> {
+            assertTrue(rss > 0)
+            assertTrue(peak > 0)
+        }
+        else -> {
+            assertTrue(rss > 0 || rss == -1L)
+            assertTrue(peak > 0 || peak == -1L)
+        }
+    }
+}
+
+@Test fun trimMemory() {
+    assertEquals(100000, allocate())
+    val trims = Debugging.memoryTrims
+    GC.trimMemory()
+    assertTrue(Debugging.memoryTrims > trims)
+    assertEquals(100000, allocate())
+}
+
+@Test fun idleTrimInterval() {
+    assertFailsWith<IllegalArgumentException> { GC.idleTrimInterval = -1 }
+    val old = GC.idleTrimInterval
+    GC.idleTrimInterval = 1
+    assertEquals(1L, GC.idleTrimInterval)
+    val worker = Worker.start()
+    val trims = Debugging.memoryTrims
+    repeat(10) {
+        // Worker returns memory to the OS while waiting for the next job.
+        assertEquals(100000, worker.execute(TransferMode.SAFE, { }) { allocate() }.result)
+    }
+    worker.requestTermination().result
+    // Every job takes longer than the interval, so the worker is past it whenever it runs out of jobs.
+    assertTrue(Debugging.memoryTrims > trims)
+    GC.collect()
+    GC.idleTrimInterval = old
+}
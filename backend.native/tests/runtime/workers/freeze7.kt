@@ -0,0 +1,100 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.workers.freeze7
+
+import kotlin.test.*
+import kotlin.native.concurrent.*
+import kotlin.native.ref.*
+
+class Entry(val name: String, val value: Any?, val data: IntArray)
+
+class Holder(var value: Any?)
+
+// Not a compile-time constant, so every call returns a new string.
+fun text(prefix: String, index: Int) = prefix + index
+
+fun makeName(index: Int) = text("name", index % 3)
+
+@Test
+fun deduplicatesLeaves() {
+    val entries = Array(30) {
+        // Outside of the box cache range.
+        Entry(makeName(it), (it % 2) * 1000 + 1000, intArrayOf(1, 2, it % 2))
+    }
+    assertNotSame(entries[0].name, entries[3].name)
+    val table = entries.toList().freezeDeduplicated()
+
+    assertTrue(table.isFrozen)
+    for (i in table.indices) {
+        assertEquals(makeName(i), table[i].name)
+        assertEquals((i % 2) * 1000 + 1000, table[i].value)
+        assertTrue(intArrayOf(1, 2, i % 2) contentEquals table[i].data)
+        assertSame(table[i % 3].name, table[i].name)
+        assertSame(table[i % 2].value, table[i].value)
+    }
+    assertNotSame(table[0].name, table[1].name)
+    // Arrays are mutable, so equal ones are kept apart.
+    assertNotSame(table[0].data, table[2].data)
+    println("OK")
+}
+
+@Test
+fun keepsArraysAliasedFromOutside() {
+    val shared = intArrayOf(1, 2)
+    val frozen = listOf(Holder(intArrayOf(1, 2)), Holder(shared)).freezeDeduplicated()
+    assertSame(shared, frozen[1].value)
+    assertTrue(shared.isFrozen)
+    assertFailsWith<InvalidMutabilityException> { shared[0] = 3 }
+    println("OK")
+}
+
+@Test
+fun distinguishesTypesAndValues() {
+    val values = listOf<Any>(1000, 1000L, 1000.0, 1000.0f, -0.0, 0.0, intArrayOf(1), longArrayOf(1), text("a", 1), text("a", 1))
+    val frozen = values.map { Holder(it) }.freezeDeduplicated()
+    for (i in 0 until 8)
+        for (j in i + 1 until 8)
+            assertNotSame(frozen[i].value, frozen[j].value)
+    assertSame(frozen[8].value, frozen[9].value)
+    println("OK")
+}
+
+@Test
+fun keepsObservedLeaves() {
+    val first = text("b", 2)
+    val second = text("b", 2)
+    val weak = WeakReference(second)
+    val frozen = listOf(Holder(first), Holder(second)).freezeDeduplicated()
+    assertNotSame(frozen[0].value, frozen[1].value)
+    assertSame(second, weak.get())
+    println("OK")
+}
+
+@Test
+fun failsWithoutChanges() {
+    val first = text("c", 3)
+    val second = text("c", 3)
+    val blocker = Holder(null)
+    blocker.ensureNeverFrozen()
+    val holders = listOf(Holder(first), Holder(second), blocker)
+    assertFailsWith<FreezingException> { holders.freezeDeduplicated() }
+    assertFalse(holders.isFrozen)
+    assertSame(second, holders[1].value)
+    println("OK")
+}
+
+@Test
+fun failsWithoutChangesOnBlockerBehindAtomic() {
+    val first = text("d", 4)
+    val second = text("d", 4)
+    val blocker = Holder(null)
+    blocker.ensureNeverFrozen()
+    val holders = listOf(Holder(first), Holder(second), Holder(FreezableAtomicReference(blocker)))
+    assertFailsWith<FreezingException> { holders.freezeDeduplicated() }
+    assertFalse(holders.isFrozen)
+    assertSame(second, holders[1].value)
+    println("OK")
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2010-2018 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.workers.lazy3
+
+import kotlin.test.*
+
+import kotlin.native.concurrent.*
+import kotlin.native.internal.Debugging
+
+class Node(val next: Node?, val ref: AtomicReference<Any?>)
+
+fun makeGraph(size: Int): Node {
+    var node: Node? = null
+    for (i in 0 until size)
+        node = Node(node, AtomicReference(null))
+    return node!!.freeze()
+}
+
+class Holder(val graph: Node) {
+    val value by lazy { graph }
+}
+
+@Test fun runTest() {
+    // Graph frozen before the lazy cannot refer to it.
+    val graph = makeGraph(1000)
+    val holder = Holder(graph).freeze()
+    val pruned = Debugging.prunedAcyclicityChecks
+    assertSame(graph, holder.value)
+    assertEquals(pruned + 1, Debugging.prunedAcyclicityChecks)
+
+    // Unless it was mutated afterwards.
+    val cyclicGraph = makeGraph(1000)
+    val cyclicHolder = Holder(cyclicGraph).freeze()
+    cyclicGraph.next!!.ref.value = cyclicHolder
+    val prunedBeforeCyclic = Debugging.prunedAcyclicityChecks
+    assertFailsWith<InvalidMutabilityException> {
+        cyclicHolder.value
+    }
+    assertEquals(prunedBeforeCyclic, Debugging.prunedAcyclicityChecks)
+
+    // Later lazies take the shortcut again.
+    val laterGraph = makeGraph(1000)
+    val laterHolder = Holder(laterGraph).freeze()
+    assertSame(laterGraph, laterHolder.value)
+    assertEquals(prunedBeforeCyclic + 1, Debugging.prunedAcyclicityChecks)
+    println("OK")
+}
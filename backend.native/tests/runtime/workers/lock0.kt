@@ -0,0 +1,95 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.workers.lock0
+
+import kotlin.test.*
+
+import kotlin.native.concurrent.*
+
+const val ITERATIONS = 10000
+const val WORKER_COUNT = 4
+
+fun testLock(workers: Array<Worker>) {
+    val lock = Lock()
+    val counter = AtomicInt(0)
+    val futures = Array(workers.size, { workerIndex ->
+        workers[workerIndex].execute(TransferMode.SAFE, { Pair(lock, counter) }) {
+            (lock, counter) ->
+            repeat(ITERATIONS) {
+                lock.withLock {
+                    // Not atomic as a whole, so only correct under the lock.
+                    counter.value = counter.value + 1
+                    // Reentrance.
+                    lock.withLock { counter.value = counter.value + 1 }
+                }
+            }
+        }
+    })
+    futures.forEach { it.result }
+    assertEquals(2 * ITERATIONS * workers.size, counter.value)
+    assertTrue(lock.tryLock())
+    lock.unlock()
+    assertFailsWith<IllegalStateException> { lock.unlock() }
+}
+
+fun testCondition(workers: Array<Worker>) {
+    val lock = Lock()
+    val condition = Condition(lock)
+    // Workers take turns: the one with index `turn % workers.size` increments it.
+    val turn = AtomicInt(0)
+    val futures = Array(workers.size, { workerIndex ->
+        workers[workerIndex].execute(TransferMode.SAFE, { Triple(condition, turn, workerIndex) }) {
+            (condition, turn, index) ->
+            condition.lock.withLock {
+                for (round in 0 until 100) {
+                    while (turn.value % WORKER_COUNT != index) condition.await()
+                    turn.increment()
+                    condition.signalAll()
+                }
+            }
+        }
+    })
+    futures.forEach { it.result }
+    assertEquals(100 * workers.size, turn.value)
+    lock.withLock {
+        assertFalse(condition.await(10))
+    }
+}
+
+fun testSemaphore(workers: Array<Worker>) {
+    val semaphore = Semaphore(2)
+    val inside = AtomicInt(0)
+    val maxInside = AtomicInt(0)
+    val futures = Array(workers.size, { workerIndex ->
+        workers[workerIndex].execute(TransferMode.SAFE, { Triple(semaphore, inside, maxInside) }) {
+            (semaphore, inside, maxInside) ->
+            repeat(1000) {
+                semaphore.acquire()
+                val current = inside.addAndGet(1)
+                while (true) {
+                    val max = maxInside.value
+                    if (current <= max || maxInside.compareAndSet(max, current)) break
+                }
+                inside.decrement()
+                semaphore.release()
+            }
+        }
+    })
+    futures.forEach { it.result }
+    assertTrue(maxInside.value <= 2)
+    assertEquals(2, semaphore.availablePermits)
+}
+
+@Test fun runTest() {
+    val workers = Array(WORKER_COUNT, { _ -> Worker.start() })
+    testLock(workers)
+    testCondition(workers)
+    testSemaphore(workers)
+    workers.forEach {
+        it.requestTermination().result
+    }
+    println("OK")
+}
@@ -33,7 +33,7 @@ internal val Project.nativeBenchResults: String
 
 // Gradle property to add flags to benchmarks run from command line.
 internal val Project.compilerArgs: List<String>
-    get() = (findProperty("compilerArgs") as String?)?.split("\\s").orEmpty()
+    get() = (findProperty("compilerArgs") as String?)?.split(Regex("\\s+"))?.filter { it.isNotEmpty() }.orEmpty()
 
 internal val Project.kotlinVersion: String
     get() = property("kotlinVersion") as String
@@ -230,4 +230,8 @@ uint64_t CityHash64(const void* data, size_t len) {
                    HashLen16(v.second, w.second) + x);
 }
 
+uint64_t CityHash64WithSeed(const void* data, size_t len, uint64_t seed) {
+  return HashLen16(CityHash64(data, len) - k2, seed);
+}
+
 } // extern "C"
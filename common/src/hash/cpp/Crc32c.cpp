@@ -0,0 +1,129 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+#include "Crc32c.h"
+
+#include <string.h>
+
+#include "CpuFeatures.h"
+
+#if HASH_X86
+#include <nmmintrin.h>
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace {
+
+// Reflected polynomial.
+constexpr uint32_t kPolynomial = 0x82f63b78;
+
+// Tables for the slicing-by-8 algorithm: table[k][b] is the CRC of byte b followed by k zero bytes.
+struct Tables {
+  uint32_t table[8][256];
+
+  constexpr Tables() : table() {
+    for (uint32_t b = 0; b < 256; b++) {
+      uint32_t crc = b;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (kPolynomial & (0 - (crc & 1)));
+      }
+      table[0][b] = crc;
+    }
+    for (uint32_t b = 0; b < 256; b++) {
+      for (int k = 1; k < 8; k++) {
+        table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xff];
+      }
+    }
+  }
+};
+
+constexpr Tables kTables;
+
+uint64_t Load64(const uint8_t* p) {
+  uint64_t result;
+  memcpy(&result, p, sizeof(result));
+  return result;
+}
+
+uint32_t Crc32cSoftware(uint32_t crc, const uint8_t* data, size_t len) {
+  const auto& t = kTables.table;
+#if BYTE_ORDER == LITTLE_ENDIAN
+  for (; len >= 8; data += 8, len -= 8) {
+    uint64_t word = Load64(data) ^ crc;
+    crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff] ^ t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff] ^
+        t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff] ^ t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+  }
+#endif
+  for (; len > 0; data++, len--) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+  }
+  return crc;
+}
+
+#if HASH_X86
+
+__attribute__((target("sse4.2")))
+uint32_t Crc32cSse42(uint32_t crc, const uint8_t* data, size_t len) {
+#if defined(__x86_64__)
+  uint64_t crc64 = crc;
+  for (; len >= 8; data += 8, len -= 8) {
+    crc64 = _mm_crc32_u64(crc64, Load64(data));
+  }
+  crc = static_cast<uint32_t>(crc64);
+#endif
+  for (; len > 0; data++, len--) {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+  return crc;
+}
+
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+
+uint32_t Crc32cArm(uint32_t crc, const uint8_t* data, size_t len) {
+  for (; len >= 8; data += 8, len -= 8) {
+    crc = __crc32cd(crc, Load64(data));
+  }
+  for (; len > 0; data++, len--) {
+    crc = __crc32cb(crc, *data);
+  }
+  return crc;
+}
+
+#endif
+
+using Crc32cFunction = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+Crc32cFunction SelectCrc32c() {
+#if defined(__ARM_FEATURE_CRC32)
+  return Crc32cArm;
+#else
+#if HASH_X86
+  if (hash::HasSse42()) return Crc32cSse42;
+#endif
+  return Crc32cSoftware;
+#endif
+}
+
+// Selected on the first use. Concurrent first uses select the same function, so no synchronization is needed.
+Crc32cFunction crc32cImpl = nullptr;
+
+} // namespace
+
+extern "C" {
+
+uint32_t Crc32c(uint32_t crc, const void* buf, size_t len) {
+  Crc32cFunction impl = __atomic_load_n(&crc32cImpl, __ATOMIC_RELAXED);
+  if (impl == nullptr) {
+    impl = SelectCrc32c();
+    __atomic_store_n(&crc32cImpl, impl, __ATOMIC_RELAXED);
+  }
+  return ~impl(~crc, reinterpret_cast<const uint8_t*>(buf), len);
+}
+
+} // extern "C"
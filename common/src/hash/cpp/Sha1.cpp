@@ -38,6 +38,12 @@ A million repetitions of "a"
 
 #include "Sha1.h"
 
+#include "CpuFeatures.h"
+
+#if HASH_X86
+#include <immintrin.h>
+#endif
+
 #define rol(value, bits) (((value) << (bits)) | ((value) >> (32 - (bits))))
 
 /* blk0() and blk() perform the initial expand. */
@@ -119,6 +125,68 @@ static void SHA1Transform(uint32_t state[5], const unsigned char buffer[64])
 #endif
 }
 
+#if HASH_X86
+
+/* Hash 64-byte blocks with the SHA extensions, 4 rounds per instruction. */
+#define SHA1_NI_ROUNDS(f) \
+    previous = abcd; \
+    abcd = _mm_sha1rnds4_epu32(abcd, e, f); \
+    next = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w0, w1), w2), w3); \
+    w0 = w1; w1 = w2; w2 = w3; w3 = next; \
+    e = _mm_sha1nexte_epu32(previous, w0);
+
+__attribute__((target("sha,sse4.1")))
+static void SHA1TransformSha(uint32_t state[5], const unsigned char* data, size_t blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0x1B);
+    __m128i e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+    for ( ; blocks > 0; blocks--, data += 64) {
+        __m128i abcdSaved = abcd;
+        __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), byteSwap);
+        __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), byteSwap);
+        __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), byteSwap);
+        __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), byteSwap);
+        __m128i e = _mm_add_epi32(e0, w0);
+        __m128i previous, next;
+        for (int i = 0; i < 5; i++) { SHA1_NI_ROUNDS(0) }
+        for (int i = 0; i < 5; i++) { SHA1_NI_ROUNDS(1) }
+        for (int i = 0; i < 5; i++) { SHA1_NI_ROUNDS(2) }
+        for (int i = 0; i < 5; i++) { SHA1_NI_ROUNDS(3) }
+        e0 = _mm_sha1nexte_epu32(previous, e0);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+    }
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+#endif
+
+typedef void (*SHA1TransformFunction)(uint32_t state[5], const unsigned char* data, size_t blocks);
+
+static void SHA1TransformPortable(uint32_t state[5], const unsigned char* data, size_t blocks)
+{
+    for ( ; blocks > 0; blocks--, data += 64) {
+        SHA1Transform(state, data);
+    }
+}
+
+/* Selected on the first use. Concurrent first uses select the same function. */
+static SHA1TransformFunction transformImpl = NULL;
+
+static void SHA1TransformBlocks(uint32_t state[5], const unsigned char* data, size_t blocks)
+{
+    SHA1TransformFunction impl = __atomic_load_n(&transformImpl, __ATOMIC_RELAXED);
+    if (impl == NULL) {
+        impl = SHA1TransformPortable;
+#if HASH_X86
+        if (hash::HasShaExtensions()) impl = SHA1TransformSha;
+#endif
+        __atomic_store_n(&transformImpl, impl, __ATOMIC_RELAXED);
+    }
+    impl(state, data, blocks);
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -148,10 +216,9 @@ void SHA1Update(SHA1_CTX* context, const unsigned char* data, uint32_t len)
     j = (j >> 3) & 63;
     if ((j + len) > 63) {
         memcpy(&context->buffer[j], data, (i = 64-j));
-        SHA1Transform(context->state, context->buffer);
-        for ( ; i + 63 < len; i += 64) {
-            SHA1Transform(context->state, &data[i]);
-        }
+        SHA1TransformBlocks(context->state, context->buffer, 1);
+        SHA1TransformBlocks(context->state, &data[i], (len - i) / 64);
+        i += (len - i) & ~63u;
         j = 0;
     }
     else i = 0;
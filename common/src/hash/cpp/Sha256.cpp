@@ -0,0 +1,179 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+#include "Sha256.h"
+
+#include <string.h>
+
+#include "CpuFeatures.h"
+
+#if HASH_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t Rotr(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t LoadBigEndian32(const unsigned char* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+      (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+void TransformSoftware(uint32_t state[8], const unsigned char* data, size_t blocks) {
+  for (; blocks > 0; blocks--, data += 64) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+      w[i] = LoadBigEndian32(data + 4 * i);
+    }
+    for (int i = 16; i < 64; i++) {
+      uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+      uint32_t t1 = h + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+      uint32_t t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+#if HASH_X86
+
+// The state is kept as ABEF and CDGH vectors, as the sha256rnds2 instruction expects.
+__attribute__((target("sha,sse4.1")))
+void TransformSha(uint32_t state[8], const unsigned char* data, size_t blocks) {
+  const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+  __m128i hgfe = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+  __m128i abef = _mm_alignr_epi8(dcba, hgfe, 8);
+  __m128i cdgh = _mm_blend_epi16(hgfe, dcba, 0xF0);
+
+  for (; blocks > 0; blocks--, data += 64) {
+    __m128i abefSaved = abef;
+    __m128i cdghSaved = cdgh;
+    // Message schedule: four vectors of four consecutive words.
+    __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byteSwap);
+    __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), byteSwap);
+    __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), byteSwap);
+    __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), byteSwap);
+    for (int i = 0; i < 16; i++) {
+      __m128i message = _mm_add_epi32(w0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[4 * i])));
+      cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+      abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0E));
+      __m128i next = _mm_sha256msg1_epu32(w0, w1);
+      next = _mm_add_epi32(next, _mm_alignr_epi8(w3, w2, 4));
+      next = _mm_sha256msg2_epu32(next, w3);
+      w0 = w1;
+      w1 = w2;
+      w2 = w3;
+      w3 = next;
+    }
+    abef = _mm_add_epi32(abef, abefSaved);
+    cdgh = _mm_add_epi32(cdgh, cdghSaved);
+  }
+
+  __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+  __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#endif
+
+using TransformFunction = void (*)(uint32_t*, const unsigned char*, size_t);
+
+// Selected on the first use. Concurrent first uses select the same function, so no synchronization is needed.
+TransformFunction transformImpl = nullptr;
+
+void Transform(uint32_t state[8], const unsigned char* data, size_t blocks) {
+  TransformFunction impl = __atomic_load_n(&transformImpl, __ATOMIC_RELAXED);
+  if (impl == nullptr) {
+    impl = TransformSoftware;
+#if HASH_X86
+    if (hash::HasShaExtensions()) impl = TransformSha;
+#endif
+    __atomic_store_n(&transformImpl, impl, __ATOMIC_RELAXED);
+  }
+  impl(state, data, blocks);
+}
+
+} // namespace
+
+extern "C" {
+
+void SHA256Init(SHA256_CTX* context) {
+  static const uint32_t initial[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+  memcpy(context->state, initial, sizeof(initial));
+  context->count = 0;
+}
+
+void SHA256Update(SHA256_CTX* context, const unsigned char* data, size_t len) {
+  size_t used = context->count & 63;
+  context->count += len;
+  if (used != 0) {
+    size_t chunk = 64 - used < len ? 64 - used : len;
+    memcpy(context->buffer + used, data, chunk);
+    data += chunk;
+    len -= chunk;
+    if (used + chunk < 64) return;
+    Transform(context->state, context->buffer, 1);
+  }
+  if (len >= 64) {
+    Transform(context->state, data, len / 64);
+    data += len & ~static_cast<size_t>(63);
+    len &= 63;
+  }
+  memcpy(context->buffer, data, len);
+}
+
+void SHA256Final(unsigned char digest[32], SHA256_CTX* context) {
+  uint64_t bits = context->count * 8;
+  unsigned char padding[72] = { 0x80 };
+  size_t used = context->count & 63;
+  size_t paddingLength = (used < 56 ? 56 : 120) - used;
+  for (int i = 0; i < 8; i++) {
+    padding[paddingLength + i] = static_cast<unsigned char>(bits >> (56 - 8 * i));
+  }
+  SHA256Update(context, padding, paddingLength + 8);
+  for (int i = 0; i < 32; i++) {
+    digest[i] = static_cast<unsigned char>(context->state[i / 4] >> (24 - 8 * (i % 4)));
+  }
+  memset(context, 0, sizeof(*context));
+}
+
+} // extern "C"
@@ -28,6 +28,10 @@ extern "C" {
 // Hash function for a byte array.
 uint64_t CityHash64(const void* buf, size_t len);
 
+// Hash function for a byte array. For convenience, a 64-bit seed is also
+// hashed into the result.
+uint64_t CityHash64WithSeed(const void* buf, size_t len, uint64_t seed);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+#ifndef COMMON_CPU_FEATURES_H
+#define COMMON_CPU_FEATURES_H
+
+// Run-time detection of the instruction set extensions used by the hash functions and the runtime codecs.
+// Bitcode is built for the baseline of each target, so the accelerated code paths are compiled
+// with function-level target attributes and selected once per process.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HASH_X86 1
+#include <cpuid.h>
+#else
+#define HASH_X86 0
+#endif
+
+namespace hash {
+
+#if HASH_X86
+
+inline bool HasSsse3() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+  return (ecx & bit_SSSE3) != 0;
+}
+
+inline bool HasSse42() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+  return (ecx & bit_SSE4_2) != 0;
+}
+
+inline bool HasShaExtensions() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_SSE4_1) == 0) return false;
+  if (__get_cpuid_max(0, nullptr) < 7) return false;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  // bit_SHA is missing from older cpuid.h.
+  return (ebx & (1u << 29)) != 0;
+}
+
+#else
+
+inline bool HasSsse3() { return false; }
+
+inline bool HasSse42() { return false; }
+
+inline bool HasShaExtensions() { return false; }
+
+#endif
+
+} // namespace hash
+
+#endif // COMMON_CPU_FEATURES_H
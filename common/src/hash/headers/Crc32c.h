@@ -0,0 +1,24 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+#ifndef COMMON_CRC32C_H
+#define COMMON_CRC32C_H
+
+// CRC-32C (Castagnoli), as used by iSCSI, ext4 and many storage formats.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Continues `crc` (0 for an empty input) with `len` bytes of `buf`.
+uint32_t Crc32c(uint32_t crc, const void* buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMON_CRC32C_H
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+#ifndef COMMON_SHA256_H
+#define COMMON_SHA256_H
+
+// SHA-256 (FIPS PUB 180-4), using the SHA extensions of x86 processors when available.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SHA256_CTX {
+    uint32_t state[8];
+    uint64_t count;
+    unsigned char buffer[64];
+} SHA256_CTX;
+
+void SHA256Init(SHA256_CTX* context);
+void SHA256Update(SHA256_CTX* context, const unsigned char* data, size_t len);
+void SHA256Final(unsigned char digest[32], SHA256_CTX* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMON_SHA256_H
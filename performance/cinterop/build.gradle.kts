@@ -28,4 +28,5 @@ native.compilations["main"].cinterops {
     create("macros")
     create("struct")
     create("types")
+    create("memory")
 }
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.memoryBenchmarks
+
+actual class ArenaBenchmark actual constructor() {
+    actual fun memScopedSmallAllocationsBenchmark() {
+        error("Benchmark memScopedSmallAllocationsBenchmark is unsupported on JVM!")
+    }
+
+    actual fun arenaReuseBenchmark() {
+        error("Benchmark arenaReuseBenchmark is unsupported on JVM!")
+    }
+}
+
+actual class PinningBenchmark actual constructor() {
+    actual fun refToBenchmark() {
+        error("Benchmark refToBenchmark is unsupported on JVM!")
+    }
+
+    actual fun usePinnedBenchmark() {
+        error("Benchmark usePinnedBenchmark is unsupported on JVM!")
+    }
+
+    actual fun useScopedPinnedBenchmark() {
+        error("Benchmark useScopedPinnedBenchmark is unsupported on JVM!")
+    }
+}
+
+actual class BulkCopyBenchmark actual constructor() {
+    actual fun floatArrayElementwiseCopyBenchmark() {
+        error("Benchmark floatArrayElementwiseCopyBenchmark is unsupported on JVM!")
+    }
+
+    actual fun floatArrayBulkCopyBenchmark() {
+        error("Benchmark floatArrayBulkCopyBenchmark is unsupported on JVM!")
+    }
+
+    actual fun intArraySwapBytesCopyBenchmark() {
+        error("Benchmark intArraySwapBytesCopyBenchmark is unsupported on JVM!")
+    }
+}
+
+actual class CStringBenchmark actual constructor() {
+    actual fun cstrBenchmark() {
+        error("Benchmark cstrBenchmark is unsupported on JVM!")
+    }
+
+    actual fun useUtf8Benchmark() {
+        error("Benchmark useUtf8Benchmark is unsupported on JVM!")
+    }
+
+    actual fun pinnedUtf16Benchmark() {
+        error("Benchmark pinnedUtf16Benchmark is unsupported on JVM!")
+    }
+}
+
+actual class CallbackBenchmark actual constructor() {
+    actual fun staticCFunctionCallbackBenchmark() {
+        error("Benchmark staticCFunctionCallbackBenchmark is unsupported on JVM!")
+    }
+
+    actual fun stableRefCallbackBenchmark() {
+        error("Benchmark stableRefCallbackBenchmark is unsupported on JVM!")
+    }
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.memoryBenchmarks
+
+import kotlinx.cinterop.*
+
+const val benchmarkSize = 10000
+const val segmentsPerScope = 16
+
+actual class ArenaBenchmark actual constructor() {
+
+    // Typical interop call site: a few small structs and out-parameters per `memScoped` block.
+    actual fun memScopedSmallAllocationsBenchmark() {
+        var total = 0L
+        for (i in 1..benchmarkSize) {
+            memScoped {
+                val manhattan = alloc<LongVar>()
+                for (j in 0 until segmentsPerScope) {
+                    val segment = alloc<Segment>()
+                    segment.start = alloc<Point> { x = i; y = j }.ptr
+                    segment.end = alloc<Point> { x = j; y = i }.ptr
+                    segment.weight = 1.0
+                    total += segmentLength(segment.ptr, manhattan.ptr) + manhattan.value
+                }
+            }
+        }
+        if (total == 0L) error("Unexpected result")
+    }
+
+    // Same allocation pattern, but with a single long-lived arena cleared after each iteration.
+    actual fun arenaReuseBenchmark() {
+        var total = 0L
+        val arena = Arena()
+        try {
+            for (i in 1..benchmarkSize) {
+                val manhattan = arena.alloc<LongVar>()
+                for (j in 0 until segmentsPerScope) {
+                    val segment = arena.alloc<Segment>()
+                    segment.start = arena.alloc<Point> { x = i; y = j }.ptr
+                    segment.end = arena.alloc<Point> { x = j; y = i }.ptr
+                    segment.weight = 1.0
+                    total += segmentLength(segment.ptr, manhattan.ptr) + manhattan.value
+                }
+                arena.clear()
+            }
+        } finally {
+            arena.clear()
+        }
+        if (total == 0L) error("Unexpected result")
+    }
+}
+
+// Short buffers, so that the cost of passing the array to C dominates.
+actual class PinningBenchmark actual constructor() {
+    val buffer = ByteArray(16) { it.toByte() }
+
+    actual fun refToBenchmark() {
+        var total = 0
+        for (i in 1..benchmarkSize) {
+            total += byteChecksum(buffer.refTo(0), buffer.size.convert())
+        }
+        if (total == 0) error("Unexpected result")
+    }
+
+    actual fun usePinnedBenchmark() {
+        var total = 0
+        for (i in 1..benchmarkSize) {
+            total += buffer.usePinned { byteChecksum(it.addressOf(0), buffer.size.convert()) }
+        }
+        if (total == 0) error("Unexpected result")
+    }
+
+    actual fun useScopedPinnedBenchmark() {
+        var total = 0
+        for (i in 1..benchmarkSize) {
+            total += buffer.useScopedPinned { byteChecksum(it.addressOf(0), buffer.size.convert()) }
+        }
+        if (total == 0) error("Unexpected result")
+    }
+}
+
+// Copies a C buffer into a Kotlin array and back.
+actual class BulkCopyBenchmark actual constructor() {
+    val size = 4096
+    val floats = FloatArray(size)
+    val ints = IntArray(size)
+    val floatBuffer = nativeHeap.allocArray<FloatVar>(size) { value = it.toFloat() }
+    val intBuffer = nativeHeap.allocArray<IntVar>(size) { value = it }
+
+    actual fun floatArrayElementwiseCopyBenchmark() {
+        for (i in 1..benchmarkSize / 100) {
+            for (index in 0 until size) {
+                floats[index] = floatBuffer[index]
+            }
+            for (index in 0 until size) {
+                floatBuffer[index] = floats[index]
+            }
+        }
+    }
+
+    actual fun floatArrayBulkCopyBenchmark() {
+        for (i in 1..benchmarkSize / 100) {
+            floatBuffer.copyFromNative(floats)
+            floats.copyToNative(floatBuffer)
+        }
+    }
+
+    actual fun intArraySwapBytesCopyBenchmark() {
+        for (i in 1..benchmarkSize / 100) {
+            intBuffer.copyFromNative(ints, swapBytes = true)
+            ints.copyToNative(intBuffer, swapBytes = true)
+        }
+    }
+}
+
+actual class CStringBenchmark actual constructor() {
+    val string = "Lorem ipsum dolor sit amet, привет мир"
+
+    actual fun cstrBenchmark() {
+        var total = 0L
+        for (i in 1..benchmarkSize) {
+            total += countSpacesInCString(string).toLong()
+        }
+        if (total == 0L) error("Unexpected result")
+    }
+
+    actual fun useUtf8Benchmark() {
+        var total = 0L
+        for (i in 1..benchmarkSize) {
+            total += string.useUtf8 { bytes, size -> countSpaces(bytes, size.convert()) }.toLong()
+        }
+        if (total == 0L) error("Unexpected result")
+    }
+
+    actual fun pinnedUtf16Benchmark() {
+        var total = 0L
+        for (i in 1..benchmarkSize) {
+            total += string.useScopedPinned { countSpacesUtf16(it.addressOf(0), string.length.convert()) }.toLong()
+        }
+        if (total == 0L) error("Unexpected result")
+    }
+}
+
+class CallbackCounter(val step: Long) {
+    var total = 0L
+}
+
+actual class CallbackBenchmark actual constructor() {
+    // Event-loop style: C code calls back into Kotlin once per event, each callback entering the runtime.
+    actual fun staticCFunctionCallbackBenchmark() {
+        val callback = staticCFunction { _: COpaquePointer?, value: Int ->
+            initRuntimeIfNeeded()
+            value.toLong()
+        }
+        val total = invokeCallback(callback, null, benchmarkSize * 10)
+        if (total == 0L) error("Unexpected result")
+    }
+
+    actual fun stableRefCallbackBenchmark() {
+        val callback = staticCFunction { context: COpaquePointer?, value: Int ->
+            initRuntimeIfNeeded()
+            val counter = context!!.asStableRef<CallbackCounter>().get()
+            counter.total += counter.step
+            value.toLong()
+        }
+        val counter = CallbackCounter(2)
+        val stableRef = StableRef.create(counter)
+        try {
+            invokeCallback(callback, stableRef.asCPointer(), benchmarkSize * 10)
+        } finally {
+            stableRef.dispose()
+        }
+        if (counter.total == 0L) error("Unexpected result")
+    }
+}
@@ -19,6 +19,7 @@ import org.jetbrains.structsProducedByMacrosBenchmarks.*
 import org.jetbrains.benchmarksLauncher.*
 import org.jetbrains.structsBenchmarks.*
 import org.jetbrains.typesBenchmarks.*
+import org.jetbrains.memoryBenchmarks.*
 import kotlinx.cli.*
 
 class CinteropLauncher : Launcher() {
@@ -32,7 +33,20 @@ class CinteropLauncher : Launcher() {
                     "stringToKotlin" to BenchmarkEntryWithInit.create(::StringBenchmark, { stringToKotlinBenchmark() }),
                     "intMatrix" to BenchmarkEntryWithInit.create(::IntMatrixBenchmark, { intMatrixBenchmark() }),
                     "int" to BenchmarkEntryWithInit.create(::IntBenchmark, { intBenchmark() }),
-                    "boxedInt" to BenchmarkEntryWithInit.create(::BoxedIntBenchmark, { boxedIntBenchmark() })
+                    "boxedInt" to BenchmarkEntryWithInit.create(::BoxedIntBenchmark, { boxedIntBenchmark() }),
+                    "memScopedSmallAllocations" to BenchmarkEntryWithInit.create(::ArenaBenchmark, { memScopedSmallAllocationsBenchmark() }),
+                    "arenaReuse" to BenchmarkEntryWithInit.create(::ArenaBenchmark, { arenaReuseBenchmark() }),
+                    "refTo" to BenchmarkEntryWithInit.create(::PinningBenchmark, { refToBenchmark() }),
+                    "usePinned" to BenchmarkEntryWithInit.create(::PinningBenchmark, { usePinnedBenchmark() }),
+                    "useScopedPinned" to BenchmarkEntryWithInit.create(::PinningBenchmark, { useScopedPinnedBenchmark() }),
+                    "floatArrayElementwiseCopy" to BenchmarkEntryWithInit.create(::BulkCopyBenchmark, { floatArrayElementwiseCopyBenchmark() }),
+                    "floatArrayBulkCopy" to BenchmarkEntryWithInit.create(::BulkCopyBenchmark, { floatArrayBulkCopyBenchmark() }),
+                    "intArraySwapBytesCopy" to BenchmarkEntryWithInit.create(::BulkCopyBenchmark, { intArraySwapBytesCopyBenchmark() }),
+                    "cstr" to BenchmarkEntryWithInit.create(::CStringBenchmark, { cstrBenchmark() }),
+                    "useUtf8" to BenchmarkEntryWithInit.create(::CStringBenchmark, { useUtf8Benchmark() }),
+                    "pinnedUtf16" to BenchmarkEntryWithInit.create(::CStringBenchmark, { pinnedUtf16Benchmark() }),
+                    "staticCFunctionCallback" to BenchmarkEntryWithInit.create(::CallbackBenchmark, { staticCFunctionCallbackBenchmark() }),
+                    "stableRefCallback" to BenchmarkEntryWithInit.create(::CallbackBenchmark, { stableRefCallbackBenchmark() })
             )
     )
 }
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.memoryBenchmarks
+
+expect class ArenaBenchmark() {
+    fun memScopedSmallAllocationsBenchmark()
+    fun arenaReuseBenchmark()
+}
+
+expect class PinningBenchmark() {
+    fun refToBenchmark()
+    fun usePinnedBenchmark()
+    fun useScopedPinnedBenchmark()
+}
+
+expect class BulkCopyBenchmark() {
+    fun floatArrayElementwiseCopyBenchmark()
+    fun floatArrayBulkCopyBenchmark()
+    fun intArraySwapBytesCopyBenchmark()
+}
+
+expect class CStringBenchmark() {
+    fun cstrBenchmark()
+    fun useUtf8Benchmark()
+    fun pinnedUtf16Benchmark()
+}
+
+expect class CallbackBenchmark() {
+    fun staticCFunctionCallbackBenchmark()
+    fun stableRefCallbackBenchmark()
+}
@@ -8,7 +8,17 @@ import org.jetbrains.benchmarksLauncher.*
 actual class NumericalLauncher : Launcher() {
     override val benchmarks = BenchmarksCollection(
             mutableMapOf(
-                    "BellardPi" to BenchmarkEntry(::jvmBellardPi)
+                    "BellardPi" to BenchmarkEntry(::jvmBellardPi),
+                    "ScalarSaxpy" to BenchmarkEntry(::jvmScalarSaxpy),
+                    "ScalarDot" to BenchmarkEntry(::jvmScalarDot),
+                    "ScalarMaxInt" to BenchmarkEntry(::jvmScalarMaxInt),
+                    "ScalarSin" to BenchmarkEntry(::jvmScalarSin),
+                    "ScalarExp" to BenchmarkEntry(::jvmScalarExp),
+                    "ScalarLn" to BenchmarkEntry(::jvmScalarLn),
+                    "ScalarSum" to BenchmarkEntry(::jvmScalarSum),
+                    "ScalarKahanSum" to BenchmarkEntry(::jvmScalarKahanSum),
+                    "ScalarIntSum" to BenchmarkEntry(::jvmScalarIntSum),
+                    "ScalarDoubleDot" to BenchmarkEntry(::jvmScalarDoubleDot)
             )
     )
 }
@@ -19,3 +29,61 @@ fun jvmBellardPi() {
         Blackhole.consume(result)
     }
 }
+
+fun jvmScalarSaxpy() {
+    val y = vectorY.copyOf()
+    for (i in 1 .. VECTOR_ITERATIONS)
+        scalarSaxpy(0.5f, vectorX, y)
+    Blackhole.consume(y)
+}
+
+fun jvmScalarDot() {
+    for (i in 1 .. VECTOR_ITERATIONS)
+        Blackhole.consume(scalarDot(vectorX, vectorY))
+}
+
+fun jvmScalarMaxInt() {
+    for (i in 1 .. VECTOR_ITERATIONS)
+        Blackhole.consume(scalarMaxInt(vectorInts))
+}
+
+fun jvmScalarSin() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        scalarSin(mathAngles, result)
+    Blackhole.consume(result)
+}
+
+fun jvmScalarExp() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        scalarExp(mathAngles, result)
+    Blackhole.consume(result)
+}
+
+fun jvmScalarLn() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        scalarLn(mathPositives, result)
+    Blackhole.consume(result)
+}
+
+fun jvmScalarSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(scalarSum(reductionDoubles))
+}
+
+fun jvmScalarKahanSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(scalarKahanSum(reductionDoubles))
+}
+
+fun jvmScalarIntSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(scalarIntSum(reductionInts))
+}
+
+fun jvmScalarDoubleDot() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(scalarDoubleDot(reductionDoubles, reductionDoubles))
+}
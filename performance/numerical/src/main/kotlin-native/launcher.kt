@@ -4,12 +4,35 @@
  */
 
 import org.jetbrains.benchmarksLauncher.*
+import kotlin.math.*
 
 actual class NumericalLauncher : Launcher() {
     override val benchmarks = BenchmarksCollection(
             mutableMapOf(
                     "BellardPi" to BenchmarkEntry(::konanBellardPi),
-                    "BellardPiCinterop" to BenchmarkEntry(::clangBellardPi)
+                    "BellardPiCinterop" to BenchmarkEntry(::clangBellardPi),
+                    "ScalarSaxpy" to BenchmarkEntry(::konanScalarSaxpy),
+                    "SimdSaxpy" to BenchmarkEntry(::konanSimdSaxpy),
+                    "ScalarDot" to BenchmarkEntry(::konanScalarDot),
+                    "SimdDot" to BenchmarkEntry(::konanSimdDot),
+                    "ScalarMaxInt" to BenchmarkEntry(::konanScalarMaxInt),
+                    "SimdMaxInt" to BenchmarkEntry(::konanSimdMaxInt),
+                    "ScalarSin" to BenchmarkEntry(::konanScalarSin),
+                    "VectorSin" to BenchmarkEntry(::konanVectorSin),
+                    "ScalarExp" to BenchmarkEntry(::konanScalarExp),
+                    "VectorExp" to BenchmarkEntry(::konanVectorExp),
+                    "ScalarLn" to BenchmarkEntry(::konanScalarLn),
+                    "VectorLn" to BenchmarkEntry(::konanVectorLn),
+                    "VectorDot" to BenchmarkEntry(::konanVectorDot),
+                    "ScalarSum" to BenchmarkEntry(::konanScalarSum),
+                    "VectorSum" to BenchmarkEntry(::konanVectorSum),
+                    "VectorPairwiseSum" to BenchmarkEntry(::konanVectorPairwiseSum),
+                    "ScalarKahanSum" to BenchmarkEntry(::konanScalarKahanSum),
+                    "VectorKahanSum" to BenchmarkEntry(::konanVectorKahanSum),
+                    "ScalarIntSum" to BenchmarkEntry(::konanScalarIntSum),
+                    "VectorIntSum" to BenchmarkEntry(::konanVectorIntSum),
+                    "ScalarDoubleDot" to BenchmarkEntry(::konanScalarDoubleDot),
+                    "VectorDoubleDot" to BenchmarkEntry(::konanVectorDoubleDot)
             )
     )
 }
@@ -25,3 +48,129 @@ fun clangBellardPi() {
     for (n in 1 .. 1000 step 9)
             cinterop.pi_nth_digit(n)
 }
+
+fun konanScalarSaxpy() {
+    val y = vectorY.copyOf()
+    for (i in 1 .. VECTOR_ITERATIONS)
+        scalarSaxpy(0.5f, vectorX, y)
+    Blackhole.consume(y)
+}
+
+fun konanSimdSaxpy() {
+    val y = vectorY.copyOf()
+    for (i in 1 .. VECTOR_ITERATIONS)
+        simdSaxpy(0.5f, vectorX, y)
+    Blackhole.consume(y)
+}
+
+fun konanScalarDot() {
+    for (i in 1 .. VECTOR_ITERATIONS)
+        Blackhole.consume(scalarDot(vectorX, vectorY))
+}
+
+fun konanSimdDot() {
+    for (i in 1 .. VECTOR_ITERATIONS)
+        Blackhole.consume(simdDot(vectorX, vectorY))
+}
+
+fun konanScalarMaxInt() {
+    for (i in 1 .. VECTOR_ITERATIONS)
+        Blackhole.consume(scalarMaxInt(vectorInts))
+}
+
+fun konanSimdMaxInt() {
+    for (i in 1 .. VECTOR_ITERATIONS)
+        Blackhole.consume(simdMaxInt(vectorInts))
+}
+
+fun konanScalarSin() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        scalarSin(mathAngles, result)
+    Blackhole.consume(result)
+}
+
+fun konanVectorSin() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        mathAngles.sinInto(result)
+    Blackhole.consume(result)
+}
+
+fun konanScalarExp() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        scalarExp(mathAngles, result)
+    Blackhole.consume(result)
+}
+
+fun konanVectorExp() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        mathAngles.expInto(result)
+    Blackhole.consume(result)
+}
+
+fun konanScalarLn() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        scalarLn(mathPositives, result)
+    Blackhole.consume(result)
+}
+
+fun konanVectorLn() {
+    val result = DoubleArray(MATH_ARRAY_SIZE)
+    for (i in 1 .. MATH_ITERATIONS)
+        mathPositives.lnInto(result)
+    Blackhole.consume(result)
+}
+
+fun konanVectorDot() {
+    for (i in 1 .. VECTOR_ITERATIONS)
+        Blackhole.consume(vectorX.dot(vectorY))
+}
+
+fun konanScalarSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(scalarSum(reductionDoubles))
+}
+
+fun konanVectorSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(reductionDoubles.sum(Summation.FAST))
+}
+
+fun konanVectorPairwiseSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(reductionDoubles.sum(Summation.PAIRWISE))
+}
+
+fun konanScalarKahanSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(scalarKahanSum(reductionDoubles))
+}
+
+fun konanVectorKahanSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(reductionDoubles.sum(Summation.KAHAN))
+}
+
+fun konanScalarIntSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(scalarIntSum(reductionInts))
+}
+
+fun konanVectorIntSum() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(reductionInts.sum(0, REDUCTION_SIZE))
+}
+
+fun konanScalarDoubleDot() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(scalarDoubleDot(reductionDoubles, reductionDoubles))
+}
+
+fun konanVectorDoubleDot() {
+    for (i in 1 .. REDUCTION_ITERATIONS)
+        Blackhole.consume(reductionDoubles.dot(reductionDoubles))
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+// The loops from vectors.kt, processing four lanes per step with Vector128.
+
+fun simdSaxpy(a: Float, x: FloatArray, y: FloatArray) {
+    val factor = vectorOf(a, a, a, a)
+    var i = 0
+    while (i + 4 <= x.size) {
+        y.setVector128At(i, x.getVector128At(i).fmaFloat(factor, y.getVector128At(i)))
+        i += 4
+    }
+    while (i < x.size) {
+        y[i] = a * x[i] + y[i]
+        i++
+    }
+}
+
+fun simdDot(x: FloatArray, y: FloatArray): Float {
+    var sums = vectorOf(0f, 0f, 0f, 0f)
+    var i = 0
+    while (i + 4 <= x.size) {
+        sums = x.getVector128At(i).fmaFloat(y.getVector128At(i), sums)
+        i += 4
+    }
+    sums = sums.plusFloat(sums.shuffle(2, 3, 0, 1))
+    sums = sums.plusFloat(sums.shuffle(1, 0, 3, 2))
+    var sum = sums.getFloatAt(0)
+    while (i < x.size) {
+        sum += x[i] * y[i]
+        i++
+    }
+    return sum
+}
+
+fun simdMaxInt(values: IntArray): Int {
+    var maxes = vectorOf(Int.MIN_VALUE, Int.MIN_VALUE, Int.MIN_VALUE, Int.MIN_VALUE)
+    var i = 0
+    while (i + 4 <= values.size) {
+        maxes = maxes.maxInt(values.getVector128At(i))
+        i += 4
+    }
+    maxes = maxes.maxInt(maxes.shuffle(2, 3, 0, 1))
+    maxes = maxes.maxInt(maxes.shuffle(1, 0, 3, 2))
+    var max = maxes.getIntAt(0)
+    while (i < values.size) {
+        if (values[i] > max) max = values[i]
+        i++
+    }
+    return max
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+import kotlin.math.*
+
+// Element-by-element loops the array math benchmarks are compared against.
+
+const val MATH_ARRAY_SIZE = 4096
+const val MATH_ITERATIONS = 100
+
+val mathAngles = DoubleArray(MATH_ARRAY_SIZE) { (it - MATH_ARRAY_SIZE / 2) * 0.01 }
+val mathPositives = DoubleArray(MATH_ARRAY_SIZE) { 0.001 + it * 0.37 }
+
+fun scalarSin(values: DoubleArray, destination: DoubleArray) {
+    for (i in values.indices) {
+        destination[i] = sin(values[i])
+    }
+}
+
+fun scalarExp(values: DoubleArray, destination: DoubleArray) {
+    for (i in values.indices) {
+        destination[i] = exp(values[i])
+    }
+}
+
+fun scalarLn(values: DoubleArray, destination: DoubleArray) {
+    for (i in values.indices) {
+        destination[i] = ln(values[i])
+    }
+}
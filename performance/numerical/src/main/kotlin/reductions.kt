@@ -0,0 +1,50 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+// Element-by-element loops the array reduction benchmarks are compared against.
+// Every benchmark processes REDUCTION_SIZE * REDUCTION_ITERATIONS elements, so the time per element is
+// the reported time divided by that.
+
+const val REDUCTION_SIZE = 65536
+const val REDUCTION_ITERATIONS = 20
+
+val reductionDoubles = DoubleArray(REDUCTION_SIZE) { (it % 1001) * 0.001 - 0.3 }
+val reductionInts = IntArray(REDUCTION_SIZE) { (it * 2654435761L).toInt() }
+
+fun scalarSum(values: DoubleArray): Double {
+    var sum = 0.0
+    for (value in values) {
+        sum += value
+    }
+    return sum
+}
+
+fun scalarKahanSum(values: DoubleArray): Double {
+    var sum = 0.0
+    var compensation = 0.0
+    for (value in values) {
+        val y = value - compensation
+        val t = sum + y
+        compensation = (t - sum) - y
+        sum = t
+    }
+    return sum
+}
+
+fun scalarIntSum(values: IntArray): Int {
+    var sum = 0
+    for (value in values) {
+        sum += value
+    }
+    return sum
+}
+
+fun scalarDoubleDot(x: DoubleArray, y: DoubleArray): Double {
+    var sum = 0.0
+    for (i in x.indices) {
+        sum += x[i] * y[i]
+    }
+    return sum
+}
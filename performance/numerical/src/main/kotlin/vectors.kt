@@ -0,0 +1,35 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+// Element-by-element loops the Vector128 benchmarks are compared against.
+
+const val VECTOR_SIZE = 4096
+const val VECTOR_ITERATIONS = 100
+
+val vectorX = FloatArray(VECTOR_SIZE) { (it % 17).toFloat() * 0.25f }
+val vectorY = FloatArray(VECTOR_SIZE) { (it % 13).toFloat() - 6f }
+val vectorInts = IntArray(VECTOR_SIZE) { (it * 2654435761L).toInt() }
+
+fun scalarSaxpy(a: Float, x: FloatArray, y: FloatArray) {
+    for (i in x.indices) {
+        y[i] = a * x[i] + y[i]
+    }
+}
+
+fun scalarDot(x: FloatArray, y: FloatArray): Float {
+    var sum = 0f
+    for (i in x.indices) {
+        sum += x[i] * y[i]
+    }
+    return sum
+}
+
+fun scalarMaxInt(values: IntArray): Int {
+    var max = Int.MIN_VALUE
+    for (value in values) {
+        if (value > max) max = value
+    }
+    return max
+}
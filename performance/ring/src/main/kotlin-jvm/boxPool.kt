@@ -0,0 +1,3 @@
+package org.jetbrains.ring
+
+actual fun setBoxPoolCapacity(capacity: Int) { }
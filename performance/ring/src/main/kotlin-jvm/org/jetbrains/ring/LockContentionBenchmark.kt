@@ -0,0 +1,43 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import java.util.concurrent.Callable
+import java.util.concurrent.Executors
+import java.util.concurrent.Semaphore
+import java.util.concurrent.atomic.AtomicInteger
+import java.util.concurrent.locks.ReentrantLock
+import kotlin.concurrent.withLock
+
+actual class LockContentionBenchmark actual constructor() {
+    private val lock = ReentrantLock()
+    private val semaphore = Semaphore(CONTENTION_PERMITS)
+    private val counter = AtomicInteger(0)
+    // Started once, same as workers on Kotlin/Native. Daemon threads don't keep the process alive.
+    private val threads = Executors.newFixedThreadPool(CONTENTION_THREADS) { task ->
+        Thread(task).apply { isDaemon = true }
+    }
+
+    private fun runThreads(block: () -> Unit) {
+        threads.invokeAll(List(CONTENTION_THREADS) { Callable { block() } }).forEach { it.get() }
+    }
+
+    actual fun lockOversubscribed() = runThreads {
+        repeat(CONTENTION_ITERATIONS) {
+            lock.withLock {
+                counter.set(counter.get() + 1)
+            }
+        }
+    }
+
+    actual fun semaphoreOversubscribed() = runThreads {
+        repeat(CONTENTION_ITERATIONS) {
+            semaphore.acquire()
+            counter.incrementAndGet()
+            semaphore.release()
+        }
+    }
+}
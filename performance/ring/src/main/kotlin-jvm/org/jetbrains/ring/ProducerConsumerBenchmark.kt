@@ -0,0 +1,29 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import java.util.concurrent.Executors
+import org.jetbrains.benchmarksLauncher.Blackhole
+
+actual class ProducerConsumerBenchmark actual constructor() {
+    actual fun transferredItems() {
+        val producer = Executors.newSingleThreadExecutor()
+        val consumer = Executors.newSingleThreadExecutor()
+        val future = producer.submit<Int> {
+            val futures = List(PRODUCER_CONSUMER_BATCHES) {
+                val items = produceItems()
+                consumer.submit<Int> { consumeItems(items) }
+            }
+            futures.sumBy { it.get() }
+        }
+        Blackhole.consume(future.get())
+        producer.shutdown()
+        consumer.shutdown()
+    }
+
+    // There is no freezing on JVM.
+    actual fun frozenItems() = transferredItems()
+}
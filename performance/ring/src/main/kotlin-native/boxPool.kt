@@ -0,0 +1,5 @@
+package org.jetbrains.ring
+
+import kotlin.native.internal.GC
+
+actual fun setBoxPoolCapacity(capacity: Int) { GC.boxPoolCapacity = capacity }
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import kotlin.native.concurrent.*
+
+actual class LockContentionBenchmark actual constructor() {
+    private val lock = Lock()
+    private val semaphore = Semaphore(CONTENTION_PERMITS)
+    private val counter = AtomicInt(0)
+    // Started once, so that iterations measure contention rather than thread creation. Idle workers
+    // are blocked waiting for jobs and are left to the process exit.
+    private val workers = Array(CONTENTION_THREADS) { Worker.start() }
+
+    actual fun lockOversubscribed() {
+        val futures = workers.map {
+            it.execute(TransferMode.SAFE, { Pair(lock, counter) }) { (lock, counter) ->
+                repeat(CONTENTION_ITERATIONS) {
+                    lock.withLock {
+                        counter.value = counter.value + 1
+                    }
+                }
+            }
+        }
+        futures.forEach { it.result }
+    }
+
+    actual fun semaphoreOversubscribed() {
+        val futures = workers.map {
+            it.execute(TransferMode.SAFE, { Pair(semaphore, counter) }) { (semaphore, counter) ->
+                repeat(CONTENTION_ITERATIONS) {
+                    semaphore.acquire()
+                    counter.increment()
+                    semaphore.release()
+                }
+            }
+        }
+        futures.forEach { it.result }
+    }
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import kotlin.native.concurrent.*
+import org.jetbrains.benchmarksLauncher.Blackhole
+
+actual class ProducerConsumerBenchmark actual constructor() {
+    private fun produceAndConsume(produce: () -> ProducerConsumerItem?) {
+        val producer = Worker.start()
+        val consumer = Worker.start()
+        val future = producer.execute(TransferMode.SAFE, { Pair(consumer, produce.freeze()) }) { (consumer, produce) ->
+            val futures = List(PRODUCER_CONSUMER_BATCHES) {
+                consumer.execute(TransferMode.SAFE, { produce() }) { consumeItems(it) }
+            }
+            futures.sumBy { it.result }
+        }
+        Blackhole.consume(future.result)
+        producer.requestTermination().result
+        consumer.requestTermination().result
+    }
+
+    actual fun transferredItems() = produceAndConsume { produceItems() }
+
+    actual fun frozenItems() = produceAndConsume { produceItems().freeze() }
+}
@@ -0,0 +1,3 @@
+package org.jetbrains.ring
+
+expect fun setBoxPoolCapacity(capacity: Int)
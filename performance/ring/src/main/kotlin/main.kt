@@ -22,10 +22,17 @@ import kotlinx.cli.*
 
 class RingLauncher : Launcher() {
 
+    override val cpuTimeBenchmarks = setOf("LockContention.lockOversubscribed", "LockContention.semaphoreOversubscribed")
+
     override val benchmarks = BenchmarksCollection(
             mutableMapOf(
                     "AbstractMethod.sortStrings" to BenchmarkEntryWithInit.create(::AbstractMethodBenchmark, { sortStrings() }),
                     "AbstractMethod.sortStringsWithComparator" to BenchmarkEntryWithInit.create(::AbstractMethodBenchmark, { sortStringsWithComparator() }),
+                    "Boxing.hashMapPut" to BenchmarkEntryWithInit.create(::BoxingBenchmark, { hashMapPut() }),
+                    "Boxing.hashMapPutPooled" to BenchmarkEntryWithInit.create(::BoxingBenchmark, { hashMapPutPooled() }),
+                    "Boxing.hashMapCount" to BenchmarkEntryWithInit.create(::BoxingBenchmark, { hashMapCount() }),
+                    "Boxing.hashMapCountPooled" to BenchmarkEntryWithInit.create(::BoxingBenchmark, { hashMapCountPooled() }),
+                    "Boxing.doubleList" to BenchmarkEntryWithInit.create(::BoxingBenchmark, { doubleList() }),
                     "ClassArray.copy" to BenchmarkEntryWithInit.create(::ClassArrayBenchmark, { copy() }),
                     "ClassArray.copyManual" to BenchmarkEntryWithInit.create(::ClassArrayBenchmark, { copyManual() }),
                     "ClassArray.filterAndCount" to BenchmarkEntryWithInit.create(::ClassArrayBenchmark, { filterAndCount() }),
@@ -70,6 +77,9 @@ class RingLauncher : Launcher() {
                     "ClassStream.countFiltered" to BenchmarkEntryWithInit.create(::ClassStreamBenchmark, { countFiltered() }),
                     "ClassStream.reduce" to BenchmarkEntryWithInit.create(::ClassStreamBenchmark, { reduce() }),
                     "CompanionObject.invokeRegularFunction" to BenchmarkEntryWithInit.create(::CompanionObjectBenchmark, { invokeRegularFunction() }),
+                    "CyclicGarbage.doublyLinkedList" to BenchmarkEntryWithInit.create(::CyclicGarbageBenchmark, { doublyLinkedList() }),
+                    "CyclicGarbage.smallLoops" to BenchmarkEntryWithInit.create(::CyclicGarbageBenchmark, { smallLoops() }),
+                    "CyclicGarbage.randomGraph" to BenchmarkEntryWithInit.create(::CyclicGarbageBenchmark, { randomGraph() }),
                     "DefaultArgument.testOneOfTwo" to BenchmarkEntryWithInit.create(::DefaultArgumentBenchmark, { testOneOfTwo() }),
                     "DefaultArgument.testTwoOfTwo" to BenchmarkEntryWithInit.create(::DefaultArgumentBenchmark, { testTwoOfTwo() }),
                     "DefaultArgument.testOneOfFour" to BenchmarkEntryWithInit.create(::DefaultArgumentBenchmark, { testOneOfFour() }),
@@ -158,6 +168,8 @@ class RingLauncher : Launcher() {
                     "Lambda.mutatingLambdaNoInline" to BenchmarkEntryWithInit.create(::LambdaBenchmark, { mutatingLambdaNoInline() }),
                     "Lambda.methodReference" to BenchmarkEntryWithInit.create(::LambdaBenchmark, { methodReference() }),
                     "Lambda.methodReferenceNoInline" to BenchmarkEntryWithInit.create(::LambdaBenchmark, { methodReferenceNoInline() }),
+                    "LockContention.lockOversubscribed" to BenchmarkEntryWithInit.create(::LockContentionBenchmark, { lockOversubscribed() }),
+                    "LockContention.semaphoreOversubscribed" to BenchmarkEntryWithInit.create(::LockContentionBenchmark, { semaphoreOversubscribed() }),
                     "Loop.arrayLoop" to BenchmarkEntryWithInit.create(::LoopBenchmark, { arrayLoop() }),
                     "Loop.arrayIndexLoop" to BenchmarkEntryWithInit.create(::LoopBenchmark, { arrayIndexLoop() }),
                     "Loop.rangeLoop" to BenchmarkEntryWithInit.create(::LoopBenchmark, { rangeLoop() }),
@@ -172,6 +184,8 @@ class RingLauncher : Launcher() {
                     "ParameterNotNull.invokeTwoArgsWithoutNullCheck" to BenchmarkEntryWithInit.create(::ParameterNotNullAssertionBenchmark, { invokeTwoArgsWithoutNullCheck() }),
                     "ParameterNotNull.invokeEightArgsWithNullCheck" to BenchmarkEntryWithInit.create(::ParameterNotNullAssertionBenchmark, { invokeEightArgsWithNullCheck() }),
                     "ParameterNotNull.invokeEightArgsWithoutNullCheck" to BenchmarkEntryWithInit.create(::ParameterNotNullAssertionBenchmark, { invokeEightArgsWithoutNullCheck() }),
+                    "ProducerConsumer.transferredItems" to BenchmarkEntryWithInit.create(::ProducerConsumerBenchmark, { transferredItems() }),
+                    "ProducerConsumer.frozenItems" to BenchmarkEntryWithInit.create(::ProducerConsumerBenchmark, { frozenItems() }),
                     "PrimeList.calcDirect" to BenchmarkEntryWithInit.create(::PrimeListBenchmark, { calcDirect() }),
                     "PrimeList.calcEratosthenes" to BenchmarkEntryWithInit.create(::PrimeListBenchmark, { calcEratosthenes() }),
                     "String.stringConcat" to BenchmarkEntryWithInit.create(::StringBenchmark, { stringConcat() }),
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jetbrains.ring
+
+import org.jetbrains.benchmarksLauncher.Blackhole
+
+// Keys and values are mostly outside of the default box caches.
+open class BoxingBenchmark {
+    private val keys = IntArray(BENCHMARK_SIZE) { (it * 7919) % (BENCHMARK_SIZE / 4) + 1000 }
+
+    private fun fillMap(): HashMap<Int, Int> {
+        val map = HashMap<Int, Int>()
+        for (i in 0 until BENCHMARK_SIZE) {
+            map[i + 1000] = i
+        }
+        return map
+    }
+
+    private fun countKeys(): HashMap<Int, Int> {
+        val map = HashMap<Int, Int>()
+        for (key in keys) {
+            map[key] = (map[key] ?: 0) + 1
+        }
+        return map
+    }
+
+    private fun <T> withBoxPool(block: () -> T): T {
+        setBoxPoolCapacity(1024)
+        try {
+            return block()
+        } finally {
+            setBoxPoolCapacity(0)
+        }
+    }
+
+    //Benchmark
+    fun hashMapPut() {
+        Blackhole.consume(fillMap())
+    }
+
+    //Benchmark
+    fun hashMapPutPooled() {
+        Blackhole.consume(withBoxPool { fillMap() })
+    }
+
+    //Benchmark
+    fun hashMapCount() {
+        Blackhole.consume(countKeys())
+    }
+
+    //Benchmark
+    fun hashMapCountPooled() {
+        Blackhole.consume(withBoxPool { countKeys() })
+    }
+
+    //Benchmark
+    fun doubleList() {
+        val list = ArrayList<Double>(BENCHMARK_SIZE)
+        for (i in 0 until BENCHMARK_SIZE) {
+            list.add((i % 100).toDouble())
+        }
+        Blackhole.consume(list.sum())
+    }
+}
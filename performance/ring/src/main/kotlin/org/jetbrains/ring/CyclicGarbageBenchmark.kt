@@ -0,0 +1,75 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jetbrains.ring
+
+import org.jetbrains.benchmarksLauncher.Blackhole
+import org.jetbrains.benchmarksLauncher.getEnv
+import kotlin.random.Random
+
+// Nodes in randomGraph(), taken from RING_RANDOM_GRAPH_NODES environment variable. The default graph is
+// a few MB. Millions of nodes make it hundreds of MB, which is where huge pages start to matter.
+val RANDOM_GRAPH_NODES = getEnv("RING_RANDOM_GRAPH_NODES")?.toIntOrNull() ?: BENCHMARK_SIZE * 10
+
+// Every iteration leaves BENCHMARK_SIZE nodes of cyclic garbage behind, so memory keeps growing
+// from iteration to iteration unless the memory manager collects cycles.
+open class CyclicGarbageBenchmark {
+    class Node(val value: Int) {
+        var next: Node? = null
+        var previous: Node? = null
+    }
+
+    //Benchmark
+    fun doublyLinkedList() {
+        val head = Node(0)
+        var tail = head
+        for (i in 1 until BENCHMARK_SIZE) {
+            val node = Node(i)
+            node.previous = tail
+            tail.next = node
+            tail = node
+        }
+        Blackhole.consume(tail.previous!!.value)
+    }
+
+    //Benchmark
+    fun smallLoops() {
+        var sum = 0
+        for (i in 0 until BENCHMARK_SIZE / 4) {
+            val first = Node(i)
+            val last = Node(i + 1)
+            first.next = last
+            last.next = first
+            sum += last.next!!.value
+        }
+        Blackhole.consume(sum)
+    }
+
+    // Links nodes at random, so that collecting the graph jumps all over the heap. Compare runs with
+    // and without KOTLIN_NATIVE_HUGE_PAGES to see how much of the collection time goes to TLB misses,
+    // with RANDOM_GRAPH_NODES large enough for the graph to exceed the TLB reach.
+    //Benchmark
+    fun randomGraph() {
+        val random = Random(42)
+        val nodes = Array(RANDOM_GRAPH_NODES) { Node(it) }
+        for (node in nodes) {
+            node.next = nodes[random.nextInt(nodes.size)]
+            node.previous = nodes[random.nextInt(nodes.size)]
+        }
+        Blackhole.consume(nodes[random.nextInt(nodes.size)].next!!.value)
+        cleanup()
+    }
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+// More threads than cores on the usual benchmarking machines, so that lock holders get preempted
+// and waiters have to be blocked instead of spinning.
+const val CONTENTION_THREADS = 16
+const val CONTENTION_ITERATIONS = 10000
+const val CONTENTION_PERMITS = 4
+
+/**
+ * Threads repeatedly entering a short critical section guarded by a lock or a semaphore.
+ */
+expect class LockContentionBenchmark() {
+    fun lockOversubscribed()
+    fun semaphoreOversubscribed()
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+const val PRODUCER_CONSUMER_BATCHES = 100
+const val PRODUCER_CONSUMER_BATCH_SIZE = 1000
+
+class ProducerConsumerItem(val value: Int, val next: ProducerConsumerItem?)
+
+fun produceItems(): ProducerConsumerItem? {
+    var head: ProducerConsumerItem? = null
+    for (i in 0 until PRODUCER_CONSUMER_BATCH_SIZE) {
+        head = ProducerConsumerItem(i, head)
+    }
+    return head
+}
+
+fun consumeItems(head: ProducerConsumerItem?): Int {
+    var sum = 0
+    var current = head
+    while (current != null) {
+        sum += current.value
+        current = current.next
+    }
+    return sum
+}
+
+/**
+ * Objects allocated by one thread and released by another one, so memory manager has to free them
+ * in the heap of another thread.
+ */
+expect class ProducerConsumerBenchmark() {
+    fun transferredItems()
+    fun frozenItems()
+}
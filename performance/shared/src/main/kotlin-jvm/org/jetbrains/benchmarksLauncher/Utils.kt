@@ -17,6 +17,7 @@
 package org.jetbrains.benchmarksLauncher
 
 import java.io.File
+import java.lang.management.ManagementFactory
 import java.text.SimpleDateFormat
 import java.util.Date
 
@@ -47,6 +48,11 @@ actual fun currentTime(): String =
 
 actual fun nanoTime(): Long = System.nanoTime()
 
+actual fun processCpuTimeNanos(): Long =
+        (ManagementFactory.getOperatingSystemMXBean() as? com.sun.management.OperatingSystemMXBean)?.processCpuTime ?: 0L
+
+actual fun getEnv(name: String): String? = System.getenv(name)
+
 actual class Blackhole {
     actual companion object {
         actual var consumer = 0
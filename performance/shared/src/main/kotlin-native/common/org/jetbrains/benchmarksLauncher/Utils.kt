@@ -51,6 +51,8 @@ actual fun printStderr(message: String) {
 
 actual fun nanoTime(): Long = kotlin.system.getTimeNanos()
 
+actual fun getEnv(name: String): String? = getenv(name)?.toKString()
+
 actual class Blackhole {
     @kotlin.native.ThreadLocal
     actual companion object {
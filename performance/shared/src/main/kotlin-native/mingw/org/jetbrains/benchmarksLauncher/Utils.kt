@@ -32,3 +32,16 @@ actual fun currentTime() =
 
             timeBuffer.toKString()
         }
+
+private fun FILETIME.toLong() = (dwHighDateTime.toLong() shl 32) or dwLowDateTime.toLong()
+
+actual fun processCpuTimeNanos(): Long =
+        memScoped {
+            val creationTime = alloc<FILETIME>()
+            val exitTime = alloc<FILETIME>()
+            val kernelTime = alloc<FILETIME>()
+            val userTime = alloc<FILETIME>()
+            GetProcessTimes(GetCurrentProcess(), creationTime.ptr, exitTime.ptr, kernelTime.ptr, userTime.ptr)
+            // FILETIME is in 100 ns units.
+            (kernelTime.toLong() + userTime.toLong()) * 100L
+        }
@@ -31,3 +31,11 @@ actual fun currentTime() =
 
             timeBuffer.toKString()
         }
+
+actual fun processCpuTimeNanos(): Long =
+        memScoped {
+            val usage = alloc<rusage>()
+            getrusage(RUSAGE_SELF, usage.ptr)
+            (usage.ru_utime.tv_sec.toLong() + usage.ru_stime.tv_sec.toLong()) * 1_000_000_000L +
+                    (usage.ru_utime.tv_usec.toLong() + usage.ru_stime.tv_usec.toLong()) * 1_000L
+        }
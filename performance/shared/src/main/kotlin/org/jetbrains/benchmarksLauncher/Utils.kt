@@ -30,6 +30,12 @@ expect fun currentTime(): String
 
 expect fun nanoTime(): Long
 
+// User and system CPU time consumed by all threads of the process.
+expect fun processCpuTimeNanos(): Long
+
+// Value of the environment variable, or null if it is not set.
+expect fun getEnv(name: String): String?
+
 expect class Blackhole {
     companion object {
         var consumer: Int
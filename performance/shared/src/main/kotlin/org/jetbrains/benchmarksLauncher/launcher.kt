@@ -23,6 +23,9 @@ import kotlinx.cli.*
 abstract class Launcher {
     abstract val benchmarks: BenchmarksCollection
 
+    // Benchmarks which also report CPU time of the process, e.g. to tell spinning from blocking.
+    open val cpuTimeBenchmarks: Set<String> = emptySet()
+
     fun add(name: String, benchmark: AbstractBenchmarkEntry) {
         benchmarks[name] = benchmark
     }
@@ -90,17 +93,26 @@ abstract class Launcher {
                 autoEvaluatedNumberOfMeasureIteration *= 2
             }
             logger.log("Running benchmark $name ")
+            val reportsCpuTime = name in cpuTimeBenchmarks
             val samples = DoubleArray(numberOfAttempts)
             for (k in samples.indices) {
                 logger.log(".", usePrefix = false)
                 i = autoEvaluatedNumberOfMeasureIteration
+                val cpuTimeStart = if (reportsCpuTime) processCpuTimeNanos() else 0L
                 val time = runBenchmark(benchmarkInstance, benchmark, i)
+                val cpuTime = if (reportsCpuTime) processCpuTimeNanos() - cpuTimeStart else 0L
                 val scaledTime = time * 1.0 / autoEvaluatedNumberOfMeasureIteration
                 samples[k] = scaledTime
                 // Save benchmark object
                 benchmarkResults.add(BenchmarkResult("$prefix$name", BenchmarkResult.Status.PASSED,
                         scaledTime / 1000, BenchmarkResult.Metric.EXECUTION_TIME, scaledTime / 1000,
                         k + 1, numWarmIterations))
+                if (reportsCpuTime) {
+                    val scaledCpuTime = cpuTime * 1.0 / autoEvaluatedNumberOfMeasureIteration
+                    benchmarkResults.add(BenchmarkResult("$prefix$name", BenchmarkResult.Status.PASSED,
+                            scaledCpuTime / 1000, BenchmarkResult.Metric.CPU_TIME, scaledCpuTime / 1000,
+                            k + 1, numWarmIterations))
+                }
             }
             logger.log("\n", usePrefix = false)
         }
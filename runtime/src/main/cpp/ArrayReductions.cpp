@@ -0,0 +1,251 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include <math.h>
+
+#include "Common.h"
+#include "Natives.h"
+#include "Types.h"
+
+// Reductions and dot products over primitive arrays.
+//
+// Loops keep several independent accumulators, so that the compiler vectorizes them without reassociating
+// floating point additions on its own. Indices are checked on the Kotlin side.
+
+namespace {
+
+// Must match kotlin.native.Summation.
+enum Summation {
+  SUMMATION_FAST = 0,
+  SUMMATION_PAIRWISE = 1,
+  SUMMATION_KAHAN = 2
+};
+
+constexpr int kLanes = 8;
+// Blocks summed directly by the pairwise summation.
+constexpr KInt kPairwiseBlock = 128;
+
+template <typename T>
+struct Elements {
+  const T* x;
+  ALWAYS_INLINE T operator()(KInt index) const { return x[index]; }
+};
+
+template <typename T>
+struct Products {
+  const T* x;
+  const T* y;
+  ALWAYS_INLINE T operator()(KInt index) const { return x[index] * y[index]; }
+};
+
+template <typename T>
+const T* elements(KConstRef array, KInt fromIndex) {
+  return PrimitiveArrayAddressOfElementAt<T>(array->array(), fromIndex);
+}
+
+// Plain sum of [from, to) with kLanes accumulators. Error grows linearly with the number of elements.
+template <typename R, typename Source>
+R fastSum(Source source, KInt from, KInt to) {
+  R lanes[kLanes] = {};
+  KInt index = from;
+  for (; index + kLanes <= to; index += kLanes) {
+    for (int lane = 0; lane < kLanes; lane++) {
+      lanes[lane] += source(index + lane);
+    }
+  }
+  R result = 0;
+  for (; index < to; index++) {
+    result += source(index);
+  }
+  for (int lane = 0; lane < kLanes; lane++) {
+    result += lanes[lane];
+  }
+  return result;
+}
+
+// Error grows logarithmically with the number of elements.
+template <typename R, typename Source>
+R pairwiseSum(Source source, KInt from, KInt to) {
+  KInt count = to - from;
+  if (count <= kPairwiseBlock) return fastSum<R>(source, from, to);
+  // Split at a multiple of the block size, so that only the last block is partial.
+  KInt middle = from + (count / 2 + kPairwiseBlock - 1) / kPairwiseBlock * kPairwiseBlock;
+  return pairwiseSum<R>(source, from, middle) + pairwiseSum<R>(source, middle, to);
+}
+
+// Kahan-Babuska (Neumaier) summation in every lane: error doesn't depend on the number of elements.
+template <typename R>
+ALWAYS_INLINE inline void compensatedAdd(R* sum, R* compensation, R value) {
+  R t = *sum + value;
+  // Select instead of branching, so that the lanes are vectorized.
+  R lost = (*sum >= value) == (*sum >= -value) ? (*sum - t) + value : (value - t) + *sum;
+  *compensation += lost;
+  *sum = t;
+}
+
+template <typename R, typename Source>
+R kahanSum(Source source, KInt count) {
+  R sums[kLanes] = {};
+  R compensations[kLanes] = {};
+  KInt index = 0;
+  for (; index + kLanes <= count; index += kLanes) {
+    for (int lane = 0; lane < kLanes; lane++) {
+      compensatedAdd(&sums[lane], &compensations[lane], source(index + lane));
+    }
+  }
+  R sum = 0;
+  R compensation = 0;
+  for (; index < count; index++) {
+    compensatedAdd(&sum, &compensation, source(index));
+  }
+  for (int lane = 0; lane < kLanes; lane++) {
+    compensatedAdd(&sum, &compensation, sums[lane]);
+    compensation += compensations[lane];
+  }
+  return sum + compensation;
+}
+
+template <typename R, typename Source>
+R floatingSum(Source source, KInt count, KInt summation) {
+  switch (summation) {
+    case SUMMATION_PAIRWISE:
+      return pairwiseSum<R>(source, 0, count);
+    case SUMMATION_KAHAN:
+      return kahanSum<R>(source, count);
+    default:
+      return fastSum<R>(source, 0, count);
+  }
+}
+
+// Sums integers with wrapping on overflow, as Kotlin does.
+template <typename T, typename U, typename Source>
+T integerSum(Source source, KInt count) {
+  return static_cast<T>(fastSum<U>(source, 0, count));
+}
+
+template <typename T>
+T integerMax(KConstRef array, KInt fromIndex, KInt toIndex) {
+  const T* x = elements<T>(array, fromIndex);
+  T result = x[0];
+  for (KInt index = 1; index < toIndex - fromIndex; index++) {
+    result = x[index] > result || (x[index] == result && !signbit(x[index])) ? x[index] : result;
+  }
+  return result;
+}
+
+template <typename T>
+T integerMin(KConstRef array, KInt fromIndex, KInt toIndex) {
+  const T* x = elements<T>(array, fromIndex);
+  T result = x[0];
+  for (KInt index = 1; index < toIndex - fromIndex; index++) {
+    result = x[index] < result || (x[index] == result && signbit(x[index])) ? x[index] : result;
+  }
+  return result;
+}
+
+// NaN if any element is NaN. Like maxOf() and minOf(), -0.0 is less than 0.0.
+template <typename T>
+T floatingMax(KConstRef array, KInt fromIndex, KInt toIndex) {
+  const T* x = elements<T>(array, fromIndex);
+  T result = x[0];
+  bool hasNaN = false;
+  for (KInt index = 0; index < toIndex - fromIndex; index++) {
+    hasNaN |= x[index] != x[index];
+    result = x[index] > result || (x[index] == result && !signbit(x[index])) ? x[index] : result;
+  }
+  return hasNaN ? static_cast<T>(NAN) : result;
+}
+
+template <typename T>
+T floatingMin(KConstRef array, KInt fromIndex, KInt toIndex) {
+  const T* x = elements<T>(array, fromIndex);
+  T result = x[0];
+  bool hasNaN = false;
+  for (KInt index = 0; index < toIndex - fromIndex; index++) {
+    hasNaN |= x[index] != x[index];
+    result = x[index] < result || (x[index] == result && signbit(x[index])) ? x[index] : result;
+  }
+  return hasNaN ? static_cast<T>(NAN) : result;
+}
+
+}  // namespace
+
+extern "C" {
+
+KInt Kotlin_IntArray_sum(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  // Unsigned accumulators wrap without undefined behavior.
+  return integerSum<KInt, uint32_t>(Elements<uint32_t>{elements<uint32_t>(thiz, fromIndex)}, toIndex - fromIndex);
+}
+
+KLong Kotlin_LongArray_sum(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return integerSum<KLong, uint64_t>(Elements<uint64_t>{elements<uint64_t>(thiz, fromIndex)}, toIndex - fromIndex);
+}
+
+KFloat Kotlin_FloatArray_sum(KConstRef thiz, KInt fromIndex, KInt toIndex, KInt summation) {
+  return floatingSum<KFloat>(Elements<KFloat>{elements<KFloat>(thiz, fromIndex)}, toIndex - fromIndex, summation);
+}
+
+KDouble Kotlin_DoubleArray_sum(KConstRef thiz, KInt fromIndex, KInt toIndex, KInt summation) {
+  return floatingSum<KDouble>(Elements<KDouble>{elements<KDouble>(thiz, fromIndex)}, toIndex - fromIndex, summation);
+}
+
+KLong Kotlin_IntArray_dot(KConstRef thiz, KConstRef other) {
+  const KInt* x = elements<KInt>(thiz, 0);
+  const KInt* y = elements<KInt>(other, 0);
+  // Products of 32-bit integers fit into 64 bits, and sum wraps.
+  auto products = [x, y](KInt index) {
+    return static_cast<uint64_t>(static_cast<KLong>(x[index]) * y[index]);
+  };
+  return static_cast<KLong>(fastSum<uint64_t>(products, 0, thiz->array()->count_));
+}
+
+KLong Kotlin_LongArray_dot(KConstRef thiz, KConstRef other) {
+  return integerSum<KLong, uint64_t>(Products<uint64_t>{elements<uint64_t>(thiz, 0), elements<uint64_t>(other, 0)},
+                                     thiz->array()->count_);
+}
+
+KFloat Kotlin_FloatArray_dot(KConstRef thiz, KConstRef other, KInt summation) {
+  return floatingSum<KFloat>(Products<KFloat>{elements<KFloat>(thiz, 0), elements<KFloat>(other, 0)},
+                             thiz->array()->count_, summation);
+}
+
+KDouble Kotlin_DoubleArray_dot(KConstRef thiz, KConstRef other, KInt summation) {
+  return floatingSum<KDouble>(Products<KDouble>{elements<KDouble>(thiz, 0), elements<KDouble>(other, 0)},
+                              thiz->array()->count_, summation);
+}
+
+KInt Kotlin_IntArray_max(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return integerMax<KInt>(thiz, fromIndex, toIndex);
+}
+
+KInt Kotlin_IntArray_min(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return integerMin<KInt>(thiz, fromIndex, toIndex);
+}
+
+KLong Kotlin_LongArray_max(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return integerMax<KLong>(thiz, fromIndex, toIndex);
+}
+
+KLong Kotlin_LongArray_min(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return integerMin<KLong>(thiz, fromIndex, toIndex);
+}
+
+KFloat Kotlin_FloatArray_max(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return floatingMax<KFloat>(thiz, fromIndex, toIndex);
+}
+
+KFloat Kotlin_FloatArray_min(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return floatingMin<KFloat>(thiz, fromIndex, toIndex);
+}
+
+KDouble Kotlin_DoubleArray_max(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return floatingMax<KDouble>(thiz, fromIndex, toIndex);
+}
+
+KDouble Kotlin_DoubleArray_min(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return floatingMin<KDouble>(thiz, fromIndex, toIndex);
+}
+
+}  // extern "C"
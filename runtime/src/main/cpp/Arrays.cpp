@@ -62,6 +62,70 @@ inline void copyImpl(KConstRef thiz, KInt fromIndex,
 }
 
 
+inline uint8_t byteSwap(uint8_t value) { return value; }
+inline uint16_t byteSwap(uint16_t value) { return __builtin_bswap16(value); }
+inline uint32_t byteSwap(uint32_t value) { return __builtin_bswap32(value); }
+inline uint64_t byteSwap(uint64_t value) { return __builtin_bswap64(value); }
+
+// Copies elements of width sizeof(T) between native memory and primitive arrays.
+// `stride` is the distance in bytes between consecutive elements in native memory,
+// elements in native memory are not required to be aligned.
+template<typename T>
+inline void copyFromNativeMemoryImpl(KRef thiz, KInt toIndex, KConstNativePtr source,
+                                     KInt count, KInt stride, KBoolean swapBytes) {
+  ArrayHeader* array = thiz->array();
+  if (count < 0 || toIndex < 0 || static_cast<uint32_t>(count) + toIndex > array->count_) {
+    ThrowArrayIndexOutOfBoundsException();
+  }
+  mutabilityCheck(thiz);
+  T* destination = PrimitiveArrayAddressOfElementAt<T>(array, toIndex);
+  const uint8_t* address = reinterpret_cast<const uint8_t*>(source);
+  if (stride == sizeof(T) && !swapBytes) {
+    memcpy(destination, address, count * sizeof(T));
+    return;
+  }
+  // Separate loops, so that each of them could be vectorized.
+  T value;
+  if (swapBytes) {
+    for (KInt index = 0; index < count; ++index, address += stride) {
+      memcpy(&value, address, sizeof(T));
+      destination[index] = byteSwap(value);
+    }
+  } else {
+    for (KInt index = 0; index < count; ++index, address += stride) {
+      memcpy(&value, address, sizeof(T));
+      destination[index] = value;
+    }
+  }
+}
+
+template<typename T>
+inline void copyToNativeMemoryImpl(KConstRef thiz, KInt fromIndex, KNativePtr destination,
+                                   KInt count, KInt stride, KBoolean swapBytes) {
+  const ArrayHeader* array = thiz->array();
+  if (count < 0 || fromIndex < 0 || static_cast<uint32_t>(count) + fromIndex > array->count_) {
+    ThrowArrayIndexOutOfBoundsException();
+  }
+  const T* source = PrimitiveArrayAddressOfElementAt<T>(array, fromIndex);
+  uint8_t* address = reinterpret_cast<uint8_t*>(destination);
+  if (stride == sizeof(T) && !swapBytes) {
+    memcpy(address, source, count * sizeof(T));
+    return;
+  }
+  T value;
+  if (swapBytes) {
+    for (KInt index = 0; index < count; ++index, address += stride) {
+      value = byteSwap(source[index]);
+      memcpy(address, &value, sizeof(T));
+    }
+  } else {
+    for (KInt index = 0; index < count; ++index, address += stride) {
+      memcpy(address, &source[index], sizeof(T));
+    }
+  }
+}
+
+
 template <class T>
 inline void PrimitiveArraySet(KRef thiz, KInt index, T value) {
   ArrayHeader* array = thiz->array();
@@ -81,6 +145,32 @@ inline T PrimitiveArrayGet(KConstRef thiz, KInt index) {
   return *PrimitiveArrayAddressOfElementAt<T>(array, index);
 }
 
+// Vector128 lanes are read and written with memcpy, as array elements are not 16-byte aligned.
+template <class T>
+inline void CheckVector128Bounds(const ArrayHeader* array, KInt index) {
+  constexpr uint32_t kLaneCount = sizeof(KVector4f) / sizeof(T);
+  if (array->count_ < kLaneCount || static_cast<uint32_t>(index) > array->count_ - kLaneCount) {
+    ThrowArrayIndexOutOfBoundsException();
+  }
+}
+
+template <class T>
+inline KVector4f PrimitiveArrayGetVector128(KConstRef thiz, KInt index) {
+  const ArrayHeader* array = thiz->array();
+  CheckVector128Bounds<T>(array, index);
+  KVector4f result;
+  memcpy(&result, PrimitiveArrayAddressOfElementAt<T>(array, index), sizeof(result));
+  return result;
+}
+
+template <class T>
+inline void PrimitiveArraySetVector128(KRef thiz, KInt index, KVector4f value) {
+  ArrayHeader* array = thiz->array();
+  CheckVector128Bounds<T>(array, index);
+  mutabilityCheck(thiz);
+  memcpy(PrimitiveArrayAddressOfElementAt<T>(array, index), &value, sizeof(value));
+}
+
 }  // namespace
 
 extern "C" {
@@ -494,6 +584,15 @@ KInt Kotlin_IntArray_getArrayLength(KConstRef thiz) {
   return array->count_;
 }
 
+// See Kotlin_Vector4i32_of() for why integer vectors are passed as KVector4f.
+KVector4f Kotlin_IntArray_getVector128At(KConstRef thiz, KInt index) {
+  return PrimitiveArrayGetVector128<KInt>(thiz, index);
+}
+
+void Kotlin_IntArray_setVector128At(KRef thiz, KInt index, KVector4f value) {
+  PrimitiveArraySetVector128<KInt>(thiz, index, value);
+}
+
 void Kotlin_ByteArray_fillImpl(KRef thiz, KInt fromIndex, KInt toIndex, KByte value) {
   fillImpl<KByte>(thiz, fromIndex, toIndex, value);
 }
@@ -592,6 +691,14 @@ KInt Kotlin_FloatArray_getArrayLength(KConstRef thiz) {
   return array->count_;
 }
 
+KVector4f Kotlin_FloatArray_getVector128At(KConstRef thiz, KInt index) {
+  return PrimitiveArrayGetVector128<KFloat>(thiz, index);
+}
+
+void Kotlin_FloatArray_setVector128At(KRef thiz, KInt index, KVector4f value) {
+  PrimitiveArraySetVector128<KFloat>(thiz, index, value);
+}
+
 KDouble Kotlin_DoubleArray_get(KConstRef thiz, KInt index) {
   return PrimitiveArrayGet<KDouble>(thiz, index);
 }
@@ -706,4 +813,44 @@ KNativePtr Kotlin_Arrays_getDoubleArrayAddressOfElement(KRef thiz, KInt index) {
   return AddressOfElementAt<KDouble>(array, index);
 }
 
+void Kotlin_Arrays_copyFromNativeMemory8(KRef thiz, KInt toIndex, KConstNativePtr source,
+                                         KInt count, KInt stride, KBoolean swapBytes) {
+  copyFromNativeMemoryImpl<uint8_t>(thiz, toIndex, source, count, stride, swapBytes);
+}
+
+void Kotlin_Arrays_copyFromNativeMemory16(KRef thiz, KInt toIndex, KConstNativePtr source,
+                                          KInt count, KInt stride, KBoolean swapBytes) {
+  copyFromNativeMemoryImpl<uint16_t>(thiz, toIndex, source, count, stride, swapBytes);
+}
+
+void Kotlin_Arrays_copyFromNativeMemory32(KRef thiz, KInt toIndex, KConstNativePtr source,
+                                          KInt count, KInt stride, KBoolean swapBytes) {
+  copyFromNativeMemoryImpl<uint32_t>(thiz, toIndex, source, count, stride, swapBytes);
+}
+
+void Kotlin_Arrays_copyFromNativeMemory64(KRef thiz, KInt toIndex, KConstNativePtr source,
+                                          KInt count, KInt stride, KBoolean swapBytes) {
+  copyFromNativeMemoryImpl<uint64_t>(thiz, toIndex, source, count, stride, swapBytes);
+}
+
+void Kotlin_Arrays_copyToNativeMemory8(KConstRef thiz, KInt fromIndex, KNativePtr destination,
+                                       KInt count, KInt stride, KBoolean swapBytes) {
+  copyToNativeMemoryImpl<uint8_t>(thiz, fromIndex, destination, count, stride, swapBytes);
+}
+
+void Kotlin_Arrays_copyToNativeMemory16(KConstRef thiz, KInt fromIndex, KNativePtr destination,
+                                        KInt count, KInt stride, KBoolean swapBytes) {
+  copyToNativeMemoryImpl<uint16_t>(thiz, fromIndex, destination, count, stride, swapBytes);
+}
+
+void Kotlin_Arrays_copyToNativeMemory32(KConstRef thiz, KInt fromIndex, KNativePtr destination,
+                                        KInt count, KInt stride, KBoolean swapBytes) {
+  copyToNativeMemoryImpl<uint32_t>(thiz, fromIndex, destination, count, stride, swapBytes);
+}
+
+void Kotlin_Arrays_copyToNativeMemory64(KConstRef thiz, KInt fromIndex, KNativePtr destination,
+                                        KInt count, KInt stride, KBoolean swapBytes) {
+  copyToNativeMemoryImpl<uint64_t>(thiz, fromIndex, destination, count, stride, swapBytes);
+}
+
 }  // extern "C"
@@ -18,6 +18,7 @@
 #include "Common.h"
 #include "Exceptions.h"
 #include "Memory.h"
+#include "Parking.h"
 #include "Types.h"
 
 namespace {
@@ -91,6 +92,17 @@ KInt Kotlin_AtomicInt_get(KRef thiz) {
     return getImpl<KInt>(thiz);
 }
 
+KBoolean Kotlin_AtomicInt_parkIfEquals(KRef thiz, KInt expectedValue, KLong timeoutNanos) {
+    volatile KInt* location = getValueLocation<KInt>(thiz);
+    // The caller keeps the atomic alive, and objects never move.
+    SafeRegion safeRegion;
+    return ParkThreadIfEquals(location, expectedValue, timeoutNanos);
+}
+
+void Kotlin_AtomicInt_unpark(KRef thiz, KBoolean all) {
+    UnparkThreads(getValueLocation<KInt>(thiz), all);
+}
+
 KLong Kotlin_AtomicLong_addAndGet(KRef thiz, KLong delta) {
     return addAndGetImpl(thiz, delta);
 }
@@ -182,6 +194,7 @@ void Kotlin_AtomicReference_checkIfFrozen(KRef value) {
 
 OBJ_GETTER(Kotlin_AtomicReference_compareAndSwap, KRef thiz, KRef expectedValue, KRef newValue) {
     Kotlin_AtomicReference_checkIfFrozen(newValue);
+    NoteFrozenMutation(newValue);
     // See Kotlin_AtomicReference_get() for explanations, why locking is needed.
     AtomicReferenceLayout* ref = asAtomicReference(thiz);
     RETURN_RESULT_OF(SwapHeapRefLocked, &ref->value_, expectedValue, newValue, &ref->lock_);
@@ -189,6 +202,7 @@ OBJ_GETTER(Kotlin_AtomicReference_compareAndSwap, KRef thiz, KRef expectedValue,
 
 KBoolean Kotlin_AtomicReference_compareAndSet(KRef thiz, KRef expectedValue, KRef newValue) {
     Kotlin_AtomicReference_checkIfFrozen(newValue);
+    NoteFrozenMutation(newValue);
     // See Kotlin_AtomicReference_get() for explanations, why locking is needed.
     AtomicReferenceLayout* ref = asAtomicReference(thiz);
     ObjHolder holder;
@@ -198,6 +212,7 @@ KBoolean Kotlin_AtomicReference_compareAndSet(KRef thiz, KRef expectedValue, KRe
 
 void Kotlin_AtomicReference_set(KRef thiz, KRef newValue) {
     Kotlin_AtomicReference_checkIfFrozen(newValue);
+    NoteFrozenMutation(newValue);
     AtomicReferenceLayout* ref = asAtomicReference(thiz);
     SetHeapRefLocked(&ref->value_, newValue, &ref->lock_);
 }
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "Common.h"
+#include "Exceptions.h"
+#include "Memory.h"
+#include "Natives.h"
+#include "Types.h"
+
+// Word-parallel kernels for kotlin.native.BitSet and kotlin.native.CompressedBitSet, operating on
+// the backing LongArray. Loops are kept simple, so that they are vectorized by the compiler.
+// Indices are checked on the Kotlin side.
+
+namespace {
+
+// Must match kotlin.native.BitSetOperation.
+enum BitSetOperation {
+  BITSET_AND = 0,
+  BITSET_OR = 1,
+  BITSET_XOR = 2,
+  BITSET_AND_NOT = 3
+};
+
+constexpr KInt kBitsPerWord = 64;
+
+ALWAYS_INLINE inline void mutabilityCheck(KConstRef thiz) {
+  if (!thiz->local() && thiz->container()->frozen()) {
+    ThrowInvalidMutabilityException(thiz);
+  }
+}
+
+ALWAYS_INLINE inline const uint64_t* words(KConstRef array) {
+  return PrimitiveArrayAddressOfElementAt<uint64_t>(array->array(), 0);
+}
+
+ALWAYS_INLINE inline uint64_t* mutableWords(KRef array) {
+  return PrimitiveArrayAddressOfElementAt<uint64_t>(array->array(), 0);
+}
+
+ALWAYS_INLINE inline KInt wordCount(KConstRef array) {
+  return array->array()->count_;
+}
+
+ALWAYS_INLINE inline KInt countTrailingZeros(uint64_t word) {
+  return __builtin_ctzll(word);
+}
+
+ALWAYS_INLINE inline KInt countLeadingZeros(uint64_t word) {
+  return __builtin_clzll(word);
+}
+
+}  // namespace
+
+extern "C" {
+
+KInt Kotlin_BitSet_cardinality(KConstRef bits, KInt fromWord, KInt toWord) {
+  const uint64_t* data = words(bits);
+  KInt result = 0;
+  for (KInt index = fromWord; index < toWord; index++) {
+    result += __builtin_popcountll(data[index]);
+  }
+  return result;
+}
+
+KBoolean Kotlin_BitSet_isEmpty(KConstRef bits) {
+  const uint64_t* data = words(bits);
+  KInt count = wordCount(bits);
+  uint64_t accumulator = 0;
+  for (KInt index = 0; index < count; index++) {
+    accumulator |= data[index];
+  }
+  return accumulator == 0;
+}
+
+// Returns the index of the first bit equal to `lookFor` at or after `startIndex`, or -1 if there is no such bit
+// in the array.
+KInt Kotlin_BitSet_nextBit(KConstRef bits, KInt startIndex, KBoolean lookFor) {
+  const uint64_t* data = words(bits);
+  KInt count = wordCount(bits);
+  KInt index = startIndex / kBitsPerWord;
+  if (index >= count) return -1;
+  uint64_t invert = lookFor ? 0 : ~static_cast<uint64_t>(0);
+  uint64_t word = (data[index] ^ invert) & (~static_cast<uint64_t>(0) << (startIndex % kBitsPerWord));
+  while (word == 0) {
+    if (++index == count) return -1;
+    word = data[index] ^ invert;
+  }
+  return index * kBitsPerWord + countTrailingZeros(word);
+}
+
+// Returns the index of the last bit equal to `lookFor` at or before `startIndex`, or -1 if there is no such bit.
+// `startIndex` must be within the array.
+KInt Kotlin_BitSet_previousBit(KConstRef bits, KInt startIndex, KBoolean lookFor) {
+  const uint64_t* data = words(bits);
+  KInt index = startIndex / kBitsPerWord;
+  uint64_t invert = lookFor ? 0 : ~static_cast<uint64_t>(0);
+  uint64_t word = (data[index] ^ invert) & (~static_cast<uint64_t>(0) >> (kBitsPerWord - 1 - startIndex % kBitsPerWord));
+  while (word == 0) {
+    if (index-- == 0) return -1;
+    word = data[index] ^ invert;
+  }
+  return index * kBitsPerWord + kBitsPerWord - 1 - countLeadingZeros(word);
+}
+
+// Applies `operation` to the words of `thiz` and `another`, storing the result into `thiz`.
+// `thiz` must be at least as long as `another`, missing words of `another` are treated as zeros.
+void Kotlin_BitSet_operation(KRef thiz, KConstRef another, KInt operation) {
+  mutabilityCheck(thiz);
+  uint64_t* destination = mutableWords(thiz);
+  const uint64_t* source = words(another);
+  KInt count = wordCount(another);
+  KInt index = 0;
+  switch (operation) {
+    case BITSET_AND:
+      for (; index < count; index++) destination[index] &= source[index];
+      for (KInt size = wordCount(thiz); index < size; index++) destination[index] = 0;
+      break;
+    case BITSET_OR:
+      for (; index < count; index++) destination[index] |= source[index];
+      break;
+    case BITSET_XOR:
+      for (; index < count; index++) destination[index] ^= source[index];
+      break;
+    case BITSET_AND_NOT:
+      for (; index < count; index++) destination[index] &= ~source[index];
+      break;
+    default:
+      RuntimeAssert(false, "Unknown bit set operation");
+  }
+}
+
+KBoolean Kotlin_BitSet_intersects(KConstRef bits, KConstRef another) {
+  const uint64_t* first = words(bits);
+  const uint64_t* second = words(another);
+  KInt count = wordCount(bits) < wordCount(another) ? wordCount(bits) : wordCount(another);
+  uint64_t accumulator = 0;
+  for (KInt index = 0; index < count; index++) {
+    accumulator |= first[index] & second[index];
+  }
+  return accumulator != 0;
+}
+
+}  // extern "C"
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <cmath>
+
 #include "Memory.h"
 #include "Types.h"
 
@@ -44,12 +46,20 @@ extern const KInt INT_RANGE_TO;
 extern const KLong LONG_RANGE_FROM;
 extern const KLong LONG_RANGE_TO;
 
+extern const KFloat FLOAT_RANGE_FROM;
+extern const KFloat FLOAT_RANGE_TO;
+
+extern const KDouble DOUBLE_RANGE_FROM;
+extern const KDouble DOUBLE_RANGE_TO;
+
 extern KBox<KBoolean> BOOLEAN_CACHE[];
 extern KBox<KByte>    BYTE_CACHE[];
 extern KBox<KChar>    CHAR_CACHE[];
 extern KBox<KShort>   SHORT_CACHE[];
 extern KBox<KInt>     INT_CACHE[];
 extern KBox<KLong>    LONG_CACHE[];
+extern KBox<KFloat>   FLOAT_CACHE[];
+extern KBox<KDouble>  DOUBLE_CACHE[];
 
 namespace {
 
@@ -58,6 +68,14 @@ inline bool isInRange(T value, T from, T to) {
   return value >= from && value <= to;
 }
 
+// Floating point caches only hold integral values. Negative zero is not cached, as it is boxed
+// to a different object than the positive one.
+template<class T>
+inline bool isIntegralInRange(T value, T from, T to) {
+  return value >= from && value <= to && value == static_cast<T>(static_cast<KLong>(value)) &&
+      (value != 0 || !std::signbit(value));
+}
+
 template<class T>
 OBJ_GETTER(getCachedBox, T value, KBox<T> cache[], T from) {
   uint64_t index = value - from;
@@ -92,6 +110,14 @@ bool inLongBoxCache(KLong value) {
   return isInRange(value, LONG_RANGE_FROM, LONG_RANGE_TO);
 }
 
+bool inFloatBoxCache(KFloat value) {
+  return isIntegralInRange(value, FLOAT_RANGE_FROM, FLOAT_RANGE_TO);
+}
+
+bool inDoubleBoxCache(KDouble value) {
+  return isIntegralInRange(value, DOUBLE_RANGE_FROM, DOUBLE_RANGE_TO);
+}
+
 OBJ_GETTER(getCachedBooleanBox, KBoolean value) {
   RETURN_RESULT_OF(getCachedBox, value, BOOLEAN_CACHE, BOOLEAN_RANGE_FROM);
 }
@@ -118,4 +144,12 @@ OBJ_GETTER(getCachedLongBox, KLong value) {
   RETURN_RESULT_OF(getCachedBox, value, LONG_CACHE, LONG_RANGE_FROM);
 }
 
+OBJ_GETTER(getCachedFloatBox, KFloat value) {
+  RETURN_RESULT_OF(getCachedBox, value, FLOAT_CACHE, FLOAT_RANGE_FROM);
+}
+
+OBJ_GETTER(getCachedDoubleBox, KDouble value) {
+  RETURN_RESULT_OF(getCachedBox, value, DOUBLE_CACHE, DOUBLE_RANGE_FROM);
+}
+
 }
\ No newline at end of file
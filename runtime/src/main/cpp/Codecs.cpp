@@ -0,0 +1,394 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include <string.h>
+
+#include "Common.h"
+#include "CpuFeatures.h"
+#include "Exceptions.h"
+#include "Memory.h"
+#include "Natives.h"
+#include "Types.h"
+
+#if HASH_X86
+#include <immintrin.h>
+#endif
+
+// Base64 (RFC 4648) and hex codecs for kotlin.native.Base64 and kotlin.native.Hex.
+//
+// Text is read from and written to either a ByteArray (ASCII) or a String (UTF-16). On x86 with SSSE3,
+// 12 bytes are encoded and 16 characters are decoded per step with the pshufb-based algorithms of
+// W. Mula and D. Lemire (https://arxiv.org/abs/1704.00605); the rest is done by the scalar code.
+// Indices, sizes and padding are checked on the Kotlin side. Decoders return -1 on an invalid character.
+
+namespace {
+
+constexpr uint8_t kInvalid = 0xff;
+
+constexpr char kBase64Standard[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kBase64UrlSafe[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr char kHexLowerCase[] = "0123456789abcdef";
+constexpr char kHexUpperCase[] = "0123456789ABCDEF";
+
+// Reverse lookup tables: a character to its value, or kInvalid.
+struct DecodeTables {
+  uint8_t base64Standard[256];
+  uint8_t base64UrlSafe[256];
+  uint8_t hex[256];
+
+  constexpr DecodeTables() : base64Standard(), base64UrlSafe(), hex() {
+    for (int c = 0; c < 256; c++) {
+      base64Standard[c] = base64UrlSafe[c] = hex[c] = kInvalid;
+    }
+    for (int value = 0; value < 64; value++) {
+      base64Standard[static_cast<uint8_t>(kBase64Standard[value])] = value;
+      base64UrlSafe[static_cast<uint8_t>(kBase64UrlSafe[value])] = value;
+    }
+    for (int value = 0; value < 16; value++) {
+      hex[static_cast<uint8_t>(kHexLowerCase[value])] = value;
+      hex[static_cast<uint8_t>(kHexUpperCase[value])] = value;
+    }
+  }
+};
+
+constexpr DecodeTables kDecodeTables;
+
+template <typename Char>
+ALWAYS_INLINE inline uint8_t decode(const uint8_t* table, Char c) {
+  return c < 256 ? table[c] : kInvalid;
+}
+
+// Scalar kernels.
+
+template <typename Char>
+KInt base64EncodeScalar(const uint8_t* in, KInt length, Char* out, const char* alphabet, bool padding) {
+  Char* start = out;
+  KInt index = 0;
+  for (; index + 3 <= length; index += 3) {
+    uint32_t bits = (in[index] << 16) | (in[index + 1] << 8) | in[index + 2];
+    *out++ = alphabet[bits >> 18];
+    *out++ = alphabet[(bits >> 12) & 63];
+    *out++ = alphabet[(bits >> 6) & 63];
+    *out++ = alphabet[bits & 63];
+  }
+  KInt remaining = length - index;
+  if (remaining > 0) {
+    uint32_t bits = (in[index] << 16) | (remaining == 2 ? in[index + 1] << 8 : 0);
+    *out++ = alphabet[bits >> 18];
+    *out++ = alphabet[(bits >> 12) & 63];
+    if (remaining == 2) *out++ = alphabet[(bits >> 6) & 63];
+    if (padding) {
+      for (KInt pad = remaining; pad < 3; pad++) *out++ = '=';
+    }
+  }
+  return out - start;
+}
+
+template <typename Char>
+KInt base64DecodeScalar(const Char* in, KInt length, uint8_t* out, const uint8_t* table) {
+  uint8_t* start = out;
+  KInt index = 0;
+  for (; index + 4 <= length; index += 4) {
+    uint8_t a = decode(table, in[index]), b = decode(table, in[index + 1]);
+    uint8_t c = decode(table, in[index + 2]), d = decode(table, in[index + 3]);
+    if ((a | b | c | d) == kInvalid) return -1;
+    uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+    *out++ = bits >> 16;
+    *out++ = bits >> 8;
+    *out++ = bits;
+  }
+  KInt remaining = length - index;
+  if (remaining == 1) return -1;
+  if (remaining > 1) {
+    uint8_t a = decode(table, in[index]), b = decode(table, in[index + 1]);
+    uint8_t c = remaining == 3 ? decode(table, in[index + 2]) : 0;
+    if ((a | b | c) == kInvalid) return -1;
+    uint32_t bits = (a << 18) | (b << 12) | (c << 6);
+    *out++ = bits >> 16;
+    if (remaining == 3) *out++ = bits >> 8;
+  }
+  return out - start;
+}
+
+template <typename Char>
+void hexEncodeScalar(const uint8_t* in, KInt length, Char* out, const char* digits) {
+  for (KInt index = 0; index < length; index++) {
+    *out++ = digits[in[index] >> 4];
+    *out++ = digits[in[index] & 15];
+  }
+}
+
+template <typename Char>
+KInt hexDecodeScalar(const Char* in, KInt length, uint8_t* out) {
+  for (KInt index = 0; index + 1 < length; index += 2) {
+    uint8_t high = decode(kDecodeTables.hex, in[index]), low = decode(kDecodeTables.hex, in[index + 1]);
+    if ((high | low) == kInvalid) return -1;
+    *out++ = (high << 4) | low;
+  }
+  return length / 2;
+}
+
+#if HASH_X86
+
+#define SSSE3_FUNCTION __attribute__((target("ssse3")))
+
+// Selected on the first use. Concurrent first uses select the same value, so no synchronization is needed.
+int8_t ssse3State = 0;
+
+bool hasSsse3() {
+  int8_t state = __atomic_load_n(&ssse3State, __ATOMIC_RELAXED);
+  if (state == 0) {
+    state = hash::HasSsse3() ? 1 : -1;
+    __atomic_store_n(&ssse3State, state, __ATOMIC_RELAXED);
+  }
+  return state > 0;
+}
+
+SSSE3_FUNCTION ALWAYS_INLINE inline void storeChars(uint8_t* out, __m128i chars) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+}
+
+SSSE3_FUNCTION ALWAYS_INLINE inline void storeChars(KChar* out, __m128i chars) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(chars, _mm_setzero_si128()));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(chars, _mm_setzero_si128()));
+}
+
+SSSE3_FUNCTION ALWAYS_INLINE inline __m128i loadChars(const uint8_t* in) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+}
+
+// Characters beyond Latin-1 saturate to 0xff, which is invalid for both codecs.
+SSSE3_FUNCTION ALWAYS_INLINE inline __m128i loadChars(const KChar* in) {
+  return _mm_packus_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)),
+                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8)));
+}
+
+// Mask of bytes within [low, high]. Bytes above 0x7f are negative, so they never match.
+SSSE3_FUNCTION ALWAYS_INLINE inline __m128i inRange(__m128i bytes, char low, char high) {
+  return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(low - 1)), _mm_cmpgt_epi8(_mm_set1_epi8(high + 1), bytes));
+}
+
+// Encodes 12-byte blocks while 16 bytes can be loaded. Returns the number of bytes consumed.
+template <typename Char>
+SSSE3_FUNCTION KInt base64EncodeSsse3(const uint8_t* in, KInt length, Char* out, bool urlSafe) {
+  const __m128i spread = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  // Offsets from a value to its character, indexed by the value class computed below.
+  const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, (urlSafe ? '-' : '+') - 62, (urlSafe ? '_' : '/') - 63, 'A', 0, 0);
+  KInt index = 0;
+  for (; index + 16 <= length; index += 12, out += 16) {
+    // Every 3 bytes become four 6-bit values, one per byte.
+    __m128i bytes = _mm_shuffle_epi8(loadChars(in + index), spread);
+    __m128i high = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    __m128i low = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    __m128i values = _mm_or_si128(high, low);
+    // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12.
+    __m128i classes = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    classes = _mm_or_si128(classes, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+    storeChars(out, _mm_add_epi8(values, _mm_shuffle_epi8(offsets, classes)));
+  }
+  return index;
+}
+
+// Decodes 16-character blocks into 12 bytes each. Returns the number of characters consumed,
+// or -1 if a block has an invalid character.
+template <typename Char>
+SSSE3_FUNCTION KInt base64DecodeSsse3(const Char* in, KInt length, uint8_t* out, bool urlSafe) {
+  const char char62 = urlSafe ? '-' : '+';
+  const char char63 = urlSafe ? '_' : '/';
+  const __m128i order = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  KInt index = 0;
+  for (; index + 16 <= length; index += 16, out += 12) {
+    __m128i chars = loadChars(in + index);
+    __m128i upper = inRange(chars, 'A', 'Z');
+    __m128i lower = inRange(chars, 'a', 'z');
+    __m128i digit = inRange(chars, '0', '9');
+    __m128i is62 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(char62));
+    __m128i is63 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(char63));
+    __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(is62, is63)));
+    if (_mm_movemask_epi8(valid) != 0xffff) return -1;
+    __m128i shift = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+        _mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+                     _mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(62 - char62)),
+                                  _mm_and_si128(is63, _mm_set1_epi8(63 - char63)))));
+    __m128i values = _mm_add_epi8(chars, shift);
+    // Four 6-bit values become 3 bytes in every 32-bit lane.
+    __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    __m128i bytes = _mm_shuffle_epi8(_mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000)), order);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), bytes);
+    uint32_t last = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+    memcpy(out + 8, &last, sizeof(last));
+  }
+  return index;
+}
+
+template <typename Char>
+SSSE3_FUNCTION KInt hexEncodeSsse3(const uint8_t* in, KInt length, Char* out, bool upperCase) {
+  const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(upperCase ? kHexUpperCase : kHexLowerCase));
+  const __m128i nibble = _mm_set1_epi8(15);
+  KInt index = 0;
+  for (; index + 16 <= length; index += 16, out += 32) {
+    __m128i bytes = loadChars(in + index);
+    __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+    __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, nibble));
+    storeChars(out, _mm_unpacklo_epi8(high, low));
+    storeChars(out + 16, _mm_unpackhi_epi8(high, low));
+  }
+  return index;
+}
+
+template <typename Char>
+SSSE3_FUNCTION ALWAYS_INLINE inline __m128i hexValues(const Char* in, int* validMask) {
+  __m128i chars = loadChars(in);
+  __m128i digit = inRange(chars, '0', '9');
+  __m128i lower = inRange(chars, 'a', 'f');
+  __m128i upper = inRange(chars, 'A', 'F');
+  *validMask &= _mm_movemask_epi8(_mm_or_si128(digit, _mm_or_si128(lower, upper)));
+  __m128i shift = _mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8(-'0')),
+      _mm_or_si128(_mm_and_si128(lower, _mm_set1_epi8(10 - 'a')), _mm_and_si128(upper, _mm_set1_epi8(10 - 'A'))));
+  // Pairs of nibbles become bytes in 16-bit lanes.
+  return _mm_maddubs_epi16(_mm_add_epi8(chars, shift), _mm_set1_epi16(0x0110));
+}
+
+template <typename Char>
+SSSE3_FUNCTION KInt hexDecodeSsse3(const Char* in, KInt length, uint8_t* out) {
+  KInt index = 0;
+  for (; index + 32 <= length; index += 32, out += 16) {
+    int validMask = 0xffff;
+    __m128i first = hexValues(in + index, &validMask);
+    __m128i second = hexValues(in + index + 16, &validMask);
+    if (validMask != 0xffff) return -1;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(first, second));
+  }
+  return index;
+}
+
+#endif  // HASH_X86
+
+// Dispatchers: the vectorized kernel, if any, handles a prefix and the scalar one handles the rest.
+
+template <typename Char>
+KInt base64Encode(const uint8_t* in, KInt length, Char* out, bool urlSafe, bool padding) {
+  KInt done = 0;
+#if HASH_X86
+  if (hasSsse3()) done = base64EncodeSsse3(in, length, out, urlSafe);
+#endif
+  KInt written = done / 3 * 4;
+  return written + base64EncodeScalar(in + done, length - done, out + written,
+                                      urlSafe ? kBase64UrlSafe : kBase64Standard, padding);
+}
+
+template <typename Char>
+KInt base64Decode(const Char* in, KInt length, uint8_t* out, bool urlSafe) {
+  KInt done = 0;
+#if HASH_X86
+  if (hasSsse3()) done = base64DecodeSsse3(in, length, out, urlSafe);
+  if (done < 0) return -1;
+#endif
+  KInt written = done / 4 * 3;
+  KInt rest = base64DecodeScalar(in + done, length - done, out + written,
+                                 urlSafe ? kDecodeTables.base64UrlSafe : kDecodeTables.base64Standard);
+  return rest < 0 ? -1 : written + rest;
+}
+
+template <typename Char>
+void hexEncode(const uint8_t* in, KInt length, Char* out, bool upperCase) {
+  KInt done = 0;
+#if HASH_X86
+  if (hasSsse3()) done = hexEncodeSsse3(in, length, out, upperCase);
+#endif
+  hexEncodeScalar(in + done, length - done, out + 2 * done, upperCase ? kHexUpperCase : kHexLowerCase);
+}
+
+template <typename Char>
+KInt hexDecode(const Char* in, KInt length, uint8_t* out) {
+  KInt done = 0;
+#if HASH_X86
+  if (hasSsse3()) done = hexDecodeSsse3(in, length, out);
+  if (done < 0) return -1;
+#endif
+  KInt rest = hexDecodeScalar(in + done, length - done, out + done / 2);
+  return rest < 0 ? -1 : done / 2 + rest;
+}
+
+ALWAYS_INLINE inline void mutabilityCheck(KConstRef thiz) {
+  if (!thiz->local() && thiz->container()->frozen()) {
+    ThrowInvalidMutabilityException(thiz);
+  }
+}
+
+ALWAYS_INLINE inline const uint8_t* bytes(KConstRef array, KInt index) {
+  return PrimitiveArrayAddressOfElementAt<uint8_t>(array->array(), index);
+}
+
+ALWAYS_INLINE inline uint8_t* mutableBytes(KRef array, KInt index) {
+  mutabilityCheck(array);
+  return PrimitiveArrayAddressOfElementAt<uint8_t>(array->array(), index);
+}
+
+ALWAYS_INLINE inline const KChar* chars(KString string, KInt index) {
+  return CharArrayAddressOfElementAt(string, index);
+}
+
+}  // namespace
+
+extern "C" {
+
+KInt Kotlin_Base64_encode(KConstRef source, KInt fromIndex, KInt toIndex,
+                          KRef destination, KInt destinationOffset, KBoolean urlSafe, KBoolean padding) {
+  return base64Encode(bytes(source, fromIndex), toIndex - fromIndex, mutableBytes(destination, destinationOffset),
+                      urlSafe, padding);
+}
+
+// `length` is the size of the result, computed on the Kotlin side.
+OBJ_GETTER(Kotlin_Base64_encodeToString, KConstRef source, KInt fromIndex, KInt toIndex,
+           KBoolean urlSafe, KBoolean padding, KInt length) {
+  if (length == 0) {
+    RETURN_RESULT_OF0(TheEmptyString);
+  }
+  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, length, OBJ_RESULT)->array();
+  base64Encode(bytes(source, fromIndex), toIndex - fromIndex, CharArrayAddressOfElementAt(result, 0),
+               urlSafe, padding);
+  RETURN_OBJ(result->obj());
+}
+
+// The source range excludes padding.
+KInt Kotlin_Base64_decode(KConstRef source, KInt fromIndex, KInt toIndex,
+                          KRef destination, KInt destinationOffset, KBoolean urlSafe) {
+  return base64Decode(bytes(source, fromIndex), toIndex - fromIndex, mutableBytes(destination, destinationOffset),
+                      urlSafe);
+}
+
+KInt Kotlin_Base64_decodeString(KString source, KInt fromIndex, KInt toIndex,
+                                KRef destination, KInt destinationOffset, KBoolean urlSafe) {
+  return base64Decode(chars(source, fromIndex), toIndex - fromIndex, mutableBytes(destination, destinationOffset),
+                      urlSafe);
+}
+
+void Kotlin_Hex_encode(KConstRef source, KInt fromIndex, KInt toIndex,
+                       KRef destination, KInt destinationOffset, KBoolean upperCase) {
+  hexEncode(bytes(source, fromIndex), toIndex - fromIndex, mutableBytes(destination, destinationOffset), upperCase);
+}
+
+OBJ_GETTER(Kotlin_Hex_encodeToString, KConstRef source, KInt fromIndex, KInt toIndex, KBoolean upperCase) {
+  KInt length = (toIndex - fromIndex) * 2;
+  if (length == 0) {
+    RETURN_RESULT_OF0(TheEmptyString);
+  }
+  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, length, OBJ_RESULT)->array();
+  hexEncode(bytes(source, fromIndex), toIndex - fromIndex, CharArrayAddressOfElementAt(result, 0), upperCase);
+  RETURN_OBJ(result->obj());
+}
+
+KInt Kotlin_Hex_decode(KConstRef source, KInt fromIndex, KInt toIndex, KRef destination, KInt destinationOffset) {
+  return hexDecode(bytes(source, fromIndex), toIndex - fromIndex, mutableBytes(destination, destinationOffset));
+}
+
+KInt Kotlin_Hex_decodeString(KString source, KInt fromIndex, KInt toIndex, KRef destination, KInt destinationOffset) {
+  return hexDecode(chars(source, fromIndex), toIndex - fromIndex, mutableBytes(destination, destinationOffset));
+}
+
+}  // extern "C"
@@ -53,7 +53,13 @@ void Kotlin_io_Console_println0() {
 
 OBJ_GETTER0(Kotlin_io_Console_readLine) {
   char data[4096];
-  if (konan::consoleReadUtf8(data, sizeof(data)) < 0) {
+  int result;
+  {
+    // Reading may block for an arbitrary long time.
+    SafeRegion safeRegion;
+    result = konan::consoleReadUtf8(data, sizeof(data));
+  }
+  if (result < 0) {
     RETURN_OBJ(nullptr);
   }
   RETURN_RESULT_OF(CreateStringFromCString, data);
@@ -210,6 +210,7 @@ void ThrowException(KRef exception) {
 }
 
 OBJ_GETTER(Kotlin_setUnhandledExceptionHook, KRef hook) {
+  AddGlobalRoot(&currentUnhandledExceptionHook);
   RETURN_RESULT_OF(SwapHeapRefLocked,
     &currentUnhandledExceptionHook, currentUnhandledExceptionHook, hook, &currentUnhandledExceptionHookLock);
 }
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "City.h"
+#include "Common.h"
+#include "Crc32c.h"
+#include "Exceptions.h"
+#include "Memory.h"
+#include "Natives.h"
+#include "Sha1.h"
+#include "Sha256.h"
+#include "Types.h"
+
+// Bindings of the hash functions in common/src/hash, operating directly on array ranges.
+// Indices are checked on the Kotlin side.
+
+namespace {
+
+// Must match SHA1_CONTEXT_SIZE and SHA256_CONTEXT_SIZE in Hashing.kt, in longs.
+constexpr size_t kSha1ContextSize = 12;
+constexpr size_t kSha256ContextSize = 13;
+
+static_assert(sizeof(SHA1_CTX) <= kSha1ContextSize * sizeof(KLong), "SHA1_CTX doesn't fit into the context array");
+static_assert(sizeof(SHA256_CTX) <= kSha256ContextSize * sizeof(KLong), "SHA256_CTX doesn't fit into the context array");
+
+ALWAYS_INLINE inline void mutabilityCheck(KConstRef thiz) {
+  if (!thiz->local() && thiz->container()->frozen()) {
+    ThrowInvalidMutabilityException(thiz);
+  }
+}
+
+ALWAYS_INLINE inline const uint8_t* bytes(KConstRef array, KInt fromIndex) {
+  return PrimitiveArrayAddressOfElementAt<uint8_t>(array->array(), fromIndex);
+}
+
+template <typename Context>
+Context* context(KRef array) {
+  mutabilityCheck(array);
+  return reinterpret_cast<Context*>(PrimitiveArrayAddressOfElementAt<KLong>(array->array(), 0));
+}
+
+}  // namespace
+
+extern "C" {
+
+KLong Kotlin_ByteArray_cityHash64(KConstRef thiz, KInt fromIndex, KInt toIndex) {
+  return CityHash64(bytes(thiz, fromIndex), toIndex - fromIndex);
+}
+
+KLong Kotlin_ByteArray_cityHash64WithSeed(KConstRef thiz, KInt fromIndex, KInt toIndex, KLong seed) {
+  return CityHash64WithSeed(bytes(thiz, fromIndex), toIndex - fromIndex, seed);
+}
+
+KLong Kotlin_String_cityHash64(KString thiz) {
+  return CityHash64(CharArrayAddressOfElementAt(thiz, 0), thiz->count_ * sizeof(KChar));
+}
+
+KInt Kotlin_ByteArray_crc32c(KConstRef thiz, KInt fromIndex, KInt toIndex, KInt crc) {
+  return Crc32c(crc, bytes(thiz, fromIndex), toIndex - fromIndex);
+}
+
+void Kotlin_Sha1_init(KRef state) {
+  SHA1Init(context<SHA1_CTX>(state));
+}
+
+void Kotlin_Sha1_update(KRef state, KConstRef data, KInt fromIndex, KInt toIndex) {
+  SHA1Update(context<SHA1_CTX>(state), bytes(data, fromIndex), toIndex - fromIndex);
+}
+
+// Stores the digest into `digest` and resets the state.
+void Kotlin_Sha1_digest(KRef state, KRef digest) {
+  SHA1_CTX* sha1 = context<SHA1_CTX>(state);
+  SHA1Final(PrimitiveArrayAddressOfElementAt<uint8_t>(digest->array(), 0), sha1);
+  SHA1Init(sha1);
+}
+
+void Kotlin_Sha256_init(KRef state) {
+  SHA256Init(context<SHA256_CTX>(state));
+}
+
+void Kotlin_Sha256_update(KRef state, KConstRef data, KInt fromIndex, KInt toIndex) {
+  SHA256Update(context<SHA256_CTX>(state), bytes(data, fromIndex), toIndex - fromIndex);
+}
+
+// Stores the digest into `digest` and resets the state.
+void Kotlin_Sha256_digest(KRef state, KRef digest) {
+  SHA256_CTX* sha256 = context<SHA256_CTX>(state);
+  SHA256Final(PrimitiveArrayAddressOfElementAt<uint8_t>(digest->array(), 0), sha256);
+  SHA256Init(sha256);
+}
+
+}  // extern "C"
@@ -19,6 +19,7 @@
 #include <stdint.h>
 
 #include "Memory.h"
+#include "Natives.h"
 #include "Types.h"
 
 extern "C" {
@@ -31,6 +32,14 @@ void Kotlin_Interop_disposeStablePointer(KNativePtr pointer) {
   DisposeStablePointer(pointer);
 }
 
+void Kotlin_Interop_createStablePointers(KConstRef objects, KInt startIndex, KInt endIndex, KNativePtr* destination) {
+  CreateStablePointers(ArrayAddressOfElementAt(objects->array(), startIndex), endIndex - startIndex, destination);
+}
+
+void Kotlin_Interop_disposeStablePointers(KNativePtr const* pointers, KInt count) {
+  DisposeStablePointers(pointers, count);
+}
+
 OBJ_GETTER(Kotlin_Interop_derefStablePointer, KNativePtr pointer) {
   RETURN_RESULT_OF(DerefStablePointer, pointer);
 }
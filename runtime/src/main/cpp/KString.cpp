@@ -76,6 +76,31 @@ OBJ_GETTER(utf8ToUtf16, const char* rawString, size_t rawStringLength) {
 }
 
 
+// Output iterator only counting the octets written to it.
+class Utf8SizeCounter {
+ public:
+  explicit Utf8SizeCounter(size_t* size) : size_(size) {}
+
+  Utf8SizeCounter& operator*() { return *this; }
+  Utf8SizeCounter& operator=(uint8_t) { ++*size_; return *this; }
+  Utf8SizeCounter& operator++() { return *this; }
+  Utf8SizeCounter operator++(int) { return *this; }
+
+ private:
+  size_t* size_;
+};
+
+typedef Utf8SizeCounter utf16to8Size(const KChar*, const KChar*, Utf8SizeCounter);
+
+template<utf16to8Size conversion>
+size_t utf8Size(KString string) {
+  const KChar* utf16 = CharArrayAddressOfElementAt(string, 0);
+  size_t result = 0;
+  conversion(utf16, utf16 + string->count_, Utf8SizeCounter(&result));
+  return result;
+}
+
+
 // Case conversion is derived work from Apache Harmony.
 // Unicode 3.0.1 (same as Unicode 3.0.0)
 enum CharacterClass {
@@ -714,11 +739,9 @@ char* CreateCStringFromString(KConstRef kref) {
   if (kref == nullptr) return nullptr;
   KString kstring = kref->array();
   const KChar* utf16 = CharArrayAddressOfElementAt(kstring, 0);
-  KStdString utf8;
-  utf8.reserve(kstring->count_);
-  utf8::unchecked::utf16to8(utf16, utf16 + kstring->count_, back_inserter(utf8));
-  char* result = reinterpret_cast<char*>(konan::calloc(1, utf8.size() + 1));
-  ::memcpy(result, utf8.c_str(), utf8.size());
+  size_t size = utf8Size<utf8::unchecked::utf16to8>(kstring);
+  char* result = reinterpret_cast<char*>(konan::calloc(1, size + 1));
+  utf8::unchecked::utf16to8(utf16, utf16 + kstring->count_, result);
   return result;
 }
 
@@ -1175,5 +1198,38 @@ KInt Kotlin_String_utf16length(KString message) {
   return message->count_ * sizeof(KChar);
 }
 
+KInt Kotlin_String_getUtf8Size(KString thiz) {
+  return utf8Size<utf8::with_replacement::utf16to8>(thiz);
+}
+
+// `destination` must have room for `size` bytes, as returned by `Kotlin_String_getUtf8Size`, and the terminating zero.
+void Kotlin_String_encodeToUtf8Memory(KString thiz, KNativePtr destination, KInt size) {
+  const KChar* utf16 = CharArrayAddressOfElementAt(thiz, 0);
+  char* start = reinterpret_cast<char*>(destination);
+  char* end = utf8::with_replacement::utf16to8(utf16, utf16 + thiz->count_, start);
+  RuntimeAssert(end - start == size, "Unexpected UTF-8 size");
+  *end = '\0';
+}
+
+KNativePtr Kotlin_String_getAddressOfElement(KString thiz, KInt index) {
+  // Address of the end of the string is allowed, so that empty strings could be passed too.
+  if (index < 0 || static_cast<uint32_t>(index) > thiz->count_) {
+    ThrowArrayIndexOutOfBoundsException();
+  }
+  return const_cast<KChar*>(CharArrayAddressOfElementAt(thiz, index));
+}
+
+OBJ_GETTER(Kotlin_CPointer_toKStringFromUtf8, const char* cstring) {
+  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+}
+
+OBJ_GETTER(Kotlin_CPointer_toKStringFromUtf16, const KChar* utf16) {
+  uint32_t length = 0;
+  while (utf16[length] != 0) ++length;
+  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, length, OBJ_RESULT)->array();
+  ::memcpy(CharArrayAddressOfElementAt(result, 0), utf16, length * sizeof(KChar));
+  RETURN_OBJ(result->obj());
+}
+
 
 } // extern "C"
@@ -16,12 +16,19 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include <cstddef> // for offsetof
 
+#ifndef KONAN_NO_THREADS
+#include <pthread.h>
+#include <sys/time.h>
+#endif
+
 #include "Alloc.h"
 #include "KAssert.h"
 #include "Atomic.h"
+#include "City.h"
 #include "Exceptions.h"
 #include "KString.h"
 #include "Memory.h"
@@ -81,12 +88,21 @@ constexpr double kGcToComputeRatioThreshold = 0.5;
 constexpr size_t kMaxErgonomicThreshold = 16 * 1024;
 // Threshold of size for toFree set, triggering actual cycle collector.
 constexpr size_t kMaxToFreeSize = 8 * 1024;
+// How long relaxed model cycle collector waits for other threads to reach safepoints.
+constexpr uint64_t kSafepointTimeoutMicros = 1000;
+// Minimal number of containers allocated by a thread, triggering tracing collector.
+constexpr size_t kTracingHeapThreshold = 64 * 1024;
 // How many elements in finalizer queue allowed before cleaning it up.
 constexpr size_t kFinalizerQueueThreshold = 32;
 // If allocated that much memory since last GC - force new GC.
 constexpr size_t kMaxGcAllocThreshold = 8 * 1024 * 1024;
 #endif  // USE_GC
 
+// Minimal number of newly frozen containers for the root to be stamped with the freeze epoch.
+constexpr size_t kFreezeEpochStampThreshold = 64;
+// How many containers of the heaps of other threads are kept, before handing them over to their owners.
+constexpr size_t kRemoteFreeBatchSize = 256;
+
 typedef KStdUnorderedSet<ContainerHeader*> ContainerHeaderSet;
 typedef KStdVector<ContainerHeader*> ContainerHeaderList;
 typedef KStdDeque<ContainerHeader*> ContainerHeaderDeque;
@@ -108,6 +124,16 @@ FrameOverlay exportFrameOverlay;
 volatile int allocCount = 0;
 volatile int aliveMemoryStatesCount = 0;
 
+// Freeze epochs, see ensureAcyclicAndSet().
+// Incremented at the start and at the end of every freezeSubgraph().
+volatile int32_t freezeEpoch = 0;
+// Upper bound of freeze epochs of all values ever stored into already frozen objects.
+volatile int32_t frozenMutationEpoch = 0;
+// Number of ensureAcyclicAndSet() calls which needed no traversal thanks to freeze epochs.
+volatile int32_t prunedAcyclicityChecks = 0;
+// Number of times memory was returned to the OS, explicitly or automatically.
+volatile int32_t memoryTrims = 0;
+
 KBoolean g_checkLeaks = KonanNeedDebugInfo;
 
 // Only used by the leak detector.
@@ -301,6 +327,14 @@ inline bool isShareable(ContainerHeader* container) {
     return container == nullptr || container->shareable();
 }
 
+// Strict model only collects cycles of local containers. Relaxed model collects cycles of shared
+// containers, with all other threads stopped at safepoints.
+inline bool isCycleCollectable(ContainerHeader* container) {
+  if (IsStrictMemoryModel)
+    return !isShareable(container);
+  return container != nullptr && container->shared();
+}
+
 void garbageCollect();
 
 }  // namespace
@@ -325,66 +359,203 @@ class ForeignRefManager {
       // so it can process the queue pretending like it takes ownership of all its objects:
       this->processAbandoned();
 
-      konanDestructInstance(this);
+      this->destroy();
     }
   }
 
   bool tryReleaseRefOwned() {
     if (atomicAdd(&this->refCount, -1) == 0) {
-      if (this->releaseList != nullptr) {
+      if (this->hasEnqueuedReleaseRefs()) {
         // There are no more holders of [this] to process the enqueued work items in [releaseRef].
         // Revert the reference counter back and notify the caller to process and then retry:
         atomicAdd(&this->refCount, 1);
         return false;
       }
 
-      konanDestructInstance(this);
+      this->destroy();
     }
 
     return true;
   }
 
+  // May be called from any thread. Doesn't allocate unless all pooled chunks are in use.
   void enqueueReleaseRef(ObjHeader* obj) {
-    ListNode* newListNode = konanConstructInstance<ListNode>();
-    newListNode->obj = obj;
+    atomicAdd(&this->activeProducers, 1);
     while (true) {
-      ListNode* next = this->releaseList;
-      newListNode->next = next;
-      if (compareAndSet(&this->releaseList, next, newListNode)) break;
+      ReleaseChunk* chunk = atomicGet(&this->releaseHead);
+      if (chunk != nullptr) {
+        int32_t index = atomicAdd(&chunk->reserved, 1) - 1;
+        if (index < ReleaseChunk::kCapacity) {
+          atomicSet(&chunk->objects[index], obj);
+          break;
+        }
+      }
+
+      // [chunk] is full, so push a new one already holding [obj].
+      ReleaseChunk* newChunk = takeFreeChunk();
+      newChunk->next = chunk;
+      newChunk->reserved = 1;
+      newChunk->objects[0] = obj;
+      if (compareAndSet(&this->releaseHead, chunk, newChunk)) break;
+
+      // Lost the race to another producer; its chunk has free slots, so retry with it.
+      // Note: [newChunk] can't be returned to [freeChunks] from here, see [takeFreeChunk].
+      konanDestructInstance(newChunk);
     }
+    atomicAdd(&this->activeProducers, -1);
   }
 
+  // Must be called by the owning thread only. Processes at most [limit] objects,
+  // the rest is left for subsequent calls.
   template <typename func>
-  void processEnqueuedReleaseRefsWith(func process) {
-    if (releaseList == nullptr) return;
+  void processEnqueuedReleaseRefsWith(func process, size_t limit = SIZE_MAX) {
+    ReleaseChunk* head = atomicGet(&this->releaseHead);
+    if (head == nullptr) return;
+
+    // All chunks behind the head are full: move them to the consumer-owned list.
+    // Only the consumer modifies [next] of a published chunk, so this doesn't race with producers.
+    if (head->next != nullptr) {
+      ReleaseChunk* last = head->next;
+      while (last->next != nullptr) last = last->next;
+      last->next = this->fullChunks;
+      this->fullChunks = head->next;
+      head->next = nullptr;
+    }
+
+    ReleaseChunk** location = &this->fullChunks;
+    while (*location != nullptr && limit > 0) {
+      ReleaseChunk* chunk = *location;
+      processChunk(chunk, ReleaseChunk::kCapacity, process, limit);
+      if (chunk->processed == ReleaseChunk::kCapacity) {
+        *location = chunk->next;
+        chunk->next = this->retiredChunks;
+        this->retiredChunks = chunk;
+      } else {
+        location = &chunk->next;
+      }
+    }
 
-    ListNode* toProcess = nullptr;
+    if (limit > 0) processChunk(head, head->claimed(), process, limit);
 
+    recycleRetiredChunks();
+  }
+
+private:
+  // Block of release requests. Producers claim slots with [reserved] and then publish objects into them,
+  // the owning thread consumes published slots in order and tracks its position in [processed].
+  struct ReleaseChunk {
+    static constexpr int32_t kCapacity = 62;
+
+    ReleaseChunk* next;
+    volatile int32_t reserved;
+    int32_t processed;
+    ObjHeader* volatile objects[kCapacity];
+
+    // Number of slots claimed by producers. Note: [reserved] keeps growing past [kCapacity]
+    // when producers race to push the next chunk.
+    int32_t claimed() {
+      int32_t result = atomicGet(&reserved);
+      return result < kCapacity ? result : kCapacity;
+    }
+  };
+
+  // How many drained chunks to keep for reuse by producers.
+  static constexpr int32_t kMaxFreeChunks = 16;
+
+  int refCount;
+
+  // Number of threads currently inside [enqueueReleaseRef].
+  // Drained chunks are reused only once it was observed to be zero,
+  // so no producer can still be holding a pointer to them.
+  volatile int32_t activeProducers;
+
+  // Chunk currently being filled by producers, linked to the older ones through [ReleaseChunk::next].
+  ReleaseChunk* volatile releaseHead;
+
+  // Treiber stack of chunks ready for reuse. Popped by producers, pushed only by the owning thread.
+  ReleaseChunk* volatile freeChunks;
+  volatile int32_t freeChunksCount;
+
+  // Owned by the consumer.
+  ReleaseChunk* fullChunks;
+  ReleaseChunk* retiredChunks;
+
+  ReleaseChunk* takeFreeChunk() {
+    // Popping is ABA-safe here: a chunk can get back to [freeChunks] only after being drained and retired,
+    // and retired chunks aren't recycled while any producer (including the current one) is active.
     while (true) {
-      toProcess = releaseList;
-      if (compareAndSet<ListNode*>(&this->releaseList, toProcess, nullptr)) break;
+      ReleaseChunk* chunk = atomicGet(&this->freeChunks);
+      if (chunk == nullptr) return konanConstructInstance<ReleaseChunk>();
+      if (compareAndSet(&this->freeChunks, chunk, chunk->next)) {
+        atomicAdd(&this->freeChunksCount, -1);
+        chunk->next = nullptr;
+        return chunk;
+      }
     }
+  }
 
-    while (toProcess != nullptr) {
-      process(toProcess->obj);
-      ListNode* next = toProcess->next;
-      konanDestructInstance(toProcess);
-      toProcess = next;
+  template <typename func>
+  void processChunk(ReleaseChunk* chunk, int32_t available, func& process, size_t& limit) {
+    while (chunk->processed < available && limit > 0) {
+      ObjHeader* obj = atomicGet(&chunk->objects[chunk->processed]);
+      // The slot is reserved but the producer hasn't published the object yet: get back to it later.
+      if (obj == nullptr) return;
+      chunk->objects[chunk->processed] = nullptr;
+      chunk->processed++;
+      limit--;
+      process(obj);
     }
   }
 
-private:
-  int refCount;
+  void recycleRetiredChunks() {
+    if (this->retiredChunks == nullptr || atomicGet(&this->activeProducers) != 0) return;
 
-  struct ListNode {
-    ObjHeader* obj;
-    ListNode* next;
-  };
+    while (this->retiredChunks != nullptr) {
+      ReleaseChunk* chunk = this->retiredChunks;
+      this->retiredChunks = chunk->next;
 
-  ListNode* volatile releaseList;
+      if (atomicGet(&this->freeChunksCount) >= kMaxFreeChunks) {
+        konanDestructInstance(chunk);
+        continue;
+      }
+
+      chunk->reserved = 0;
+      chunk->processed = 0;
+      while (true) {
+        ReleaseChunk* top = atomicGet(&this->freeChunks);
+        chunk->next = top;
+        if (compareAndSet(&this->freeChunks, top, chunk)) break;
+      }
+      atomicAdd(&this->freeChunksCount, 1);
+    }
+  }
+
+  bool hasEnqueuedReleaseRefs() {
+    if (this->fullChunks != nullptr) return true;
+    ReleaseChunk* head = atomicGet(&this->releaseHead);
+    if (head == nullptr) return false;
+    return head->next != nullptr || head->processed < head->claimed();
+  }
+
+  static void destroyChunks(ReleaseChunk* chunk) {
+    while (chunk != nullptr) {
+      ReleaseChunk* next = chunk->next;
+      konanDestructInstance(chunk);
+      chunk = next;
+    }
+  }
+
+  // Requires exclusive access to [this].
+  void destroy() {
+    destroyChunks(this->releaseHead);
+    destroyChunks(this->fullChunks);
+    destroyChunks(this->retiredChunks);
+    destroyChunks(this->freeChunks);
+    konanDestructInstance(this);
+  }
 
   void processAbandoned() {
-    if (this->releaseList != nullptr) {
+    if (this->hasEnqueuedReleaseRefs()) {
       bool hadNoStateInitialized = (memoryState == nullptr);
 
       if (hadNoStateInitialized) {
@@ -395,6 +566,7 @@ private:
         memoryState = InitMemory(); // Required by ReleaseHeapRef.
       }
 
+      // Current thread has exclusive access, so all the reserved slots are already published.
       processEnqueuedReleaseRefsWith([](ObjHeader* obj) {
         ReleaseHeapRef(obj);
       });
@@ -417,6 +589,25 @@ struct MemoryState {
   KRef* tlsMapLastStart;
   void* tlsMapLastKey;
 
+  // Containers of dead boxed primitives kept for reuse, linked via nextLink().
+  ContainerHeader* boxPool;
+  int boxPoolSize;
+  int boxPoolCapacity;
+  // Number of boxes allocated from the pool, see Debugging.reusedBoxes.
+  int32_t reusedBoxes;
+
+  // Allocator heap owned by this state, if supported by the allocator. Only the thread which created
+  // the heap can allocate there, so heap is only set while the state is used by that thread.
+  void* ownHeap;
+  void* heap;
+  FrameOverlay** heapThread;
+  // Containers of the own heap freed by other threads, handed over in batches and linked via nextLink().
+  ContainerHeader* volatile remoteFreeInbox;
+  // Containers of the heaps of other threads freed by this thread, yet to be handed over to their owners.
+  ContainerHeaderList* remoteFreeBatch;
+  // When memory cached by the allocator was last returned to the OS.
+  uint64_t lastTrimTimestamp;
+
 #if USE_GC
   // Finalizer queue - linked list of containers scheduled for finalization.
   ContainerHeader* finalizerQueue;
@@ -432,6 +623,8 @@ struct MemoryState {
    */
   ContainerHeaderList* toFree; // List of all cycle candidates.
   ContainerHeaderList* roots; // Real candidates excluding those with refcount = 0.
+  // How many candidates in toFree shall trigger collection in relaxed model.
+  size_t toFreeThreshold;
   // How many GC suspend requests happened.
   int gcSuspendCount;
   // How many candidate elements in toRelease shall trigger collection.
@@ -448,6 +641,15 @@ struct MemoryState {
 
   uint64_t allocSinceLastGc;
   uint64_t allocSinceLastGcThreshold;
+
+  // Tracing memory model: all containers allocated by this thread, and how many of them trigger collection.
+  ContainerHeaderList* tracedHeap;
+  size_t tracedHeapThreshold;
+  // Tracing memory model: frame chain of this thread, scanned by the collecting thread.
+  FrameOverlay** topFrame;
+  // How many safe regions the thread is in, it does not touch object references unless it is zero.
+  // Parking at a safepoint counts as a safe region as well.
+  volatile int32_t safeRegionDepth;
 #endif // USE_GC
 
 #if COLLECT_STATISTIC
@@ -777,12 +979,198 @@ inline bool isFreezableAtomic(ObjHeader* obj) {
   return obj->type_info() == theFreezableAtomicReferenceTypeInfo;
 }
 
+inline bool isFreezeAwareLazy(ObjHeader* obj) {
+  return obj->type_info() == theFreezeAwareLazyImplTypeInfo;
+}
+
+inline int32_t stampedFreezeEpoch(ObjHeader* obj) {
+  return obj->has_meta_object() ? obj->meta_object()->freezeEpoch_ : 0;
+}
+
+// Epochs saturate instead of wrapping: once they are exhausted nothing is stamped any more,
+// and acyclicity checks always traverse.
+int32_t nextFreezeEpoch() {
+  while (true) {
+    int32_t current = atomicGet(&freezeEpoch);
+    if (current == INT32_MAX) return 0;
+    if (compareAndSet(&freezeEpoch, current, current + 1)) return current + 1;
+  }
+}
+
+inline bool hasReferenceFields(const ObjHeader* obj) {
+  const TypeInfo* typeInfo = obj->type_info();
+  return typeInfo == theArrayTypeInfo || typeInfo->objOffsetsCount_ > 0;
+}
+
+// Size of the value of a boxed primitive, or 0 if the type is not a box.
+size_t boxedValueSize(const TypeInfo* typeInfo) {
+  if (typeInfo == theBooleanBoxTypeInfo || typeInfo == theByteBoxTypeInfo) return 1;
+  if (typeInfo == theCharBoxTypeInfo || typeInfo == theShortBoxTypeInfo) return 2;
+  if (typeInfo == theIntBoxTypeInfo || typeInfo == theFloatBoxTypeInfo) return 4;
+  if (typeInfo == theLongBoxTypeInfo || typeInfo == theDoubleBoxTypeInfo) return 8;
+  return 0;
+}
+
 inline bool isFreezableAtomic(ContainerHeader* container) {
   RuntimeAssert(!isAggregatingFrozenContainer(container), "Must be single object");
   ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
   return isFreezableAtomic(obj);
 }
 
+// States owning allocator heaps, so containers could be handed over to the owners of their heaps.
+KStdVector<MemoryState*>* g_heapOwners = nullptr;
+KInt g_heapOwnersLock = 0;
+// How often memory cached by the allocator is returned to the OS automatically, 0 if never.
+// Initially taken from KOTLIN_NATIVE_IDLE_TRIM_MS environment variable.
+volatile int32_t g_idleTrimIntervalMillis = 0;
+KInt g_idleTrimIntervalInitialized = 0;
+
+inline int32_t clampTrimInterval(long long millis) {
+  return millis < 0 ? 0 : (millis > INT32_MAX ? INT32_MAX : static_cast<int32_t>(millis));
+}
+
+void initIdleTrimInterval() {
+  if (compareAndSwap(&g_idleTrimIntervalInitialized, 0, 1) != 0) return;
+  const char* value = konan::getenv("KOTLIN_NATIVE_IDLE_TRIM_MS");
+  if (value != nullptr)
+    atomicSet(&g_idleTrimIntervalMillis, clampTrimInterval(strtoll(value, nullptr, 10)));
+}
+
+void initHeap(MemoryState* state) {
+  state->ownHeap = konan::createHeap();
+  if (state->ownHeap == nullptr) return;
+  state->heap = state->ownHeap;
+  // Address of a thread local variable identifies the thread.
+  state->heapThread = &currentFrame;
+  state->remoteFreeBatch = konanConstructInstance<ContainerHeaderList>();
+  lock(&g_heapOwnersLock);
+  if (g_heapOwners == nullptr)
+    g_heapOwners = konanConstructInstance<KStdVector<MemoryState*>>();
+  g_heapOwners->push_back(state);
+  unlock(&g_heapOwnersLock);
+}
+
+// Freeing in the own heap is cheap, contrary to freeing in the heap of another thread.
+void drainRemoteFreeInbox(MemoryState* state) {
+  ContainerHeader* container;
+  do {
+    container = state->remoteFreeInbox;
+  } while (compareAndSwap(&state->remoteFreeInbox, container, static_cast<ContainerHeader*>(nullptr)) != container);
+  while (container != nullptr) {
+    auto* next = container->nextLink();
+    konanFreeMemory(container);
+    container = next;
+  }
+}
+
+// Hands containers over to the owners of their heaps, with a single atomic operation per owner.
+// Containers are grouped by heap without the lock, which is only taken to find the owners of the groups.
+void flushRemoteFreeBatch(MemoryState* state) {
+  auto* batch = state->remoteFreeBatch;
+  if (batch == nullptr || batch->empty()) return;
+  struct Chain {
+    void* heap;
+    ContainerHeader* head;
+    ContainerHeader* tail;
+  };
+  KStdVector<Chain> chains;
+  size_t last = 0;
+  for (auto* container : *batch) {
+    void* heap = konan::heapOf(container);
+    // Containers freed together were usually allocated together, so the previous heap is tried first.
+    size_t index = last;
+    if (index >= chains.size() || chains[index].heap != heap) {
+      for (index = 0; index < chains.size(); index++) {
+        if (chains[index].heap == heap) break;
+      }
+      if (index == chains.size())
+        chains.push_back({ heap, nullptr, container });
+    }
+    last = index;
+    auto& chain = chains[index];
+    container->setNextLink(chain.head);
+    chain.head = container;
+  }
+  batch->clear();
+  lock(&g_heapOwnersLock);
+  for (auto& chain : chains) {
+    MemoryState* owner = nullptr;
+    if (chain.heap != nullptr) {
+      for (auto* candidate : *g_heapOwners) {
+        if (candidate->ownHeap == chain.heap) {
+          owner = candidate;
+          break;
+        }
+      }
+    }
+    if (owner == nullptr) continue;
+    ContainerHeader* inbox;
+    do {
+      inbox = owner->remoteFreeInbox;
+      chain.tail->setNextLink(inbox);
+    } while (compareAndSwap(&owner->remoteFreeInbox, inbox, chain.head) != inbox);
+    chain.head = nullptr;
+  }
+  unlock(&g_heapOwnersLock);
+  // Heaps of the rest are already destroyed, or they weren't allocated in a heap at all.
+  for (auto& chain : chains) {
+    auto* container = chain.head;
+    while (container != nullptr) {
+      auto* next = container->nextLink();
+      konanFreeMemory(container);
+      container = next;
+    }
+  }
+}
+
+// Frees containers handed over by other threads, and hands over the ones freed by this thread.
+void exchangeRemoteFrees(MemoryState* state) {
+  flushRemoteFreeBatch(state);
+  if (state->heap != nullptr && state->remoteFreeInbox != nullptr)
+    drainRemoteFreeInbox(state);
+}
+
+void deinitHeap(MemoryState* state) {
+  if (state->ownHeap == nullptr) return;
+  flushRemoteFreeBatch(state);
+  lock(&g_heapOwnersLock);
+  for (auto it = g_heapOwners->begin(); it != g_heapOwners->end(); ++it) {
+    if (*it == state) {
+      g_heapOwners->erase(it);
+      break;
+    }
+  }
+  unlock(&g_heapOwnersLock);
+  // Nothing could be handed over anymore.
+  drainRemoteFreeInbox(state);
+  // Containers still alive are moved to the default heap of the thread. Heap of a state destroyed
+  // by another thread cannot be touched, and is left to the allocator.
+  if (state->heapThread == &currentFrame)
+    konan::destroyHeap(state->ownHeap);
+  konanDestructInstance(state->remoteFreeBatch);
+  state->remoteFreeBatch = nullptr;
+  state->ownHeap = state->heap = nullptr;
+}
+
+inline void* allocContainerMemory(MemoryState* state, size_t size) {
+  if (state == nullptr || state->heap == nullptr)
+    return konanAllocMemory(size);
+  if (state->remoteFreeInbox != nullptr)
+    drainRemoteFreeInbox(state);
+  return konan::callocInHeap(state->heap, 1, size);
+}
+
+void freeContainer(MemoryState* state, ContainerHeader* container) {
+  if (state != nullptr && state->heap != nullptr && konan::heapOf(container) != state->heap) {
+    state->remoteFreeBatch->push_back(container);
+    if (state->remoteFreeBatch->size() >= kRemoteFreeBatchSize)
+      flushRemoteFreeBatch(state);
+  } else {
+    konanFreeMemory(container);
+  }
+  atomicAdd(&allocCount, -1);
+}
+
 ContainerHeader* allocContainer(MemoryState* state, size_t size) {
  ContainerHeader* result = nullptr;
 #if USE_GC
@@ -812,7 +1200,7 @@ ContainerHeader* allocContainer(MemoryState* state, size_t size) {
     if (state != nullptr)
         state->allocSinceLastGc += size;
 #endif
-    result = konanConstructSizedInstance<ContainerHeader>(alignUp(size, kObjectAlignment));
+    result = new (allocContainerMemory(state, alignUp(size, kObjectAlignment))) ContainerHeader();
     atomicAdd(&allocCount, 1);
   }
   if (state != nullptr) {
@@ -853,8 +1241,7 @@ void processFinalizerQueue(MemoryState* state) {
     state->containers->erase(container);
 #endif
     CONTAINER_DESTROY_EVENT(state, container)
-    konanFreeMemory(container);
-    atomicAdd(&allocCount, -1);
+    freeContainer(state, container);
   }
   RuntimeAssert(state->finalizerQueueSize == 0, "Queue must be empty here");
 }
@@ -882,7 +1269,71 @@ bool hasExternalRefs(ContainerHeader* start, ContainerHeaderSet* visited) {
 
 #endif  // USE_GC
 
+// Boxing of values outside of the box caches is frequent in generic code, such as collections of numbers,
+// so the containers of dead boxes are kept by the thread to avoid going to the allocator.
+bool tryPoolBoxContainer(MemoryState* state, ContainerHeader* container) {
+  if (state == nullptr || state->boxPoolSize >= state->boxPoolCapacity || !container->hasContainerSize())
+    return false;
+  ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
+  if (boxedValueSize(obj->type_info()) == 0) return false;
+  MEMORY_LOG("pooling box container %p\n", container)
+#if TRACE_MEMORY
+  state->containers->erase(container);
+#endif
+  CONTAINER_DESTROY_EVENT(state, container)
+  container->setNextLink(state->boxPool);
+  state->boxPool = container;
+  state->boxPoolSize++;
+  return true;
+}
+
+ContainerHeader* allocBoxContainer(MemoryState* state, size_t size) {
+  ContainerHeader* container = state->boxPool;
+  // Boxes of all types usually have the same size, otherwise the pool is just less efficient.
+  if (container->containerSize() != size) return allocContainer(state, size);
+  state->boxPool = container->nextLink();
+  state->boxPoolSize--;
+  state->reusedBoxes++;
+  memset(container, 0, size);
+  CONTAINER_ALLOC_EVENT(state, size, container);
+#if TRACE_MEMORY
+  state->containers->insert(container);
+#endif
+  return container;
+}
+
+void trimBoxPool(MemoryState* state, int capacity) {
+  while (state->boxPoolSize > capacity) {
+    ContainerHeader* container = state->boxPool;
+    state->boxPool = container->nextLink();
+    state->boxPoolSize--;
+    freeContainer(state, container);
+  }
+}
+
+void trimMemory(MemoryState* state) {
+  exchangeRemoteFrees(state);
+#if USE_GC
+  if (!state->gcInProgress && state->finalizerQueueSuspendCount == 0)
+    processFinalizerQueue(state);
+#endif
+  konan::trimMemory(state->heap);
+  state->lastTrimTimestamp = konan::getTimeMicros();
+  atomicAdd(&memoryTrims, 1);
+}
+
+// Memory is returned to the OS at most once per interval, after collections and when the thread runs
+// out of work, so that the process doesn't stay at its peak footprint after a spike of allocations.
+void trimMemoryIfIdle(MemoryState* state) {
+  int32_t interval = atomicGet(&g_idleTrimIntervalMillis);
+  if (interval == 0 || state == nullptr) return;
+  if (konan::getTimeMicros() - state->lastTrimTimestamp < interval * 1000ULL) return;
+  GC_LOG("Trimming memory\n")
+  trimMemory(state);
+}
+
 void scheduleDestroyContainer(MemoryState* state, ContainerHeader* container) {
+  if (tryPoolBoxContainer(state, container)) return;
 #if USE_GC
   RuntimeAssert(container != nullptr, "Cannot destroy null container");
   container->setNextLink(state->finalizerQueue);
@@ -894,8 +1345,7 @@ void scheduleDestroyContainer(MemoryState* state, ContainerHeader* container) {
     processFinalizerQueue(state);
   }
 #else
-  konanFreeMemory(container);
-  atomicAdd(&allocCount, -1);
+  freeContainer(state, container);
   CONTAINER_DESTROY_EVENT(state, container);
 #endif
 }
@@ -1122,16 +1572,31 @@ inline void decrementRC(ContainerHeader* container) {
   }
 }
 
+// In relaxed model all containers are shared, and the last reference could be concurrently released by
+// another thread, so a possible root is buffered while still referenced. Once buffered, freeContainer()
+// leaves the container to be destroyed by the cycle collector, which scans the candidates.
+inline void decrementSharedRC(MemoryState* state, ContainerHeader* container) {
+  if (container->shared() && state != nullptr && state->toFree != nullptr && !state->gcInProgress &&
+      container->refCount() > 1 && container->tryBufferAsPurple()) {
+    state->toFree->push_back(container);
+  }
+  if (container->decRefCount() == 0)
+    freeContainer(container);
+}
+
 inline void decrementRC(ContainerHeader* container) {
   auto* state = memoryState;
   RuntimeAssert(!IsStrictMemoryModel || state->gcInProgress, "Must only be called during GC");
+  if (!IsStrictMemoryModel) {
+    decrementSharedRC(state, container);
+    return;
+  }
   // TODO: enable me, once account for inner references in frozen objects correctly.
   // RuntimeAssert(container->refCount() > 0, "Must be positive");
   bool useCycleCollector = container->local();
   if (container->decRefCount() == 0) {
     freeContainer(container);
   } else if (useCycleCollector && state->toFree != nullptr) {
-      RuntimeAssert(IsStrictMemoryModel, "No cycle collector in relaxed mode yet");
       RuntimeAssert(container->refCount() > 0, "Must be positive");
       RuntimeAssert(!container->shareable(), "Cycle collector shalln't be used with shared objects yet");
       RuntimeAssert(container->objectCount() == 1, "cycle collector shall only work with single object containers");
@@ -1274,7 +1739,7 @@ void markGray(ContainerHeader* start) {
     traverseContainerReferredObjects(container, [&toVisit](ObjHeader* ref) {
       auto* childContainer = ref->container();
       RuntimeAssert(!isArena(childContainer), "A reference to local object is encountered");
-      if (!isShareable(childContainer)) {
+      if (isCycleCollectable(childContainer)) {
         childContainer->decRefCount<false>();
         toVisit.push_front(childContainer);
       }
@@ -1301,7 +1766,7 @@ void scanBlack(ContainerHeader* start) {
     traverseContainerReferredObjects(container, [&toVisit](ObjHeader* ref) {
         auto childContainer = ref->container();
         RuntimeAssert(!isArena(childContainer), "A reference to local object is encountered");
-        if (!isShareable(childContainer)) {
+        if (isCycleCollectable(childContainer)) {
           childContainer->incRefCount<false>();
           if (useColor) {
             int color = childContainer->color();
@@ -1330,6 +1795,13 @@ void markRoots(MemoryState* state) {
   for (auto container : *(state->toFree)) {
     if (isMarkedAsRemoved(container))
       continue;
+    if (!IsStrictMemoryModel && container->frozen()) {
+      // Frozen after being buffered, see leaveCycleCollection(), destroy it if already freed.
+      container->resetBuffered();
+      if (container->color() == CONTAINER_TAG_GC_BLACK && container->refCount() == 0)
+        scheduleDestroyContainer(state, container);
+      continue;
+    }
     // Acyclic containers cannot be in this list.
     RuntimeCheck(container->color() != CONTAINER_TAG_GC_GREEN, "Must not be green");
     auto color = container->color();
@@ -1357,8 +1829,11 @@ void collectRoots(MemoryState* state) {
   // Here we might free some objects and call deallocation hooks on them,
   // which in turn might call DecrementRC and trigger new GC - forbid that.
   state->gcSuspendCount++;
+  // Unbuffer all roots first, so that garbage cycle is collected from whichever root reaches it first.
   for (auto* container : *(state->roots)) {
     container->resetBuffered();
+  }
+  for (auto* container : *(state->roots)) {
     collectWhite(state, container);
   }
   state->gcSuspendCount--;
@@ -1380,7 +1855,7 @@ void scan(ContainerHeader* start) {
      traverseContainerReferredObjects(container, [&toVisit](ObjHeader* ref) {
        auto* childContainer = ref->container();
        RuntimeAssert(!isArena(childContainer), "A reference to local object is encountered");
-       if (!isShareable(childContainer)) {
+       if (isCycleCollectable(childContainer)) {
          toVisit.push_front(childContainer);
        }
      });
@@ -1394,21 +1869,25 @@ void collectWhite(MemoryState* state, ContainerHeader* start) {
    while (!toVisit.empty()) {
      auto* container = toVisit.front();
      toVisit.pop_front();
-     if (container->color() != CONTAINER_TAG_GC_WHITE || container->buffered()) continue;
+     if (container->color() != CONTAINER_TAG_GC_WHITE) continue;
+     // In relaxed model garbage can also be buffered by other threads, see below.
+     if (IsStrictMemoryModel && container->buffered()) continue;
      container->setColorAssertIfGreen(CONTAINER_TAG_GC_BLACK);
      traverseContainerObjectFields(container, [state, &toVisit](ObjHeader** location) {
         auto* ref = *location;
         if (ref == nullptr) return;
         auto* childContainer = ref->container();
         RuntimeAssert(!isArena(childContainer), "A reference to local object is encountered");
-        if (isShareable(childContainer)) {
+        if (!isCycleCollectable(childContainer)) {
           ZeroHeapRef(location);
         } else {
           toVisit.push_front(childContainer);
         }
      });
      runDeallocationHooks(container);
-     scheduleDestroyContainer(state, container);
+     // Candidate of another thread is destroyed once that thread scans its candidates.
+     if (!container->buffered())
+       scheduleDestroyContainer(state, container);
   }
 }
 #endif
@@ -1439,6 +1918,23 @@ inline void addHeapRef(ContainerHeader* container) {
   }
 }
 
+// Same as [count] calls to addHeapRef(container), with a single update of the reference counter.
+inline void addHeapRefs(ContainerHeader* container, int count) {
+  MEMORY_LOG("AddHeapRefs %p: rc=%d count=%d\n", container, container->refCount(), count)
+  UPDATE_ADDREF_STAT(memoryState, container, needAtomicAccess(container), 0)
+  switch (container->tag()) {
+    case CONTAINER_TAG_STACK:
+      break;
+    case CONTAINER_TAG_LOCAL:
+      container->incRefCount</* Atomic = */ false>(count);
+      break;
+    /* case CONTAINER_TAG_FROZEN: case CONTAINER_TAG_SHARED: */
+    default:
+      container->incRefCount</* Atomic = */ true>(count);
+      break;
+  }
+}
+
 inline void addHeapRef(const ObjHeader* header) {
   auto* container = header->container();
   if (container != nullptr)
@@ -1446,6 +1942,11 @@ inline void addHeapRef(const ObjHeader* header) {
 }
 
 inline bool tryAddHeapRef(ContainerHeader* container) {
+  // In tracing model zero reference count doesn't mean the object is being destroyed.
+  if (IsTracingMemoryModel) {
+    addHeapRef(container);
+    return true;
+  }
   switch (container->tag()) {
     case CONTAINER_TAG_STACK:
       break;
@@ -1535,7 +2036,7 @@ void incrementStack(MemoryState* state) {
   }
 }
 
-void processDecrements(MemoryState* state) {
+void processDecrements(MemoryState* state, bool force) {
   RuntimeAssert(IsStrictMemoryModel, "Only works in strict model now");
   auto* toRelease = state->toRelease;
   state->gcSuspendCount++;
@@ -1549,10 +2050,11 @@ void processDecrements(MemoryState* state) {
      decrementRC(container);
   }
 
+  // Releases enqueued from other threads are processed incrementally, within the same budget as regular ones.
   state->foreignRefManager->processEnqueuedReleaseRefsWith([](ObjHeader* obj) {
     ContainerHeader* container = obj->container();
     if (container != nullptr) decrementRC(container);
-  });
+  }, force ? SIZE_MAX : state->gcThreshold);
   state->gcSuspendCount--;
 }
 
@@ -1577,15 +2079,392 @@ void decrementStack(MemoryState* state) {
   state->gcSuspendCount--;
 }
 
+// Relaxed model cycle collector traverses shared containers, so it stops the world first: all other
+// threads with memory state shall be either parked at safepoints, or in safe regions, i.e. blocked in
+// the runtime or running foreign code.
+#ifndef KONAN_NO_THREADS
+pthread_mutex_t g_safepointLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t g_safepointCond = PTHREAD_COND_INITIALIZER;
+#endif
+// Memory states of all the threads, guarded by g_safepointLock.
+KStdVector<MemoryState*>* g_mutators = nullptr;
+// Candidates of threads which exited before their cycles could be collected.
+ContainerHeaderList* g_orphanedToFree = nullptr;
+// Set while the world is being stopped or is stopped, modified under g_safepointLock.
+volatile int g_safepointRequested = 0;
+// Tracing memory model collector also sweeps containers of threads which exited, and scans static
+// locations holding object references. Guarded by g_safepointLock.
+ContainerHeaderList* g_orphanedHeap = nullptr;
+KStdUnorderedSet<ObjHeader**>* g_globalRoots = nullptr;
+
+inline void lockSafepoint() {
+#ifndef KONAN_NO_THREADS
+  pthread_mutex_lock(&g_safepointLock);
+#endif
+}
+
+inline void unlockSafepoint() {
+#ifndef KONAN_NO_THREADS
+  pthread_mutex_unlock(&g_safepointLock);
+#endif
+}
+
+inline void notifySafepoint() {
+#ifndef KONAN_NO_THREADS
+  pthread_cond_broadcast(&g_safepointCond);
+#endif
+}
+
+// Must be called under g_safepointLock.
+inline void waitWhileSafepointRequested() {
+#ifndef KONAN_NO_THREADS
+  while (g_safepointRequested != 0) {
+    pthread_cond_wait(&g_safepointCond, &g_safepointLock);
+  }
+#endif
+}
+
+void registerMutator(MemoryState* state) {
+  lockSafepoint();
+  // Do not let a new thread in while the world is stopped.
+  waitWhileSafepointRequested();
+  if (g_mutators == nullptr)
+    g_mutators = konanConstructInstance<KStdVector<MemoryState*>>();
+  g_mutators->push_back(state);
+  unlockSafepoint();
+}
+
+void unregisterMutator(MemoryState* state) {
+  lockSafepoint();
+  if (IsTracingMemoryModel) {
+    // Containers of the exiting thread could still be referenced by other threads.
+    if (g_orphanedHeap == nullptr)
+      g_orphanedHeap = konanConstructInstance<ContainerHeaderList>();
+    g_orphanedHeap->insert(g_orphanedHeap->end(), state->tracedHeap->begin(), state->tracedHeap->end());
+    state->tracedHeap->clear();
+  }
+  for (auto it = g_mutators->begin(); it != g_mutators->end(); ++it) {
+    if (*it == state) {
+      g_mutators->erase(it);
+      break;
+    }
+  }
+  notifySafepoint();
+  unlockSafepoint();
+}
+
+// Must be called under g_safepointLock.
+inline void waitAtSafepoint(MemoryState* state) {
+  atomicAdd(&state->safeRegionDepth, 1);
+  notifySafepoint();
+  waitWhileSafepointRequested();
+  atomicAdd(&state->safeRegionDepth, -1);
+}
+
+void parkAtSafepoint(MemoryState* state) {
+  lockSafepoint();
+  waitAtSafepoint(state);
+  unlockSafepoint();
+}
+
+inline void safepoint(MemoryState* state) {
+  if (atomicGet(&g_safepointRequested) != 0 && !state->gcInProgress)
+    parkAtSafepoint(state);
+}
+
+// Safe regions are entered and left on every call to foreign code, so the lock is only taken
+// when the world is being stopped.
+void enterSafeRegion(MemoryState* state) {
+  if (atomicAdd(&state->safeRegionDepth, 1) == 1 && atomicGet(&g_safepointRequested) != 0) {
+    // The collecting thread may be waiting for this one.
+    lockSafepoint();
+    notifySafepoint();
+    unlockSafepoint();
+  }
+}
+
+void leaveSafeRegion(MemoryState* state) {
+  // Both atomicAdd() and the stopping thread are sequentially consistent, so either the request is seen
+  // here, or the stopping thread sees this one running and waits for it to reach a safepoint.
+  while (atomicAdd(&state->safeRegionDepth, -1) == 0 && atomicGet(&g_safepointRequested) != 0) {
+    atomicAdd(&state->safeRegionDepth, 1);
+    parkAtSafepoint(state);
+  }
+}
+
+// Leaves all safe regions the thread is in when it enters Kotlin code from foreign code.
+// Returns how many of them shall be entered again on return to foreign code.
+int32_t leaveAllSafeRegions(MemoryState* state) {
+  int32_t depth = state->safeRegionDepth;
+  if (depth > 0) {
+    // Only the thread itself changes its depth outside of the world being stopped.
+    atomicSet(&state->safeRegionDepth, 1);
+    leaveSafeRegion(state);
+  }
+  return depth;
+}
+
+void restoreSafeRegions(MemoryState* state, int32_t depth) {
+  if (depth == 0) return;
+  enterSafeRegion(state);
+  atomicSet(&state->safeRegionDepth, depth);
+}
+
+// Must be called under g_safepointLock.
+bool otherMutatorsStopped(MemoryState* state) {
+  for (auto* mutator : *g_mutators) {
+    if (mutator != state && atomicGet(&mutator->safeRegionDepth) == 0) return false;
+  }
+  return true;
+}
+
+// Returns false if the world is being stopped by another thread, or some thread running Kotlin code
+// failed to reach a safepoint in time.
+bool stopTheWorld(MemoryState* state) {
+  lockSafepoint();
+  if (g_safepointRequested != 0) {
+    // Another thread collects, let it proceed.
+    waitAtSafepoint(state);
+    unlockSafepoint();
+    return false;
+  }
+  atomicSet(&g_safepointRequested, 1);
+#ifndef KONAN_NO_THREADS
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  uint64_t deadline = tv.tv_sec * 1000000ULL + tv.tv_usec + kSafepointTimeoutMicros;
+  struct timespec ts;
+  ts.tv_sec = deadline / 1000000ULL;
+  ts.tv_nsec = (deadline % 1000000ULL) * 1000ULL;
+  while (!otherMutatorsStopped(state)) {
+    if (pthread_cond_timedwait(&g_safepointCond, &g_safepointLock, &ts) != 0) break;
+  }
+#endif
+  bool stopped = otherMutatorsStopped(state);
+  if (!stopped) {
+    atomicSet(&g_safepointRequested, 0);
+    notifySafepoint();
+  }
+  unlockSafepoint();
+  return stopped;
+}
+
+void resumeTheWorld() {
+  lockSafepoint();
+  atomicSet(&g_safepointRequested, 0);
+  notifySafepoint();
+  unlockSafepoint();
+}
+
+// Hands candidates over to the next collection on any thread, as they cannot be dropped
+// once buffered.
+void orphanToFree(MemoryState* state) {
+  if (state->toFree->size() == 0) return;
+  lockSafepoint();
+  if (g_orphanedToFree == nullptr)
+    g_orphanedToFree = konanConstructInstance<ContainerHeaderList>();
+  g_orphanedToFree->insert(g_orphanedToFree->end(), state->toFree->begin(), state->toFree->end());
+  unlockSafepoint();
+  state->toFree->clear();
+}
+
+// Must be called with the world stopped.
+void adoptOrphanedToFree(MemoryState* state) {
+  if (g_orphanedToFree == nullptr) return;
+  state->toFree->insert(state->toFree->end(), g_orphanedToFree->begin(), g_orphanedToFree->end());
+  konanDestructInstance(g_orphanedToFree);
+  g_orphanedToFree = nullptr;
+}
+
+void collectSharedCycles(MemoryState* state) {
+  RuntimeAssert(!IsStrictMemoryModel, "Only works in relaxed model");
+  if (!stopTheWorld(state)) {
+    // Collect later, when more candidates are found. Some thread may stay out of safepoints
+    // for long (e.g. spinning without allocations), so do not retry on every allocation.
+    state->toFreeThreshold = state->toFree->size() + kMaxToFreeSize;
+    GC_LOG("||| GC: failed to stop the world, toFree threshold is now %d\n", state->toFreeThreshold)
+    return;
+  }
+  state->gcInProgress = true;
+  adoptOrphanedToFree(state);
+  GC_LOG("||| GC: collecting shared cycles, toFree %d\n", state->toFree->size())
+  collectCycles(state);
+  state->gcInProgress = false;
+  resumeTheWorld();
+  state->toFreeThreshold = kMaxToFreeSize;
+}
+
+void addGlobalRoot(ObjHeader** location) {
+  if (!IsTracingMemoryModel) return;
+  lockSafepoint();
+  if (g_globalRoots == nullptr)
+    g_globalRoots = konanConstructInstance<KStdUnorderedSet<ObjHeader**>>();
+  g_globalRoots->insert(location);
+  unlockSafepoint();
+}
+
+bool isTLSLocation(MemoryState* state, ObjHeader** location) {
+  for (auto& record : *state->tlsMap) {
+    KRef* start = record.second.first;
+    if (location >= start && location < start + record.second.second) return true;
+  }
+  return false;
+}
+
+inline void rememberTracedContainer(MemoryState* state, ContainerHeader* container) {
+  // Instances can be allocated before actual runtime init - be prepared for that.
+  if (state != nullptr && state->tracedHeap != nullptr)
+    state->tracedHeap->push_back(container);
+}
+
+inline void traceContainer(ContainerHeader* container, ContainerHeaderList* toTrace) {
+  if (container == nullptr || container->marked()) return;
+  container->mark();
+  toTrace->push_back(container);
+}
+
+inline void traceRef(ObjHeader* ref, ContainerHeaderList* toTrace) {
+  // Static location of a shared object holds 1 while the object is being initialized.
+  if (reinterpret_cast<uintptr_t>(ref) > 1)
+    traceContainer(ref->container(), toTrace);
+}
+
+void traceFrames(FrameOverlay* frame, ContainerHeaderList* toTrace) {
+  while (frame != nullptr) {
+    ObjHeader** current = reinterpret_cast<ObjHeader**>(frame + 1) + frame->parameters;
+    ObjHeader** end = current + frame->count - kFrameOverlaySlots - frame->parameters;
+    while (current < end) {
+      traceRef(*current++, toTrace);
+    }
+    frame = frame->previous;
+  }
+}
+
+void traceMutatorRoots(MemoryState* state, ContainerHeaderList* toTrace) {
+  traceFrames(*state->topFrame, toTrace);
+  for (auto& record : *state->tlsMap) {
+    KRef* start = record.second.first;
+    for (int index = 0; index < record.second.second; index++) {
+      traceRef(start[index], toTrace);
+    }
+  }
+  // Only references held by C++ code, such as stable pointers, are counted.
+  for (auto* container : *state->tracedHeap) {
+    if (container->refCount() > 0)
+      traceContainer(container, toTrace);
+  }
+}
+
+void traceReachable(ContainerHeaderList* toTrace, ContainerHeaderList* stackContainers) {
+  while (!toTrace->empty()) {
+    auto* container = toTrace->back();
+    toTrace->pop_back();
+    // Stack containers are not swept, so shall be unmarked separately.
+    if (container->stack())
+      stackContainers->push_back(container);
+    ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
+    for (int object = 0; object < container->objectCount(); object++) {
+      traverseReferredObjects(obj, [toTrace](ObjHeader* ref) {
+        traceRef(ref, toTrace);
+      });
+      // Weak reference counter is only referred from the meta object.
+      if (obj->has_meta_object())
+        traceRef(obj->meta_object()->WeakReference.counter_, toTrace);
+      obj = reinterpret_cast<ObjHeader*>(reinterpret_cast<uintptr_t>(obj) + objectSize(obj));
+    }
+  }
+}
+
+// Unmarks reachable containers of the heap, and moves all the others to the garbage.
+void sweepTracedHeap(ContainerHeaderList* heap, ContainerHeaderList* garbage) {
+  size_t live = 0;
+  for (auto* container : *heap) {
+    if (container->marked()) {
+      container->unMark();
+      (*heap)[live++] = container;
+    } else {
+      garbage->push_back(container);
+    }
+  }
+  heap->resize(live);
+}
+
+// Mark and sweep collector of the tracing memory model. Roots are the frames and TLS of all threads,
+// static locations and containers referenced from C++ code. Objects never move.
+void collectTracedHeap(MemoryState* state) {
+  RuntimeAssert(IsTracingMemoryModel, "Only works in tracing model");
+  if (!stopTheWorld(state)) {
+    // Collect later, when the heap grows further. Threads blocked in the runtime or running foreign code are
+    // in safe regions, so only Kotlin code which does not reach a safepoint for long holds it off.
+    state->tracedHeapThreshold = state->tracedHeap->size() + kTracingHeapThreshold;
+    GC_LOG("||| GC: failed to stop the world, traced heap threshold is now %d\n", state->tracedHeapThreshold)
+    return;
+  }
+  state->gcInProgress = true;
+  if (g_orphanedHeap != nullptr) {
+    state->tracedHeap->insert(state->tracedHeap->end(), g_orphanedHeap->begin(), g_orphanedHeap->end());
+    konanDestructInstance(g_orphanedHeap);
+    g_orphanedHeap = nullptr;
+  }
+  GC_LOG(">>> GC: tracing heap of %d containers\n", state->tracedHeap->size())
+
+  ContainerHeaderList toTrace;
+  ContainerHeaderList stackContainers;
+  for (auto* mutator : *g_mutators) {
+    traceMutatorRoots(mutator, &toTrace);
+  }
+  if (g_globalRoots != nullptr) {
+    for (auto* location : *g_globalRoots) {
+      traceRef(*location, &toTrace);
+    }
+  }
+  traceReachable(&toTrace, &stackContainers);
+
+  ContainerHeaderList garbage;
+  for (auto* mutator : *g_mutators) {
+    sweepTracedHeap(mutator->tracedHeap, &garbage);
+  }
+  for (auto* container : stackContainers) {
+    container->unMark();
+  }
+  // Weak references to the garbage are cleared before any other thread could read them.
+  for (auto* container : garbage) {
+    runDeallocationHooks(container);
+  }
+  resumeTheWorld();
+
+  for (auto* container : garbage) {
+    scheduleDestroyContainer(state, container);
+  }
+  state->gcInProgress = false;
+  processFinalizerQueue(state);
+  state->tracedHeapThreshold = state->tracedHeap->size() * 2 > kTracingHeapThreshold ?
+      state->tracedHeap->size() * 2 : kTracingHeapThreshold;
+  GC_LOG("<<< GC: %d containers destroyed, %d left\n", garbage.size(), state->tracedHeap->size())
+}
+
 void garbageCollect(MemoryState* state, bool force) {
   RuntimeAssert(!state->gcInProgress, "Recursive GC is disallowed");
 
+  exchangeRemoteFrees(state);
+
+  if (IsTracingMemoryModel) {
+    state->allocSinceLastGc = 0;
+    collectTracedHeap(state);
+    trimMemoryIfIdle(state);
+    return;
+  }
+
   uint64_t allocSinceLastGc = state->allocSinceLastGc;
   state->allocSinceLastGc = 0;
 
   if (!IsStrictMemoryModel) {
-    // In relaxed model we just process finalizer queue and be done with it.
+    // In relaxed model stack references are counted, so only cycles among shared containers are left to collect.
+    if (state->toFree != nullptr && (force || state->toFree->size() > state->toFreeThreshold) &&
+        (state->toFree->size() > 0 || atomicGet(&g_orphanedToFree) != nullptr))
+      collectSharedCycles(state);
     processFinalizerQueue(state);
+    trimMemoryIfIdle(state);
     return;
   }
 
@@ -1598,7 +2477,7 @@ void garbageCollect(MemoryState* state, bool force) {
   state->gcInProgress = true;
 
   incrementStack(state);
-  processDecrements(state);
+  processDecrements(state, force);
   size_t beforeDecrements = state->toRelease->size();
   decrementStack(state);
   size_t afterDecrements = state->toRelease->size();
@@ -1638,6 +2517,8 @@ void garbageCollect(MemoryState* state, bool force) {
 #endif
 
   GC_LOG("<<< GC: toFree %d toRelease %d\n", state->toFree->size(), state->toRelease->size())
+
+  trimMemoryIfIdle(state);
 }
 
 void rememberNewContainer(ContainerHeader* container) {
@@ -1711,7 +2592,7 @@ void deinitForeignRef(ObjHeader* object, ForeignRefManager* manager) {
 
     manager->releaseRef();
   } else {
-    releaseHeapRef<false>(object);
+    ReleaseHeapRef(object);
     RuntimeAssert(manager == nullptr, "must be null");
   }
 }
@@ -1729,18 +2610,32 @@ MemoryState* initMemory() {
   RuntimeAssert(memoryState == nullptr, "memory state must be clear");
   memoryState = konanConstructInstance<MemoryState>();
   INIT_EVENT(memoryState)
+  initHeap(memoryState);
+  initIdleTrimInterval();
+  memoryState->lastTrimTimestamp = konan::getTimeMicros();
 #if USE_GC
   memoryState->toFree = konanConstructInstance<ContainerHeaderList>();
   memoryState->roots = konanConstructInstance<ContainerHeaderList>();
+  memoryState->toFreeThreshold = kMaxToFreeSize;
   memoryState->gcInProgress = false;
   memoryState->gcSuspendCount = 0;
   memoryState->toRelease = konanConstructInstance<ContainerHeaderList>();
   initGcThreshold(memoryState, kGcThreshold);
   memoryState->allocSinceLastGcThreshold = kMaxGcAllocThreshold;
   memoryState->gcErgonomics = true;
+  if (IsTracingMemoryModel) {
+    memoryState->tracedHeap = konanConstructInstance<ContainerHeaderList>();
+    memoryState->tracedHeapThreshold = kTracingHeapThreshold;
+    memoryState->topFrame = &currentFrame;
+  }
+  memoryState->safeRegionDepth = 0;
 #endif
   memoryState->tlsMap = konanConstructInstance<KThreadLocalStorageMap>();
   memoryState->foreignRefManager = ForeignRefManager::create();
+#if USE_GC
+  if (!IsStrictMemoryModel)
+    registerMutator(memoryState);
+#endif
   atomicAdd(&aliveMemoryStatesCount, 1);
   return memoryState;
 }
@@ -1752,6 +2647,13 @@ void deinitMemory(MemoryState* memoryState) {
     GC_LOG("Calling garbageCollect from DeinitMemory()\n")
     garbageCollect(memoryState, true);
   } while (memoryState->toRelease->size() > 0 || !memoryState->foreignRefManager->tryReleaseRefOwned());
+  if (!IsStrictMemoryModel) {
+    // Cycles which could not be collected, as the world was not stopped, are left to other threads.
+    orphanToFree(memoryState);
+    unregisterMutator(memoryState);
+  }
+  if (IsTracingMemoryModel)
+    konanDestructInstance(memoryState->tracedHeap);
   RuntimeAssert(memoryState->toFree->size() == 0, "Some memory have not been released after GC");
   RuntimeAssert(memoryState->toRelease->size() == 0, "Some memory have not been released after GC");
   konanDestructInstance(memoryState->toFree);
@@ -1764,6 +2666,10 @@ void deinitMemory(MemoryState* memoryState) {
 
 #endif // USE_GC
 
+  memoryState->boxPoolCapacity = 0;
+  trimBoxPool(memoryState, 0);
+  deinitHeap(memoryState);
+
   bool lastMemoryState = atomicAdd(&aliveMemoryStatesCount, -1) == 0;
 
 #if TRACE_MEMORY
@@ -1799,6 +2705,7 @@ MemoryState* suspendMemory() {
 
 void resumeMemory(MemoryState* state) {
     ::memoryState = state;
+    state->heap = state->heapThread == &currentFrame ? state->ownHeap : nullptr;
 }
 
 void makeShareable(ContainerHeader* container) {
@@ -1830,7 +2737,8 @@ void zeroHeapRef(ObjHeader** location) {
   if (reinterpret_cast<uintptr_t>(value) > 1) {
     UPDATE_REF_EVENT(memoryState, value, nullptr, location, 0);
     *location = nullptr;
-    ReleaseHeapRef(value);
+    if (!IsTracingMemoryModel)
+      ReleaseHeapRef(value);
   }
 }
 
@@ -1891,13 +2799,15 @@ void updateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) {
 #if KONAN_NO_THREADS
     ObjHeader* old = *location;
     if (old == nullptr) {
-      addHeapRef(const_cast<ObjHeader*>(object));
+      if (!IsTracingMemoryModel)
+        addHeapRef(const_cast<ObjHeader*>(object));
       *const_cast<const ObjHeader**>(location) = object;
     }
 #else
-    addHeapRef(const_cast<ObjHeader*>(object));
+    if (!IsTracingMemoryModel)
+      addHeapRef(const_cast<ObjHeader*>(object));
     auto old = __sync_val_compare_and_swap(location, nullptr, const_cast<ObjHeader*>(object));
-    if (old != nullptr) {
+    if (old != nullptr && !IsTracingMemoryModel) {
       // Failed to store, was not null.
      ReleaseHeapRef(const_cast<ObjHeader*>(object));
     }
@@ -1907,6 +2817,21 @@ void updateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) {
 }
 
 inline void checkIfGcNeeded(MemoryState* state) {
+  if (state != nullptr && IsTracingMemoryModel) {
+    safepoint(state);
+    if (state->tracedHeap != nullptr && state->tracedHeap->size() > state->tracedHeapThreshold &&
+        state->toRelease != nullptr && state->gcSuspendCount == 0 && !state->gcInProgress)
+      garbageCollect(state, false);
+    return;
+  }
+  if (state != nullptr && !IsStrictMemoryModel) {
+    safepoint(state);
+    if (state->toFree != nullptr && state->toFree->size() > state->toFreeThreshold &&
+        state->gcSuspendCount == 0 && !state->gcInProgress) {
+      garbageCollect(state, false);
+      return;
+    }
+  }
   if (state != nullptr && state->allocSinceLastGc > state->allocSinceLastGcThreshold) {
     // To avoid GC trashing check that at least 10ms passed since last GC.
     if (konan::getTimeMicros() - state->lastGcTimestamp > 10 * 1000) {
@@ -1972,8 +2897,8 @@ OBJ_GETTER(initInstance,
     // OK'ish, inited by someone else.
     RETURN_OBJ(value);
   }
-  ObjHeader* object = allocInstance<Strict>(typeInfo, OBJ_RESULT);
-  updateHeapRef<Strict>(location, object);
+  ObjHeader* object = AllocInstance(typeInfo, OBJ_RESULT);
+  UpdateHeapRef(location, object);
 #if KONAN_NO_EXCEPTIONS
   ctor(object);
   return object;
@@ -2064,7 +2989,7 @@ OBJ_GETTER(swapHeapRefLocked,
   // We do not use UpdateRef() here to avoid having ReleaseRef() on return slot under the lock.
   if (oldValue == expectedValue) {
     SetHeapRef(location, newValue);
-    shallRelease = oldValue != nullptr;
+    shallRelease = oldValue != nullptr && !IsTracingMemoryModel;
   } else {
     if (IsStrictMemoryModel && oldValue != nullptr)
       rememberNewContainer(oldValue->container());
@@ -2086,7 +3011,7 @@ void setHeapRefLocked(ObjHeader** location, ObjHeader* newValue, int32_t* spinlo
   // We do not use UpdateRef() here to avoid having ReleaseRef() on old value under the lock.
   SetHeapRef(location, newValue);
   unlock(spinlock);
-  if (oldValue != nullptr)
+  if (oldValue != nullptr && !IsTracingMemoryModel)
     ReleaseHeapRef(oldValue);
 }
 
@@ -2148,6 +3073,56 @@ void leaveFrame(ObjHeader** start, int parameters, int count) {
   }
 }
 
+// Tracing model doesn't count references from the heap and the stack, only the ones held by C++ code,
+// like stable pointers. Container is destroyed by the collector once unreachable, whatever its count is.
+inline void releaseTracedRef(const ObjHeader* object) {
+  auto* container = object->container();
+  if (container != nullptr && container->tag() != CONTAINER_TAG_STACK) {
+    MEMORY_LOG("ReleaseHeapRef %p: rc=%d\n", container, container->refCount())
+    container->decRefCount</* Atomic = */ true>();
+  }
+}
+
+inline void updateTracedRef(ObjHeader** location, const ObjHeader* object) {
+  UPDATE_REF_EVENT(memoryState, *location, object, location, 0);
+  *const_cast<const ObjHeader**>(location) = object;
+}
+
+OBJ_GETTER(allocInstanceTracing, const TypeInfo* type_info) {
+  ObjHeader* obj = allocInstance<false>(type_info, OBJ_RESULT);
+#if USE_GC
+  rememberTracedContainer(memoryState, obj->container());
+#endif  // USE_GC
+  return obj;
+}
+
+OBJ_GETTER(allocArrayInstanceTracing, const TypeInfo* type_info, int32_t elements) {
+  ObjHeader* obj = allocArrayInstance<false>(type_info, elements, OBJ_RESULT);
+#if USE_GC
+  rememberTracedContainer(memoryState, obj->container());
+#endif  // USE_GC
+  return obj;
+}
+
+OBJ_GETTER(initInstanceTracing,
+    ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
+#if USE_GC
+  // Thread local objects are traced as a part of TLS.
+  if (*location == nullptr && !isTLSLocation(memoryState, location))
+    addGlobalRoot(location);
+#endif  // USE_GC
+  RETURN_RESULT_OF(initInstance<false>, location, typeInfo, ctor);
+}
+
+OBJ_GETTER(initSharedInstanceTracing,
+    ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
+#if USE_GC
+  if (*localLocation == nullptr)
+    addGlobalRoot(location);
+#endif  // USE_GC
+  RETURN_RESULT_OF(initSharedInstance<false>, location, localLocation, typeInfo, ctor);
+}
+
 void suspendGC() {
   GC_LOG("suspendGC\n")
   memoryState->gcSuspendCount++;
@@ -2172,6 +3147,8 @@ void stopGC() {
   if (memoryState->toRelease != nullptr) {
     memoryState->gcSuspendCount = 0;
     garbageCollect(memoryState, true);
+    if (!IsStrictMemoryModel)
+      orphanToFree(memoryState);
     konanDestructInstance(memoryState->toRelease);
     konanDestructInstance(memoryState->toFree);
     konanDestructInstance(memoryState->roots);
@@ -2238,6 +3215,56 @@ void disposeStablePointer(KNativePtr pointer) {
   ReleaseHeapRef(ref);
 }
 
+// Increments are coalesced over runs of objects sharing a container (members of a frozen strongly connected
+// component, or repeated elements), and GC is given a chance to run once per batch.
+void createStablePointers(KRef const* objects, KInt count, KNativePtr* destination) {
+  ContainerHeader* run = nullptr;
+  int runLength = 0;
+  for (KInt index = 0; index < count; ++index) {
+    KRef object = objects[index];
+    destination[index] = reinterpret_cast<KNativePtr>(object);
+    ContainerHeader* container = object != nullptr ? object->container() : nullptr;
+    if (container == run) {
+      ++runLength;
+      continue;
+    }
+    if (run != nullptr) addHeapRefs(run, runLength);
+    run = container;
+    runLength = 1;
+  }
+  if (run != nullptr) addHeapRefs(run, runLength);
+#if USE_GC
+  checkIfGcNeeded(memoryState);
+#endif  // USE_GC
+}
+
+void disposeStablePointers(KNativePtr const* pointers, KInt count) {
+#if USE_GC
+  if (IsStrictMemoryModel) {
+    auto* state = memoryState;
+    // Enqueue all the decrements first and check whether GC is needed once per batch,
+    // instead of once per released reference as [ReleaseHeapRef] does.
+    for (KInt index = 0; index < count; ++index) {
+      KRef ref = reinterpret_cast<KRef>(pointers[index]);
+      if (ref == nullptr) continue;
+      auto* container = ref->container();
+      if (container == nullptr || container->tag() == CONTAINER_TAG_STACK) continue;
+      MEMORY_LOG("ReleaseHeapRef %p: rc=%d\n", container, container->refCount())
+      UPDATE_RELEASEREF_STAT(state, container, needAtomicAccess(container), canBeCyclic(container), 0)
+      enqueueDecrementRC</* CanCollect = */ false>(container);
+    }
+    if (state->toRelease->size() >= state->gcThreshold && state->gcSuspendCount == 0) {
+      GC_LOG("Calling GC from DisposeStablePointers: %d\n", state->toRelease->size())
+      garbageCollect(state, false);
+    }
+    return;
+  }
+#endif  // USE_GC
+  for (KInt index = 0; index < count; ++index) {
+    disposeStablePointer(pointers[index]);
+  }
+}
+
 OBJ_GETTER(derefStablePointer, KNativePtr pointer) {
   KRef ref = reinterpret_cast<KRef>(pointer);
 #if USE_GC
@@ -2329,6 +3356,17 @@ bool clearSubgraphReferences(ObjHeader* root, bool checked) {
   return true;
 }
 
+// Frozen containers do not take part in cycle collection. In relaxed model the container could be
+// buffered by another thread though, so it stays buffered until that thread scans its candidates.
+inline void leaveCycleCollection(ContainerHeader* container) {
+  if (!IsStrictMemoryModel && container->buffered()) {
+    container->setColorAssertIfGreen(CONTAINER_TAG_GC_PURPLE);
+  } else {
+    container->resetBuffered();
+    container->setColorUnlessGreen(CONTAINER_TAG_GC_BLACK);
+  }
+}
+
 void freezeAcyclic(ContainerHeader* rootContainer, ContainerHeaderSet* newlyFrozen) {
   KStdDeque<ContainerHeader*> queue;
   queue.push_back(rootContainer);
@@ -2336,8 +3374,7 @@ void freezeAcyclic(ContainerHeader* rootContainer, ContainerHeaderSet* newlyFroz
     ContainerHeader* current = queue.front();
     queue.pop_front();
     current->unMark();
-    current->resetBuffered();
-    current->setColorUnlessGreen(CONTAINER_TAG_GC_BLACK);
+    leaveCycleCollection(current);
     // Note, that once object is frozen, it could be concurrently accessed, so
     // color and similar attributes shall not be used.
     if (!current->frozen())
@@ -2416,8 +3453,7 @@ void freezeCyclic(ObjHeader* root,
 
     // Freeze component.
     for (auto* container : component) {
-      container->resetBuffered();
-      container->setColorUnlessGreen(CONTAINER_TAG_GC_BLACK);
+      leaveCycleCollection(container);
       if (!container->frozen())
         newlyFrozen->insert(container);
       // Note, that once object is frozen, it could be concurrently accessed, so
@@ -2439,6 +3475,21 @@ void freezeCyclic(ObjHeader* root,
   }
 }
 
+// Lazies are the targets of ensureAcyclicAndSet(), so they get the start epoch of the freeze.
+// Large roots get the end epoch, which is greater than the start epoch of every object reachable from them
+// at this point, no matter which freeze has frozen it. Small graphs are cheap to traverse, so their roots
+// are not stamped to avoid allocating a meta-object.
+void stampFreezeEpochs(ObjHeader* root, int32_t startEpoch, const ContainerHeaderSet& newlyFrozen) {
+  for (auto* container : newlyFrozen) {
+    if (isAggregatingFrozenContainer(container)) continue;
+    ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
+    if (isFreezeAwareLazy(obj))
+      obj->meta_object()->freezeEpoch_ = startEpoch;
+  }
+  if (newlyFrozen.size() >= kFreezeEpochStampThreshold && !isFreezeAwareLazy(root))
+    root->meta_object()->freezeEpoch_ = nextFreezeEpoch();
+}
+
 /**
  * Theory of operations.
  *
@@ -2479,31 +3530,146 @@ void freezeSubgraph(ObjHeader* root) {
   depthFirstTraversal(rootContainer, &hasCycles, &firstBlocker, &order);
   if (firstBlocker != nullptr) {
     MEMORY_LOG("See freeze blocker for %p: %p\n", root, firstBlocker)
+    // Tracing collector relies on marks being clear.
+    for (auto* container : order) {
+      container->unMark();
+    }
     ThrowFreezingException(root, firstBlocker);
   }
+  // Taken before anything is marked frozen, so all objects frozen by this call get a later start epoch
+  // than every object frozen earlier.
+  int32_t startEpoch = nextFreezeEpoch();
   ContainerHeaderSet newlyFrozen;
   // Now unmark all marked objects, and freeze them, if no cycles detected.
-  if (hasCycles) {
+  // Tracing model doesn't count heap references, so cyclic graphs need no aggregating containers.
+  if (hasCycles && !IsTracingMemoryModel) {
     freezeCyclic(root, order, &newlyFrozen);
   } else {
     freezeAcyclic(rootContainer, &newlyFrozen);
   }
   MEMORY_LOG("Graph of %p is %s with %d elements\n", root, hasCycles ? "cyclic" : "acyclic", newlyFrozen.size())
+  stampFreezeEpochs(root, startEpoch, newlyFrozen);
 
 #if USE_GC
   // Now remove frozen objects from the toFree list.
   // TODO: optimize it by keeping ignored (i.e. freshly frozen) objects in the set,
   // and use it when analyzing toFree during collection.
+  // In relaxed model frozen candidates are handled when scanning toFree instead.
   auto state = memoryState;
-  for (auto& container : *(state->toFree)) {
-    if (!isMarkedAsRemoved(container) && container->frozen()) {
-      RuntimeAssert(newlyFrozen.count(container) != 0, "Must be newly frozen");
-      container = markAsRemoved(container);
+  if (IsStrictMemoryModel) {
+    for (auto& container : *(state->toFree)) {
+      if (!isMarkedAsRemoved(container) && container->frozen()) {
+        RuntimeAssert(newlyFrozen.count(container) != 0, "Must be newly frozen");
+        container = markAsRemoved(container);
+      }
     }
   }
 #endif
 }
 
+// Strings and boxes are immutable, so they cannot be told apart by anything but identity,
+// if their types and contents are the same. Primitive arrays are mutable, and may be referenced
+// from outside of the subgraph, so replacing them would be observable.
+inline bool isDeduplicatableLeaf(const ObjHeader* obj) {
+  const TypeInfo* typeInfo = obj->type_info();
+  return typeInfo == theStringTypeInfo || boxedValueSize(typeInfo) != 0;
+}
+
+inline const uint8_t* leafContents(const ObjHeader* obj, size_t* size) {
+  const TypeInfo* typeInfo = obj->type_info();
+  if (typeInfo->instanceSize_ < 0) {
+    size_t elementSize = -typeInfo->instanceSize_;
+    *size = elementSize * obj->array()->count_;
+    return reinterpret_cast<const uint8_t*>(obj) + alignUp(sizeof(ArrayHeader), elementSize);
+  }
+  // Layout of KBox in Boxing.cpp.
+  *size = boxedValueSize(typeInfo);
+  return reinterpret_cast<const uint8_t*>(obj + 1);
+}
+
+inline bool sameLeafContents(const ObjHeader* obj, const ObjHeader* other) {
+  if (obj->type_info() != other->type_info()) return false;
+  size_t size, otherSize;
+  const uint8_t* contents = leafContents(obj, &size);
+  const uint8_t* otherContents = leafContents(other, &otherSize);
+  return size == otherSize && memcmp(contents, otherContents, size) == 0;
+}
+
+// Permanent and frozen leaves stay alive anyway, so they are the best candidates to be kept.
+inline int leafRetentionRank(const ObjHeader* obj) {
+  ContainerHeader* container = obj->container();
+  if (container == nullptr) return 2;
+  return container->frozen() ? 1 : 0;
+}
+
+/**
+ * Makes all references from the mutable part of the subgraph of `root` to leaves with the same contents
+ * point to a single one of them, so that the rest could be released.
+ * Leaves with meta-objects are left alone, as they may be observed via weak or stable references.
+ * Nothing is changed if freezing is going to fail.
+ */
+void deduplicateSubgraphLeaves(ObjHeader* root) {
+  KStdVector<ObjHeader**> leafLocations;
+  KStdUnorderedSet<ObjHeader*> visited;
+  KStdDeque<ObjHeader*> queue;
+  visited.insert(root);
+  queue.push_back(root);
+  while (!queue.empty()) {
+    ObjHeader* current = queue.front();
+    queue.pop_front();
+    if (current->has_meta_object() && ((current->meta_object()->flags_ & MF_NEVER_FROZEN) != 0))
+      return;
+    // Frozen and shared objects are not traversed by freezing either.
+    if (!canFreeze(current->container())) continue;
+    // Atomics are only changed via their API, but freezing traverses them, so blockers are looked for there too.
+    bool rewritable = !isFreezableAtomic(current);
+    traverseObjectFields(current, [rewritable, &leafLocations, &visited, &queue](ObjHeader** location) {
+      ObjHeader* ref = *location;
+      if (ref == nullptr) return;
+      if (rewritable && isDeduplicatableLeaf(ref) && !ref->local() && !ref->has_meta_object())
+        leafLocations.push_back(location);
+      else if (visited.insert(ref).second)
+        queue.push_back(ref);
+    });
+  }
+
+  // Leaves with the same hash, and the index of the leaf equal to the one at each location.
+  KStdUnorderedMap<uint64_t, KStdVector<ObjHeader*>> canonicalLeaves;
+  KStdVector<std::pair<uint64_t, size_t>> canonicalIndices;
+  canonicalIndices.reserve(leafLocations.size());
+  for (auto* location : leafLocations) {
+    ObjHeader* leaf = *location;
+    size_t size;
+    const uint8_t* contents = leafContents(leaf, &size);
+    uint64_t hash = CityHash64WithSeed(contents, size, reinterpret_cast<uintptr_t>(leaf->type_info()));
+    auto& bucket = canonicalLeaves[hash];
+    size_t index = 0;
+    while (index < bucket.size() && bucket[index] != leaf && !sameLeafContents(bucket[index], leaf))
+      ++index;
+    if (index == bucket.size())
+      bucket.push_back(leaf);
+    else if (leafRetentionRank(leaf) > leafRetentionRank(bucket[index]))
+      bucket[index] = leaf;
+    canonicalIndices.emplace_back(hash, index);
+  }
+
+  int replaced = 0;
+  for (size_t i = 0; i < leafLocations.size(); ++i) {
+    ObjHeader* canonical = canonicalLeaves[canonicalIndices[i].first][canonicalIndices[i].second];
+    if (*leafLocations[i] != canonical) {
+      UpdateHeapRef(leafLocations[i], canonical);
+      ++replaced;
+    }
+  }
+  MEMORY_LOG("Deduplicated %d references to leaves in subgraph of %p\n", replaced, root)
+}
+
+void freezeSubgraphDeduplicating(ObjHeader* root) {
+  if (root == nullptr || isPermanentOrFrozen(root)) return;
+  deduplicateSubgraphLeaves(root);
+  freezeSubgraph(root);
+}
+
 void ensureNeverFrozen(ObjHeader* object) {
    auto* container = object->container();
    if (container == nullptr || container->frozen())
@@ -2513,42 +3679,80 @@ void ensureNeverFrozen(ObjHeader* object) {
    object->meta_object()->flags_ |= MF_NEVER_FROZEN;
 }
 
-// TODO: incorrect, use 3-color scheme.
+void noteFrozenMutation(ObjHeader* value) {
+  if (value == nullptr || value->container() == nullptr || !hasReferenceFields(value)) return;
+  // Everything reachable from the value is already frozen, so unless the value is a stamped root,
+  // the current epoch is an upper bound.
+  int32_t epoch = isFreezeAwareLazy(value) ? 0 : stampedFreezeEpoch(value);
+  if (epoch == 0) epoch = freezeEpoch;
+  while (true) {
+    int32_t current = frozenMutationEpoch;
+    if (current >= epoch || compareAndSet(&frozenMutationEpoch, current, epoch)) return;
+  }
+}
+
+/**
+ * Checks that `where` is not reachable from `what`, and if so, stores `what` into the field `index` of `where`.
+ *
+ * An object frozen by a freezeSubgraph() call with the given start epoch is only reachable from the roots
+ * with greater end epoch, unless a reference was stored into an already frozen object, which only happens
+ * via atomic references and this function, and raises `frozenMutationEpoch`. So a lazy with the start epoch
+ * greater than both `frozenMutationEpoch` and the end epoch of `what` cannot be reachable from `what`,
+ * and subgraphs of other such roots are skipped during traversal.
+ * Storing values which are not stamped roots into frozen objects conservatively raises `frozenMutationEpoch`
+ * to the current epoch, disabling the shortcut for lazies frozen before that.
+ */
 KBoolean ensureAcyclicAndSet(ObjHeader* where, KInt index, ObjHeader* what) {
     RuntimeAssert(where->container() != nullptr && where->container()->frozen(), "Must be used on frozen objects only");
     RuntimeAssert(what == nullptr || isPermanentOrFrozen(what),
         "Must be used with an immutable value");
     if (what != nullptr) {
+        int32_t whereEpoch = isFreezeAwareLazy(where) ? stampedFreezeEpoch(where) : 0;
+        bool canPrune = whereEpoch != 0 && frozenMutationEpoch < whereEpoch;
+        auto isUnreachable = [canPrune, whereEpoch](ObjHeader* obj) {
+            if (!canPrune || isFreezeAwareLazy(obj)) return false;
+            int32_t epoch = stampedFreezeEpoch(obj);
+            return epoch != 0 && epoch < whereEpoch;
+        };
         // Now we check that `where` is not reachable from `what`.
         // As we cannot modify objects while traversing, instead we remember all seen objects in a set.
         KStdUnorderedSet<ContainerHeader*> seen;
-        KStdDeque<ContainerHeader*> queue;
-        if (what->container() != nullptr)
-            queue.push_back(what->container());
+        KStdVector<ContainerHeader*> toVisit;
+        if (what->container() != nullptr) {
+            if (isUnreachable(what)) {
+                atomicAdd(&prunedAcyclicityChecks, 1);
+            } else {
+                toVisit.push_back(what->container());
+                seen.insert(what->container());
+            }
+        }
         bool acyclic = true;
-        while (!queue.empty() && acyclic) {
-            ContainerHeader* current = queue.front();
-            queue.pop_front();
-            seen.insert(current);
+        auto visit = [&seen, &toVisit](ContainerHeader* container) {
+            if (seen.insert(container).second)
+                toVisit.push_back(container);
+        };
+        while (!toVisit.empty() && acyclic) {
+            ContainerHeader* current = toVisit.back();
+            toVisit.pop_back();
             if (isAggregatingFrozenContainer(current)) {
                 ContainerHeader** subContainer = reinterpret_cast<ContainerHeader**>(current + 1);
                 for (int i = 0; i < current->objectCount(); ++i) {
-                    if (seen.count(*subContainer) == 0)
-                        queue.push_back(*subContainer++);
+                    visit(subContainer[i]);
                 }
             } else {
-              traverseContainerReferredObjects(current, [where, &queue, &acyclic, &seen](ObjHeader* obj) {
+              traverseContainerReferredObjects(current, [where, &acyclic, &visit, &isUnreachable](ObjHeader* obj) {
                 if (obj == where) {
                     acyclic = false;
                 } else {
                     auto* objContainer = obj->container();
-                    if (objContainer != nullptr && seen.count(objContainer) == 0)
-                        queue.push_back(objContainer);
+                    if (objContainer != nullptr && !isUnreachable(obj))
+                        visit(objContainer);
                 }
               });
             }
           }
         if (!acyclic) return false;
+        noteFrozenMutation(what);
     }
     UpdateHeapRef(reinterpret_cast<ObjHeader**>(
             reinterpret_cast<uintptr_t>(where) + where->type_info()->objOffsets_[index]), what);
@@ -2702,7 +3906,10 @@ void ObjHeader::destroyMetaObject(TypeInfo** location) {
 void ObjectContainer::Init(MemoryState* state, const TypeInfo* typeInfo) {
   RuntimeAssert(typeInfo->instanceSize_ >= 0, "Must be an object");
   uint32_t allocSize = sizeof(ContainerHeader) + typeInfo->instanceSize_;
-  header_ = allocContainer(state, allocSize);
+  if (state != nullptr && state->boxPool != nullptr && boxedValueSize(typeInfo) != 0)
+    header_ = allocBoxContainer(state, allocSize);
+  else
+    header_ = allocContainer(state, allocSize);
   RuntimeCheck(header_ != nullptr, "Cannot alloc memory");
   // One object in this container, no need to set.
   header_->setContainerSize(allocSize);
@@ -2835,6 +4042,9 @@ void ReleaseHeapRefStrict(const ObjHeader* object) {
 void ReleaseHeapRefRelaxed(const ObjHeader* object) {
   releaseHeapRef<false>(const_cast<ObjHeader*>(object));
 }
+void ReleaseHeapRefTracing(const ObjHeader* object) {
+  releaseTracedRef(object);
+}
 
 void DeinitInstanceBody(const TypeInfo* typeInfo, void* body) {
   deinitInstanceBody(typeInfo, body);
@@ -2879,6 +4089,9 @@ OBJ_GETTER(AllocInstanceStrict, const TypeInfo* type_info) {
 OBJ_GETTER(AllocInstanceRelaxed, const TypeInfo* type_info) {
   RETURN_RESULT_OF(allocInstance<false>, type_info);
 }
+OBJ_GETTER(AllocInstanceTracing, const TypeInfo* type_info) {
+  RETURN_RESULT_OF(allocInstanceTracing, type_info);
+}
 
 OBJ_GETTER(AllocArrayInstanceStrict, const TypeInfo* typeInfo, int32_t elements) {
   RETURN_RESULT_OF(allocArrayInstance<true>, typeInfo, elements);
@@ -2886,6 +4099,9 @@ OBJ_GETTER(AllocArrayInstanceStrict, const TypeInfo* typeInfo, int32_t elements)
 OBJ_GETTER(AllocArrayInstanceRelaxed, const TypeInfo* typeInfo, int32_t elements) {
   RETURN_RESULT_OF(allocArrayInstance<false>, typeInfo, elements);
 }
+OBJ_GETTER(AllocArrayInstanceTracing, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstanceTracing, typeInfo, elements);
+}
 
 OBJ_GETTER(InitInstanceStrict,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
@@ -2895,6 +4111,10 @@ OBJ_GETTER(InitInstanceRelaxed,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
   RETURN_RESULT_OF(initInstance<false>, location, typeInfo, ctor);
 }
+OBJ_GETTER(InitInstanceTracing,
+    ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
+  RETURN_RESULT_OF(initInstanceTracing, location, typeInfo, ctor);
+}
 
 OBJ_GETTER(InitSharedInstanceStrict,
     ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
@@ -2904,6 +4124,10 @@ OBJ_GETTER(InitSharedInstanceRelaxed,
     ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
   RETURN_RESULT_OF(initSharedInstance<false>, location, localLocation, typeInfo, ctor);
 }
+OBJ_GETTER(InitSharedInstanceTracing,
+    ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
+  RETURN_RESULT_OF(initSharedInstanceTracing, location, localLocation, typeInfo, ctor);
+}
 
 void SetStackRefStrict(ObjHeader** location, const ObjHeader* object) {
   setStackRef<true>(location, object);
@@ -2911,6 +4135,9 @@ void SetStackRefStrict(ObjHeader** location, const ObjHeader* object) {
 void SetStackRefRelaxed(ObjHeader** location, const ObjHeader* object) {
   setStackRef<false>(location, object);
 }
+void SetStackRefTracing(ObjHeader** location, const ObjHeader* object) {
+  setStackRef<true>(location, object);
+}
 
 void SetHeapRefStrict(ObjHeader** location, const ObjHeader* object) {
   setHeapRef<true>(location, object);
@@ -2918,6 +4145,9 @@ void SetHeapRefStrict(ObjHeader** location, const ObjHeader* object) {
 void SetHeapRefRelaxed(ObjHeader** location, const ObjHeader* object) {
   setHeapRef<false>(location, object);
 }
+void SetHeapRefTracing(ObjHeader** location, const ObjHeader* object) {
+  updateTracedRef(location, object);
+}
 
 void ZeroHeapRef(ObjHeader** location) {
   zeroHeapRef(location);
@@ -2929,6 +4159,9 @@ void ZeroStackRefStrict(ObjHeader** location) {
 void ZeroStackRefRelaxed(ObjHeader** location) {
   zeroStackRef<false>(location);
 }
+void ZeroStackRefTracing(ObjHeader** location) {
+  zeroStackRef<true>(location);
+}
 
 void UpdateStackRefStrict(ObjHeader** location, const ObjHeader* object) {
   updateStackRef<true>(location, object);
@@ -2936,6 +4169,9 @@ void UpdateStackRefStrict(ObjHeader** location, const ObjHeader* object) {
 void UpdateStackRefRelaxed(ObjHeader** location, const ObjHeader* object) {
   updateStackRef<false>(location, object);
 }
+void UpdateStackRefTracing(ObjHeader** location, const ObjHeader* object) {
+  updateStackRef<true>(location, object);
+}
 
 void UpdateHeapRefStrict(ObjHeader** location, const ObjHeader* object) {
   updateHeapRef<true>(location, object);
@@ -2943,6 +4179,9 @@ void UpdateHeapRefStrict(ObjHeader** location, const ObjHeader* object) {
 void UpdateHeapRefRelaxed(ObjHeader** location, const ObjHeader* object) {
   updateHeapRef<false>(location, object);
 }
+void UpdateHeapRefTracing(ObjHeader** location, const ObjHeader* object) {
+  updateTracedRef(location, object);
+}
 
 void UpdateReturnRefStrict(ObjHeader** returnSlot, const ObjHeader* value) {
   updateReturnRef<true>(returnSlot, value);
@@ -2950,6 +4189,9 @@ void UpdateReturnRefStrict(ObjHeader** returnSlot, const ObjHeader* value) {
 void UpdateReturnRefRelaxed(ObjHeader** returnSlot, const ObjHeader* value) {
   updateReturnRef<false>(returnSlot, value);
 }
+void UpdateReturnRefTracing(ObjHeader** returnSlot, const ObjHeader* value) {
+  updateReturnRef<true>(returnSlot, value);
+}
 
 void UpdateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) {
   updateHeapRefIfNull(location, object);
@@ -2978,6 +4220,9 @@ void EnterFrameStrict(ObjHeader** start, int parameters, int count) {
 void EnterFrameRelaxed(ObjHeader** start, int parameters, int count) {
   enterFrame<false>(start, parameters, count);
 }
+void EnterFrameTracing(ObjHeader** start, int parameters, int count) {
+  enterFrame<true>(start, parameters, count);
+}
 
 void LeaveFrameStrict(ObjHeader** start, int parameters, int count) {
   leaveFrame<true>(start, parameters, count);
@@ -2985,6 +4230,61 @@ void LeaveFrameStrict(ObjHeader** start, int parameters, int count) {
 void LeaveFrameRelaxed(ObjHeader** start, int parameters, int count) {
   leaveFrame<false>(start, parameters, count);
 }
+void LeaveFrameTracing(ObjHeader** start, int parameters, int count) {
+  leaveFrame<true>(start, parameters, count);
+}
+
+void AddGlobalRoot(ObjHeader** location) {
+#if USE_GC
+  addGlobalRoot(location);
+#endif
+}
+
+bool IsIdleTrimEnabled() {
+  return atomicGet(&g_idleTrimIntervalMillis) != 0;
+}
+
+void TrimMemoryIfIdle() {
+  trimMemoryIfIdle(memoryState);
+}
+
+void ExchangeRemoteFrees() {
+  if (::memoryState != nullptr)
+    exchangeRemoteFrees(::memoryState);
+}
+
+void EnterSafeRegion() {
+#if USE_GC
+  if (!IsStrictMemoryModel && ::memoryState != nullptr)
+    enterSafeRegion(::memoryState);
+#endif
+}
+
+void LeaveSafeRegion() {
+#if USE_GC
+  if (!IsStrictMemoryModel && ::memoryState != nullptr)
+    leaveSafeRegion(::memoryState);
+#endif
+}
+
+int32_t LeaveSafeRegionsOnEntry() {
+#if USE_GC
+  if (IsStrictMemoryModel) return 0;
+  // A thread without memory state is running foreign code, and if Kotlin code attaches it,
+  // it shall get back to a safe region on return.
+  if (::memoryState == nullptr) return 1;
+  return leaveAllSafeRegions(::memoryState);
+#else
+  return 0;
+#endif
+}
+
+void RestoreSafeRegionsOnExit(int32_t depth) {
+#if USE_GC
+  if (!IsStrictMemoryModel && ::memoryState != nullptr)
+    restoreSafeRegions(::memoryState, depth);
+#endif
+}
 
 void Kotlin_native_internal_GC_collect(KRef) {
 #if USE_GC
@@ -3058,6 +4358,50 @@ KBoolean Kotlin_native_internal_GC_getTuneThreshold(KRef) {
 #endif
 }
 
+KInt Kotlin_native_internal_GC_getBoxPoolCapacity(KRef) {
+  return memoryState->boxPoolCapacity;
+}
+
+void Kotlin_native_internal_GC_setBoxPoolCapacity(KRef, KInt value) {
+  memoryState->boxPoolCapacity = value;
+  trimBoxPool(memoryState, value);
+}
+
+void Kotlin_native_internal_GC_trimMemory(KRef) {
+#if USE_GC
+  garbageCollect();
+#endif
+  trimMemory(memoryState);
+}
+
+KLong Kotlin_native_internal_GC_getIdleTrimInterval(KRef) {
+  return atomicGet(&g_idleTrimIntervalMillis);
+}
+
+void Kotlin_native_internal_GC_setIdleTrimInterval(KRef, KLong value) {
+  atomicSet(&g_idleTrimIntervalMillis, clampTrimInterval(value));
+}
+
+KLong Kotlin_native_internal_GC_getResidentMemory(KRef) {
+  return konan::residentMemorySize();
+}
+
+KLong Kotlin_native_internal_GC_getPeakResidentMemory(KRef) {
+  return konan::peakResidentMemorySize();
+}
+
+KInt Kotlin_native_internal_Debugging_getPrunedAcyclicityChecks(KRef) {
+  return atomicGet(&prunedAcyclicityChecks);
+}
+
+KInt Kotlin_native_internal_Debugging_getMemoryTrims(KRef) {
+  return atomicGet(&memoryTrims);
+}
+
+KInt Kotlin_native_internal_Debugging_getReusedBoxes(KRef) {
+  return memoryState->reusedBoxes;
+}
+
 OBJ_GETTER(Kotlin_native_internal_GC_detectCycles, KRef) {
   if (!KonanNeedDebugInfo || !g_checkLeaks) RETURN_OBJ(nullptr);
   RETURN_RESULT_OF0(detectCyclicReferences);
@@ -3075,6 +4419,14 @@ void DisposeStablePointer(KNativePtr pointer) {
   disposeStablePointer(pointer);
 }
 
+void CreateStablePointers(KRef const* objects, KInt count, KNativePtr* destination) {
+  createStablePointers(objects, count, destination);
+}
+
+void DisposeStablePointers(KNativePtr const* pointers, KInt count) {
+  disposeStablePointers(pointers, count);
+}
+
 OBJ_GETTER(DerefStablePointer, KNativePtr pointer) {
   RETURN_RESULT_OF(derefStablePointer, pointer);
 }
@@ -3091,6 +4443,10 @@ void FreezeSubgraph(ObjHeader* root) {
   freezeSubgraph(root);
 }
 
+void FreezeSubgraphDeduplicating(ObjHeader* root) {
+  freezeSubgraphDeduplicating(root);
+}
+
 // This function is called from field mutators to check if object's header is frozen.
 // If object is frozen or permanent, an exception is thrown.
 void MutationCheck(ObjHeader* obj) {
@@ -3103,6 +4459,10 @@ void EnsureNeverFrozen(ObjHeader* object) {
   ensureNeverFrozen(object);
 }
 
+void NoteFrozenMutation(ObjHeader* value) {
+  noteFrozenMutation(value);
+}
+
 KBoolean Konan_ensureAcyclicAndSet(ObjHeader* where, KInt index, ObjHeader* what) {
   return ensureAcyclicAndSet(where, index, what);
 }
@@ -137,6 +137,18 @@ struct ContainerHeader {
 #endif
   }
 
+  template <bool Atomic>
+  inline void incRefCount(int count) {
+#ifdef KONAN_NO_THREADS
+    refCount_ += count * CONTAINER_TAG_INCREMENT;
+#else
+    if (Atomic)
+      __sync_add_and_fetch(&refCount_, count * CONTAINER_TAG_INCREMENT);
+    else
+      refCount_ += count * CONTAINER_TAG_INCREMENT;
+#endif
+  }
+
   template <bool Atomic>
   inline bool tryIncRefCount() {
     if (Atomic) {
@@ -253,6 +265,21 @@ struct ContainerHeader {
     objectCount_ &= ~CONTAINER_TAG_GC_BUFFERED;
   }
 
+  // Colors container purple and buffers it, unless it is acyclic or already buffered. Safe to call
+  // concurrently on a shared container, only one caller gets true and shall remember it as a cycle root.
+  inline bool tryBufferAsPurple() {
+    while (true) {
+      uint32_t current = objectCount_;
+      if ((current & CONTAINER_TAG_GC_BUFFERED) != 0 ||
+          (current & CONTAINER_TAG_GC_COLOR_MASK) == CONTAINER_TAG_GC_GREEN)
+        return false;
+      uint32_t updated =
+          (current & ~CONTAINER_TAG_GC_COLOR_MASK) | CONTAINER_TAG_GC_PURPLE | CONTAINER_TAG_GC_BUFFERED;
+      if (compareAndSet(&objectCount_, current, updated))
+        return true;
+    }
+  }
+
   inline bool marked() const {
     return (objectCount_ & CONTAINER_TAG_GC_MARKED) != 0;
   }
@@ -324,6 +351,9 @@ struct MetaObjHeader {
 
   // Flags for the object state.
   int32_t flags_;
+  // Freeze epoch, stamped on some frozen objects to speed up acyclicity checks, 0 if unknown.
+  // Fits into the padding after the flags on 64-bit targets.
+  int32_t freezeEpoch_;
 
   // TODO: maybe make it a union for the orthogonal features.
   struct {
@@ -419,7 +449,8 @@ extern "C" {
 #define MODEL_VARIANTS(returnType, name, ...)            \
    returnType name(__VA_ARGS__) RUNTIME_NOTHROW;         \
    returnType name##Strict(__VA_ARGS__) RUNTIME_NOTHROW; \
-   returnType name##Relaxed(__VA_ARGS__) RUNTIME_NOTHROW;
+   returnType name##Relaxed(__VA_ARGS__) RUNTIME_NOTHROW; \
+   returnType name##Tracing(__VA_ARGS__) RUNTIME_NOTHROW;
 #define RETURN_OBJ(value) { ObjHeader* __obj = value; \
     UpdateReturnRef(OBJ_RESULT, __obj);               \
     return __obj; }
@@ -454,16 +485,20 @@ void ResumeMemory(MemoryState* state);
 //
 OBJ_GETTER(AllocInstanceStrict, const TypeInfo* type_info) RUNTIME_NOTHROW;
 OBJ_GETTER(AllocInstanceRelaxed, const TypeInfo* type_info) RUNTIME_NOTHROW;
+OBJ_GETTER(AllocInstanceTracing, const TypeInfo* type_info) RUNTIME_NOTHROW;
 OBJ_GETTER(AllocInstance, const TypeInfo* type_info) RUNTIME_NOTHROW;
 
 OBJ_GETTER(AllocArrayInstanceStrict, const TypeInfo* type_info, int32_t elements);
 OBJ_GETTER(AllocArrayInstanceRelaxed, const TypeInfo* type_info, int32_t elements);
+OBJ_GETTER(AllocArrayInstanceTracing, const TypeInfo* type_info, int32_t elements);
 OBJ_GETTER(AllocArrayInstance, const TypeInfo* type_info, int32_t elements);
 
 OBJ_GETTER(InitInstanceStrict,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 OBJ_GETTER(InitInstanceRelaxed,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
+OBJ_GETTER(InitInstanceTracing,
+    ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 OBJ_GETTER(InitInstance,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 
@@ -471,6 +506,8 @@ OBJ_GETTER(InitSharedInstanceStrict,
     ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 OBJ_GETTER(InitSharedInstanceRelaxed,
     ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
+OBJ_GETTER(InitSharedInstanceTracing,
+    ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 OBJ_GETTER(InitSharedInstance,
     ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 
@@ -502,6 +539,8 @@ void WeakReferenceCounterClear(ObjHeader* counter);
 
 // Controls the current memory model, is compile-time constant.
 extern const bool IsStrictMemoryModel;
+// Set for the tracing memory model, where only references held by C++ code, like stable pointers, are counted.
+extern const bool IsTracingMemoryModel;
 
 // Sets stack location.
 MODEL_VARIANTS(void, SetStackRef, ObjHeader** location, const ObjHeader* object);
@@ -538,6 +577,10 @@ bool ClearSubgraphReferences(ObjHeader* root, bool checked) RUNTIME_NOTHROW;
 void* CreateStablePointer(ObjHeader* obj) RUNTIME_NOTHROW;
 // Disposes stable pointer to the object.
 void DisposeStablePointer(void* pointer) RUNTIME_NOTHROW;
+// Creates stable pointers out of [count] objects, storing them to [destination].
+void CreateStablePointers(ObjHeader* const* objects, int32_t count, void** destination) RUNTIME_NOTHROW;
+// Disposes [count] stable pointers at once.
+void DisposeStablePointers(void* const* pointers, int32_t count) RUNTIME_NOTHROW;
 // Translate stable pointer to object reference.
 OBJ_GETTER(DerefStablePointer, void*) RUNTIME_NOTHROW;
 // Move stable pointer ownership.
@@ -546,14 +589,38 @@ OBJ_GETTER(AdoptStablePointer, void*) RUNTIME_NOTHROW;
 void MutationCheck(ObjHeader* obj);
 // Freeze object subgraph.
 void FreezeSubgraph(ObjHeader* obj);
+// Freeze object subgraph, making references to equal strings, boxes and primitive arrays point to the same object.
+void FreezeSubgraphDeduplicating(ObjHeader* obj);
 // Ensure this object shall block freezing.
 void EnsureNeverFrozen(ObjHeader* obj);
+// Must be called before a reference to `value` is stored into an already frozen object.
+void NoteFrozenMutation(ObjHeader* value) RUNTIME_NOTHROW;
 // Add TLS object storage, called by the generated code.
 void AddTLSRecord(MemoryState* memory, void** key, int size) RUNTIME_NOTHROW;
 // Clear TLS object storage, called by the generated code.
 void ClearTLSRecord(MemoryState* memory, void** key) RUNTIME_NOTHROW;
+// Registers static storage of an object reference as a root, called by the generated code.
+// Only needed by the tracing memory model.
+void AddGlobalRoot(ObjHeader** location) RUNTIME_NOTHROW;
 // Lookup element in TLS object storage.
 ObjHeader** LookupTLS(void** key, int index) RUNTIME_NOTHROW;
+// Called before the current thread blocks outside of Kotlin code, or calls foreign code, so that
+// a stop-the-world collection need not wait for it. Safe regions nest. No object references shall be touched until the matching LeaveSafeRegion().
+void EnterSafeRegion() RUNTIME_NOTHROW;
+// Called once the thread resumes, waits for the stop-the-world collection in progress, if any.
+void LeaveSafeRegion() RUNTIME_NOTHROW;
+// Called by the generated code on entry to Kotlin from foreign code, which runs in a safe region.
+// Returns the value to be passed to RestoreSafeRegionsOnExit() on return to foreign code.
+int32_t LeaveSafeRegionsOnEntry() RUNTIME_NOTHROW;
+void RestoreSafeRegionsOnExit(int32_t depth) RUNTIME_NOTHROW;
+// Returns memory cached by the allocator to the OS, if automatic trimming is enabled and it was not
+// done recently. Called when the current thread runs out of work.
+void TrimMemoryIfIdle() RUNTIME_NOTHROW;
+// Whether TrimMemoryIfIdle() may do anything at all, so callers can skip checking for idleness.
+bool IsIdleTrimEnabled() RUNTIME_NOTHROW;
+// Frees memory released by other threads in the allocator heap of the current thread, and hands over
+// memory of other heaps released by the current thread to their owners. Called before waiting for work.
+void ExchangeRemoteFrees() RUNTIME_NOTHROW;
 
 #ifdef __cplusplus
 }
@@ -601,14 +668,15 @@ class ObjHolder {
    ObjHeader* obj_;
 };
 
+// Exception object is held as a stable pointer, as heap references are not counted in tracing memory model.
 class ExceptionObjHolder {
  public:
-   explicit ExceptionObjHolder(const ObjHeader* obj) {
-     ::SetHeapRef(&obj_, obj);
+   explicit ExceptionObjHolder(const ObjHeader* obj) : obj_(const_cast<ObjHeader*>(obj)) {
+     CreateStablePointer(obj_);
    }
 
    ~ExceptionObjHolder() {
-     ZeroHeapRef(&obj_);
+     DisposeStablePointer(obj_);
    }
 
    ObjHeader* obj() { return obj_; }
@@ -619,6 +687,18 @@ class ExceptionObjHolder {
    ObjHeader* obj_;
 };
 
+// Class keeping the current thread in a safe region during C++ scope.
+class SafeRegion {
+ public:
+   SafeRegion() {
+     EnterSafeRegion();
+   }
+
+   ~SafeRegion() {
+     LeaveSafeRegion();
+   }
+};
+
 class ForeignRefManager;
 typedef ForeignRefManager* ForeignRefContext;
 
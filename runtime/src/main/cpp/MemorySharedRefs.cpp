@@ -25,6 +25,9 @@ ObjHeader* KRefSharedHolder::ref() const {
   return obj_;
 }
 
+// Runs on every dereference of a StableRef passed to C, e.g. in each callback of an event loop.
+// With the runtime up it is a thread-local check and a comparison of the foreign ref manager, so frozen
+// objects are not checked first: that would add a container load to the common owner thread case.
 static inline void ensureForeignRefAccessible(ObjHeader* object, ForeignRefContext context) {
   if (!Kotlin_hasRuntime()) {
     // So the object is either unowned or shared.
@@ -66,6 +66,14 @@ void Kotlin_interop_free(void* ptr) {
   konan::free(ptr);
 }
 
+void Kotlin_interop_memset(void* ptr, KInt value, KLong size) {
+  memset(ptr, value, size);
+}
+
+void Kotlin_interop_memcpy(void* dest, const void* src, KLong size) {
+  memcpy(dest, src, size);
+}
+
 void Kotlin_system_exitProcess(KInt status) {
   konan::exit(status);
 }
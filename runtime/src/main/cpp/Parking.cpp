@@ -0,0 +1,135 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef KONAN_NO_THREADS
+#define WITH_THREADS 1
+#endif
+
+#if WITH_THREADS
+#if KONAN_LINUX || KONAN_ANDROID
+#define WITH_FUTEX 1
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <pthread.h>
+#include <sys/time.h>
+#endif
+#endif  // WITH_THREADS
+
+#include "Atomic.h"
+#include "Parking.h"
+
+namespace {
+
+constexpr int64_t kNanosPerSecond = 1000000000LL;
+
+#if WITH_FUTEX
+
+bool parkImpl(volatile int32_t* address, int32_t expectedValue, int64_t timeoutNanos) {
+  struct timespec timeout;
+  if (timeoutNanos >= 0) {
+    timeout.tv_sec = timeoutNanos / kNanosPerSecond;
+    timeout.tv_nsec = timeoutNanos % kNanosPerSecond;
+  }
+  // The kernel compares the value and blocks atomically; EAGAIN means the value has already changed.
+  long result = syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expectedValue,
+                        timeoutNanos >= 0 ? &timeout : nullptr, nullptr, 0);
+  return result == 0 || errno != ETIMEDOUT;
+}
+
+void unparkImpl(volatile int32_t* address, bool all) {
+  syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, all ? INT32_MAX : 1, nullptr, nullptr, 0);
+}
+
+#elif WITH_THREADS
+
+// Without futexes, threads are parked on condition variables of a fixed set of buckets the addresses are
+// hashed to. Threads parked on different addresses may share a bucket, so unparking always wakes up
+// the whole bucket, and the others just find their values unchanged and park again.
+class ParkingBucket {
+ public:
+  ParkingBucket() {
+    pthread_mutex_init(&lock_, nullptr);
+    pthread_cond_init(&cond_, nullptr);
+  }
+
+  bool park(volatile int32_t* address, int32_t expectedValue, int64_t timeoutNanos) {
+    bool result = true;
+    pthread_mutex_lock(&lock_);
+    // UnparkThreads() takes the bucket lock after changing the value, so it cannot be missed here.
+    if (atomicGet(address) == expectedValue) {
+      waiters_++;
+      if (timeoutNanos < 0) {
+        pthread_cond_wait(&cond_, &lock_);
+      } else {
+        struct timeval tv;
+        struct timespec ts;
+        gettimeofday(&tv, nullptr);
+        int64_t deadline = tv.tv_sec * kNanosPerSecond + tv.tv_usec * 1000LL + timeoutNanos;
+        ts.tv_sec = deadline / kNanosPerSecond;
+        ts.tv_nsec = deadline % kNanosPerSecond;
+        result = pthread_cond_timedwait(&cond_, &lock_, &ts) == 0;
+      }
+      waiters_--;
+    }
+    pthread_mutex_unlock(&lock_);
+    return result;
+  }
+
+  void unparkAll() {
+    pthread_mutex_lock(&lock_);
+    if (waiters_ > 0)
+      pthread_cond_broadcast(&cond_);
+    pthread_mutex_unlock(&lock_);
+  }
+
+ private:
+  pthread_mutex_t lock_;
+  pthread_cond_t cond_;
+  int waiters_ = 0;
+};
+
+constexpr size_t kParkingBucketCount = 64;
+
+ParkingBucket parkingBuckets[kParkingBucketCount];
+
+ParkingBucket& bucketFor(volatile int32_t* address) {
+  uintptr_t hash = reinterpret_cast<uintptr_t>(address);
+  hash ^= hash >> 4;
+  hash ^= hash >> 12;
+  return parkingBuckets[hash % kParkingBucketCount];
+}
+
+bool parkImpl(volatile int32_t* address, int32_t expectedValue, int64_t timeoutNanos) {
+  return bucketFor(address).park(address, expectedValue, timeoutNanos);
+}
+
+void unparkImpl(volatile int32_t* address, bool all) {
+  bucketFor(address).unparkAll();
+}
+
+#else  // !WITH_THREADS
+
+// There is nobody to unpark us, so never block.
+bool parkImpl(volatile int32_t* address, int32_t expectedValue, int64_t timeoutNanos) {
+  return timeoutNanos < 0;
+}
+
+void unparkImpl(volatile int32_t* address, bool all) {}
+
+#endif  // WITH_THREADS
+
+}  // namespace
+
+bool ParkThreadIfEquals(volatile int32_t* address, int32_t expectedValue, int64_t timeoutNanos) {
+  return parkImpl(address, expectedValue, timeoutNanos);
+}
+
+void UnparkThreads(volatile int32_t* address, bool all) {
+  unparkImpl(address, all);
+}
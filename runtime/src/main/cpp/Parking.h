@@ -0,0 +1,21 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_PARKING_H
+#define RUNTIME_PARKING_H
+
+#include "Common.h"
+#include "Types.h"
+
+// Blocks the calling thread while `*address == expectedValue`, until another thread calls
+// UnparkThreads() with the same address or `timeoutNanos` elapse (negative means no timeout).
+// The check and the block are atomic with respect to UnparkThreads(). May return spuriously.
+// Returns false if the timeout has elapsed.
+bool ParkThreadIfEquals(volatile int32_t* address, int32_t expectedValue, int64_t timeoutNanos);
+
+// Wakes up one (or all, if `all` is true) threads parked on `address`.
+void UnparkThreads(volatile int32_t* address, bool all);
+
+#endif // RUNTIME_PARKING_H
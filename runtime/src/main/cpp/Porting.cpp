@@ -29,6 +29,14 @@
 #if KONAN_WINDOWS
 #include <windows.h>
 #endif
+#if KONAN_LINUX || KONAN_ANDROID
+#include <fcntl.h>
+#include <sys/resource.h>
+#endif
+#if KONAN_OBJC_INTEROP
+#include <mach/mach.h>
+#include <sys/resource.h>
+#endif
 
 #include <chrono>
 
@@ -213,11 +221,17 @@ size_t strnlen(const char* buffer, size_t maxSize) {
 #if KONAN_INTERNAL_DLMALLOC
 extern "C" void* dlcalloc(size_t, size_t);
 extern "C" void dlfree(void*);
+extern "C" int dlmalloc_trim(size_t);
 #define calloc_impl dlcalloc
 #define free_impl dlfree
 #else
 extern "C" void* konan_calloc_impl(size_t, size_t);
 extern "C" void konan_free_impl(void*);
+extern "C" void* konan_heap_create_impl();
+extern "C" void konan_heap_destroy_impl(void*);
+extern "C" void* konan_heap_calloc_impl(void*, size_t, size_t);
+extern "C" void* konan_heap_of_impl(void*);
+extern "C" void konan_trim_impl(void*);
 #define calloc_impl konan_calloc_impl
 #define free_impl konan_free_impl
 #endif
@@ -230,6 +244,94 @@ void free(void* pointer) {
   free_impl(pointer);
 }
 
+#if KONAN_INTERNAL_DLMALLOC
+void* createHeap() {
+  return nullptr;
+}
+
+void destroyHeap(void* heap) {}
+
+void* callocInHeap(void* heap, size_t count, size_t size) {
+  return calloc_impl(count, size);
+}
+
+void* heapOf(void* pointer) {
+  return nullptr;
+}
+
+// Note that memory grown by moreCore() on wasm cannot be returned.
+void trimMemory(void* heap) {
+  dlmalloc_trim(0);
+}
+#else
+void* createHeap() {
+  return konan_heap_create_impl();
+}
+
+void destroyHeap(void* heap) {
+  konan_heap_destroy_impl(heap);
+}
+
+void* callocInHeap(void* heap, size_t count, size_t size) {
+  return konan_heap_calloc_impl(heap, count, size);
+}
+
+void* heapOf(void* pointer) {
+  return konan_heap_of_impl(pointer);
+}
+
+void trimMemory(void* heap) {
+  konan_trim_impl(heap);
+}
+#endif
+
+int64_t residentMemorySize() {
+#if KONAN_LINUX || KONAN_ANDROID
+  // Second field of statm is the number of resident pages.
+  int file = ::open("/proc/self/statm", O_RDONLY);
+  if (file < 0) return -1;
+  char buffer[128];
+  auto length = ::read(file, buffer, sizeof(buffer) - 1);
+  ::close(file);
+  if (length <= 0) return -1;
+  buffer[length] = 0;
+  long long size = 0, resident = 0;
+  if (sscanf(buffer, "%lld %lld", &size, &resident) != 2) return -1;
+  return resident * sysconf(_SC_PAGESIZE);
+#elif KONAN_OBJC_INTEROP
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    return -1;
+  return info.resident_size;
+#else
+  return -1;
+#endif
+}
+
+int64_t peakResidentMemorySize() {
+#if KONAN_LINUX || KONAN_ANDROID || KONAN_OBJC_INTEROP
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#if KONAN_OBJC_INTEROP
+  return usage.ru_maxrss;
+#else
+  // Reported in kilobytes on Linux.
+  return usage.ru_maxrss * 1024LL;
+#endif
+#else
+  return -1;
+#endif
+}
+
+const char* getenv(const char* name) {
+#if KONAN_WASM || KONAN_ZEPHYR
+  return nullptr;
+#else
+  return ::getenv(name);
+#endif
+}
+
 #if KONAN_INTERNAL_NOW
 
 #ifdef KONAN_ZEPHYR
@@ -76,6 +76,21 @@ void *memset(void *b, int c, size_t len);
 // Memory operations.
 void* calloc(size_t count, size_t size);
 void free(void* ptr);
+// Thread local heaps, if supported by the allocator, otherwise createHeap() returns nullptr.
+// Heap can only be allocated from by its thread, while memory could be freed by any thread.
+void* createHeap();
+void destroyHeap(void* heap);
+void* callocInHeap(void* heap, size_t count, size_t size);
+// Heap the memory was allocated in, nullptr if none. May be stale if the heap is concurrently destroyed.
+void* heapOf(void* pointer);
+// Returns memory cached by the allocator, including the given thread local heap, to the OS where possible.
+void trimMemory(void* heap);
+// Resident set size of the process and its peak, in bytes, or -1 if unknown on the platform.
+int64_t residentMemorySize();
+int64_t peakResidentMemorySize();
+
+// Environment variable value, nullptr if not set or unsupported on the platform.
+const char* getenv(const char* name);
 
 // Time operations.
 uint64_t getTimeMillis();
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include <string.h>
+
+#include "Atomic.h"
+#include "Common.h"
+#include "Exceptions.h"
+#include "Memory.h"
+#include "Natives.h"
+#include "Porting.h"
+#include "Types.h"
+
+// The default random generator: xoshiro256** (http://prng.di.unimi.it/) with a separate state
+// per thread, so that workers neither contend on the state nor share the sequence.
+
+namespace {
+
+struct RandomState {
+  uint64_t s[4];
+  bool seeded;
+};
+
+THREAD_LOCAL_VARIABLE RandomState randomState;
+
+volatile int64_t seedCounter = 0;
+
+ALWAYS_INLINE inline uint64_t rotl(uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+// SplitMix64, as recommended by the xoshiro authors for turning a single seed into the state.
+uint64_t splitMix64(uint64_t* x) {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+NO_INLINE void seed(RandomState* state) {
+  // Threads started at the same time get different seeds thanks to the counter and the state address.
+  uint64_t seed = konan::getTimeNanos() ^ reinterpret_cast<uintptr_t>(state) ^
+      (static_cast<uint64_t>(atomicAdd(&seedCounter, static_cast<int64_t>(1))) << 32);
+  for (int i = 0; i < 4; i++) {
+    state->s[i] = splitMix64(&seed);
+  }
+  state->seeded = true;
+}
+
+ALWAYS_INLINE inline RandomState* currentState() {
+  RandomState* state = &randomState;
+  if (!state->seeded) seed(state);
+  return state;
+}
+
+ALWAYS_INLINE inline uint64_t next(RandomState* state) {
+  uint64_t* s = state->s;
+  const uint64_t result = rotl(s[1] * 5, 7) * 9;
+  const uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 45);
+  return result;
+}
+
+ALWAYS_INLINE inline KDouble toDouble(uint64_t bits) {
+  // The upper 53 bits scaled to [0, 1).
+  return (bits >> 11) * (1.0 / (1ULL << 53));
+}
+
+ALWAYS_INLINE inline void mutabilityCheck(KConstRef thiz) {
+  if (!thiz->local() && thiz->container()->frozen()) {
+    ThrowInvalidMutabilityException(thiz);
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+KLong Kotlin_Random_nextLong() {
+  return next(currentState());
+}
+
+KDouble Kotlin_Random_nextDouble() {
+  return toDouble(next(currentState()));
+}
+
+// Bulk generation: indices are checked on the Kotlin side.
+
+void Kotlin_Random_fillBytes(KRef array, KInt fromIndex, KInt toIndex) {
+  mutabilityCheck(array);
+  RandomState* state = currentState();
+  uint8_t* data = PrimitiveArrayAddressOfElementAt<uint8_t>(array->array(), fromIndex);
+  KInt count = toIndex - fromIndex;
+  while (count >= 8) {
+    uint64_t bits = next(state);
+    memcpy(data, &bits, 8);
+    data += 8;
+    count -= 8;
+  }
+  if (count > 0) {
+    uint64_t bits = next(state);
+    memcpy(data, &bits, count);
+  }
+}
+
+void Kotlin_Random_fillInts(KRef array, KInt fromIndex, KInt toIndex) {
+  mutabilityCheck(array);
+  RandomState* state = currentState();
+  KInt* data = PrimitiveArrayAddressOfElementAt<KInt>(array->array(), 0);
+  KInt index = fromIndex;
+  for (; index + 1 < toIndex; index += 2) {
+    uint64_t bits = next(state);
+    data[index] = static_cast<KInt>(bits >> 32);
+    data[index + 1] = static_cast<KInt>(bits);
+  }
+  if (index < toIndex) {
+    data[index] = static_cast<KInt>(next(state) >> 32);
+  }
+}
+
+void Kotlin_Random_fillDoubles(KRef array, KInt fromIndex, KInt toIndex) {
+  mutabilityCheck(array);
+  RandomState* state = currentState();
+  KDouble* data = PrimitiveArrayAddressOfElementAt<KDouble>(array->array(), 0);
+  for (KInt index = fromIndex; index < toIndex; index++) {
+    data[index] = toDouble(next(state));
+  }
+}
+
+}  // extern "C"
@@ -109,6 +109,8 @@ RuntimeState* initRuntime() {
 
 void deinitRuntime(RuntimeState* state) {
   ResumeMemory(state->memoryState);
+  // Threads attached by foreign code exit from a safe region, while deinitialization runs Kotlin code.
+  LeaveSafeRegionsOnEntry();
   bool lastRuntime = atomicAdd(&aliveRuntimesCount, -1) == 0;
   InitOrDeinitGlobalVariables(DEINIT_THREAD_LOCAL_GLOBALS, state->memoryState);
   if (lastRuntime)
@@ -138,6 +140,7 @@ void AppendToInitializersTail(InitNode *next) {
   initTailNode = next;
 }
 
+// Called on entries from C, so the initialized case is kept to a single thread-local check.
 void Kotlin_initRuntimeIfNeeded() {
   if (!isValidRuntime()) {
     initRuntime();
@@ -256,7 +259,7 @@ KInt Konan_Platform_getCpuArchitecture() {
 }
 
 KInt Konan_Platform_getMemoryModel() {
-  return IsStrictMemoryModel ? 0 : 1;
+  return IsTracingMemoryModel ? 2 : (IsStrictMemoryModel ? 0 : 1);
 }
 
 KBoolean Konan_Platform_isDebugBinary() {
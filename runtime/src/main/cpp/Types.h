@@ -86,19 +86,28 @@ extern "C" {
 extern const TypeInfo* theAnyTypeInfo;
 extern const TypeInfo* theArrayTypeInfo;
 extern const TypeInfo* theBooleanArrayTypeInfo;
+extern const TypeInfo* theBooleanBoxTypeInfo;
 extern const TypeInfo* theByteArrayTypeInfo;
+extern const TypeInfo* theByteBoxTypeInfo;
 extern const TypeInfo* theCharArrayTypeInfo;
+extern const TypeInfo* theCharBoxTypeInfo;
 extern const TypeInfo* theDoubleArrayTypeInfo;
+extern const TypeInfo* theDoubleBoxTypeInfo;
 extern const TypeInfo* theForeignObjCObjectTypeInfo;
 extern const TypeInfo* theIntArrayTypeInfo;
+extern const TypeInfo* theIntBoxTypeInfo;
 extern const TypeInfo* theLongArrayTypeInfo;
+extern const TypeInfo* theLongBoxTypeInfo;
 extern const TypeInfo* theNativePtrArrayTypeInfo;
 extern const TypeInfo* theFloatArrayTypeInfo;
+extern const TypeInfo* theFloatBoxTypeInfo;
 extern const TypeInfo* theForeignObjCObjectTypeInfo;
 extern const TypeInfo* theFreezableAtomicReferenceTypeInfo;
+extern const TypeInfo* theFreezeAwareLazyImplTypeInfo;
 extern const TypeInfo* theObjCObjectWrapperTypeInfo;
 extern const TypeInfo* theOpaqueFunctionTypeInfo;
 extern const TypeInfo* theShortArrayTypeInfo;
+extern const TypeInfo* theShortBoxTypeInfo;
 extern const TypeInfo* theStringTypeInfo;
 extern const TypeInfo* theThrowableTypeInfo;
 extern const TypeInfo* theUnitTypeInfo;
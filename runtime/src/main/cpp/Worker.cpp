@@ -208,10 +208,15 @@ class Future {
   }
 
   OBJ_GETTER0(consumeResultUnlocked) {
-    Locker locker(&lock_);
-    while (state_ == SCHEDULED) {
-      pthread_cond_wait(&cond_, &lock_);
+    {
+      // Waiting for the result may take long, do not hold off stop-the-world collections meanwhile.
+      SafeRegion safeRegion;
+      Locker locker(&lock_);
+      while (state_ == SCHEDULED) {
+        pthread_cond_wait(&cond_, &lock_);
+      }
     }
+    Locker locker(&lock_);
     // TODO: maybe use message from exception?
     if (state_ == THROWN)
         ThrowIllegalStateException();
@@ -398,6 +403,8 @@ class State {
   }
 
   KBoolean waitForAnyFuture(KInt version, KInt millis) {
+    // Same as in Future::consumeResultUnlocked().
+    SafeRegion safeRegion;
     Locker locker(&lock_);
     if (version != currentVersion_) return false;
 
@@ -730,6 +737,7 @@ void Worker::putDelayedJob(Job job) {
 }
 
 bool Worker::waitDelayed(bool blocking) {
+  SafeRegion safeRegion;
   Locker locker(&lock_);
   if (delayed_.size() == 0) return false;
   if (blocking) waitForQueueLocked(-1, nullptr);
@@ -737,6 +745,19 @@ bool Worker::waitDelayed(bool blocking) {
 }
 
 Job Worker::getJob(bool blocking) {
+  // Memory released by the other threads must not wait for this worker to allocate again.
+  ExchangeRemoteFrees();
+  if (blocking && IsIdleTrimEnabled()) {
+    bool idle;
+    {
+      Locker locker(&lock_);
+      idle = queue_.size() == 0;
+    }
+    // Worker waiting for jobs is a good moment to return unused memory to the OS.
+    if (idle) TrimMemoryIfIdle();
+  }
+  // Same as in Future::consumeResultUnlocked().
+  SafeRegion safeRegion;
   Locker locker(&lock_);
   RuntimeAssert(!terminated_, "Must not be terminated");
   if (queue_.size() == 0 && !blocking) return Job { .kind = JOB_NONE };
@@ -803,6 +824,7 @@ bool Worker::waitForQueueLocked(KLong timeoutMicroseconds, KLong* remaining) {
 
 bool Worker::park(KLong timeoutMicroseconds, bool process) {
   {
+    SafeRegion safeRegion;
     Locker locker(&lock_);
     if (terminated_) {
       return false;
@@ -946,6 +968,11 @@ void Kotlin_Worker_freezeInternal(KRef object) {
     FreezeSubgraph(object);
 }
 
+void Kotlin_Worker_freezeDeduplicatingInternal(KRef object) {
+  if (object != nullptr)
+    FreezeSubgraphDeduplicating(object);
+}
+
 KBoolean Kotlin_Worker_isFrozenInternal(KRef object) {
   return object == nullptr || isPermanentOrFrozen(object);
 }
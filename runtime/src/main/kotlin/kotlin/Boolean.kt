@@ -6,12 +6,14 @@
 package kotlin
 
 import kotlin.native.internal.TypedIntrinsic
+import kotlin.native.internal.ExportTypeInfo
 import kotlin.native.internal.IntrinsicType
 
 /**
  * Represents a value which is either `true` or `false`. On the JVM, non-nullable values of this type are
  * represented as values of the primitive type `boolean`.
  */
+@ExportTypeInfo("theBooleanBoxTypeInfo")
 public class Boolean private constructor() : Comparable<Boolean> {
 
     @SinceKotlin("1.3")
@@ -7,11 +7,13 @@
 package kotlin
 
 import kotlin.native.internal.TypedIntrinsic
+import kotlin.native.internal.ExportTypeInfo
 import kotlin.native.internal.IntrinsicType
 
 /**
  * Represents a 16-bit Unicode character.
  */
+@ExportTypeInfo("theCharBoxTypeInfo")
 public class Char private constructor() : Comparable<Char> {
     /**
      * Compares this value with the specified value for order.
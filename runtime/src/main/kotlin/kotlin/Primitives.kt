@@ -8,6 +8,7 @@
 package kotlin
 
 import kotlin.native.internal.CanBePrecreated
+import kotlin.native.internal.ExportTypeInfo
 import kotlin.native.internal.IntrinsicType
 import kotlin.native.internal.NumberConverter
 import kotlin.native.internal.TypedIntrinsic
@@ -15,6 +16,7 @@ import kotlin.native.internal.TypedIntrinsic
 /**
  * Represents a 8-bit signed integer.
  */
+@ExportTypeInfo("theByteBoxTypeInfo")
 public final class Byte private constructor() : Number(), Comparable<Byte> {
     @CanBePrecreated
     companion object {
@@ -284,6 +286,7 @@ public final class Byte private constructor() : Number(), Comparable<Byte> {
 /**
  * Represents a 16-bit signed integer.
  */
+@ExportTypeInfo("theShortBoxTypeInfo")
 public final class Short private constructor() : Number(), Comparable<Short> {
     @CanBePrecreated
     companion object {
@@ -552,6 +555,7 @@ public final class Short private constructor() : Number(), Comparable<Short> {
 /**
  * Represents a 32-bit signed integer.
  */
+@ExportTypeInfo("theIntBoxTypeInfo")
 public final class Int private constructor() : Number(), Comparable<Int> {
     @CanBePrecreated
     companion object {
@@ -846,6 +850,7 @@ public final class Int private constructor() : Number(), Comparable<Int> {
 /**
  * Represents a 64-bit signed integer.
  */
+@ExportTypeInfo("theLongBoxTypeInfo")
 public final class Long private constructor() : Number(), Comparable<Long> {
     @CanBePrecreated
     companion object {
@@ -1142,6 +1147,7 @@ public final class Long private constructor() : Number(), Comparable<Long> {
 /**
  * Represents a single-precision 32-bit IEEE 754 floating point number.
  */
+@ExportTypeInfo("theFloatBoxTypeInfo")
 public final class Float private constructor() : Number(), Comparable<Float> {
     companion object {
         /**
@@ -1397,6 +1403,7 @@ public final class Float private constructor() : Number(), Comparable<Float> {
 /**
  * Represents a double-precision 64-bit IEEE 754 floating point number.
  */
+@ExportTypeInfo("theDoubleBoxTypeInfo")
 public final class Double private constructor() : Number(), Comparable<Double> {
     companion object {
         /**
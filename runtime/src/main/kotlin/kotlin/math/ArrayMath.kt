@@ -0,0 +1,204 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.math
+
+// Element-wise math functions over primitive arrays, computed by the runtime with vectorized kernels.
+
+// Values must match ArrayMathFunction in ArrayMath.cpp.
+private const val SIN = 0
+private const val COS = 1
+private const val EXP = 2
+private const val LOG = 3
+private const val SQRT = 4
+private const val POW = 5
+
+@SymbolName("Kotlin_DoubleArray_applyMath")
+private external fun applyMath(array: DoubleArray, fromIndex: Int, toIndex: Int,
+                               destination: DoubleArray, destinationOffset: Int, function: Int, argument: Double)
+
+@SymbolName("Kotlin_FloatArray_applyMath")
+private external fun applyMath(array: FloatArray, fromIndex: Int, toIndex: Int,
+                               destination: FloatArray, destinationOffset: Int, function: Int, argument: Double)
+
+/**
+ * Computes [sin] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [sin] by less than 1 ulp.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun DoubleArray.sinInto(destination: DoubleArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): DoubleArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, SIN, 0.0)
+    return destination
+}
+
+/**
+ * Computes [cos] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [cos] by less than 1 ulp.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun DoubleArray.cosInto(destination: DoubleArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): DoubleArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, COS, 0.0)
+    return destination
+}
+
+/**
+ * Computes [exp] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [exp] by less than 1 ulp, unless the result is subnormal.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun DoubleArray.expInto(destination: DoubleArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): DoubleArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, EXP, 0.0)
+    return destination
+}
+
+/**
+ * Computes the natural logarithm [ln] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [ln] by less than 1 ulp.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun DoubleArray.lnInto(destination: DoubleArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): DoubleArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, LOG, 0.0)
+    return destination
+}
+
+/**
+ * Computes [sqrt] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * The result is the same as of [sqrt].
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun DoubleArray.sqrtInto(destination: DoubleArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): DoubleArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, SQRT, 0.0)
+    return destination
+}
+
+/**
+ * Raises each element of this array to the power [x] from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * The result is the same as of [pow].
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun DoubleArray.powInto(x: Double, destination: DoubleArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): DoubleArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, POW, x)
+    return destination
+}
+
+/**
+ * Computes [sin] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [sin] by less than 1 ulp.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun FloatArray.sinInto(destination: FloatArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): FloatArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, SIN, 0.0)
+    return destination
+}
+
+/**
+ * Computes [cos] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [cos] by less than 1 ulp.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun FloatArray.cosInto(destination: FloatArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): FloatArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, COS, 0.0)
+    return destination
+}
+
+/**
+ * Computes [exp] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [exp] by less than 1 ulp, unless the result is subnormal.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun FloatArray.expInto(destination: FloatArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): FloatArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, EXP, 0.0)
+    return destination
+}
+
+/**
+ * Computes the natural logarithm [ln] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [ln] by less than 1 ulp.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun FloatArray.lnInto(destination: FloatArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): FloatArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, LOG, 0.0)
+    return destination
+}
+
+/**
+ * Computes [sqrt] of each element of this array from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * The result is the same as of [sqrt].
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun FloatArray.sqrtInto(destination: FloatArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): FloatArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, SQRT, 0.0)
+    return destination
+}
+
+/**
+ * Raises each element of this array to the power [x] from [startIndex] (inclusive) to [endIndex] (exclusive)
+ * and stores the results into the [destination] array starting at [destinationOffset]. Returns the [destination] array.
+ * By default, the whole array is updated in place. The ranges may overlap.
+ *
+ * Differs from [pow] by at most 1 ulp, as the result is computed in double precision and rounded.
+ *
+ * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+ */
+public fun FloatArray.powInto(x: Float, destination: FloatArray = this, destinationOffset: Int = 0,
+        startIndex: Int = 0, endIndex: Int = size): FloatArray {
+    applyMath(this, startIndex, endIndex, destination, destinationOffset, POW, x.toDouble())
+    return destination
+}
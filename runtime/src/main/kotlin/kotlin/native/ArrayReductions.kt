@@ -0,0 +1,280 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native
+
+// Reductions and dot products over primitive arrays, computed by the runtime with vectorized kernels.
+
+/**
+ * The way floating point values are added up by the array reductions.
+ *
+ * Ordinal values must match Summation in ArrayReductions.cpp.
+ */
+public enum class Summation {
+    /**
+     * Adds the values in several interleaved partial sums. The fastest one, error grows linearly with the number of values,
+     * as for the sequential summation.
+     */
+    FAST,
+
+    /**
+     * Adds the values pairwise, recursively. Nearly as fast as [FAST], error grows logarithmically with the number of values.
+     */
+    PAIRWISE,
+
+    /**
+     * Compensated (Kahan-Babuska) summation. About twice as slow as [FAST], error doesn't depend on the number of values.
+     */
+    KAHAN
+}
+
+@SymbolName("Kotlin_IntArray_sum")
+private external fun arraySum(array: IntArray, fromIndex: Int, toIndex: Int): Int
+
+@SymbolName("Kotlin_LongArray_sum")
+private external fun arraySum(array: LongArray, fromIndex: Int, toIndex: Int): Long
+
+@SymbolName("Kotlin_FloatArray_sum")
+private external fun arraySum(array: FloatArray, fromIndex: Int, toIndex: Int, summation: Int): Float
+
+@SymbolName("Kotlin_DoubleArray_sum")
+private external fun arraySum(array: DoubleArray, fromIndex: Int, toIndex: Int, summation: Int): Double
+
+@SymbolName("Kotlin_IntArray_dot")
+private external fun arrayDot(array: IntArray, other: IntArray): Long
+
+@SymbolName("Kotlin_LongArray_dot")
+private external fun arrayDot(array: LongArray, other: LongArray): Long
+
+@SymbolName("Kotlin_FloatArray_dot")
+private external fun arrayDot(array: FloatArray, other: FloatArray, summation: Int): Float
+
+@SymbolName("Kotlin_DoubleArray_dot")
+private external fun arrayDot(array: DoubleArray, other: DoubleArray, summation: Int): Double
+
+@SymbolName("Kotlin_IntArray_min")
+private external fun arrayMin(array: IntArray, fromIndex: Int, toIndex: Int): Int
+
+@SymbolName("Kotlin_IntArray_max")
+private external fun arrayMax(array: IntArray, fromIndex: Int, toIndex: Int): Int
+
+@SymbolName("Kotlin_LongArray_min")
+private external fun arrayMin(array: LongArray, fromIndex: Int, toIndex: Int): Long
+
+@SymbolName("Kotlin_LongArray_max")
+private external fun arrayMax(array: LongArray, fromIndex: Int, toIndex: Int): Long
+
+@SymbolName("Kotlin_FloatArray_min")
+private external fun arrayMin(array: FloatArray, fromIndex: Int, toIndex: Int): Float
+
+@SymbolName("Kotlin_FloatArray_max")
+private external fun arrayMax(array: FloatArray, fromIndex: Int, toIndex: Int): Float
+
+@SymbolName("Kotlin_DoubleArray_min")
+private external fun arrayMin(array: DoubleArray, fromIndex: Int, toIndex: Int): Double
+
+@SymbolName("Kotlin_DoubleArray_max")
+private external fun arrayMax(array: DoubleArray, fromIndex: Int, toIndex: Int): Double
+
+private fun checkNotEmpty(startIndex: Int, endIndex: Int, size: Int) {
+    checkRangeIndexes(startIndex, endIndex, size)
+    if (startIndex == endIndex) throw NoSuchElementException("Array range is empty.")
+}
+
+private fun checkSameSize(size: Int, otherSize: Int) {
+    if (size != otherSize) throw IllegalArgumentException("Array sizes differ: $size and $otherSize.")
+}
+
+/**
+ * Returns the sum of the elements of this array from [startIndex] (inclusive) to [endIndex] (exclusive).
+ * Overflows the same way as the sequential summation does.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun IntArray.sum(startIndex: Int, endIndex: Int): Int {
+    checkRangeIndexes(startIndex, endIndex, size)
+    return arraySum(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the sum of the elements of this array from [startIndex] (inclusive) to [endIndex] (exclusive).
+ * Overflows the same way as the sequential summation does.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun LongArray.sum(startIndex: Int, endIndex: Int): Long {
+    checkRangeIndexes(startIndex, endIndex, size)
+    return arraySum(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the sum of the elements of this array from [startIndex] (inclusive) to [endIndex] (exclusive),
+ * added up as specified by [summation]. By default, the whole array is summed.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun FloatArray.sum(summation: Summation, startIndex: Int = 0, endIndex: Int = size): Float {
+    checkRangeIndexes(startIndex, endIndex, size)
+    return arraySum(this, startIndex, endIndex, summation.ordinal)
+}
+
+/**
+ * Returns the sum of the elements of this array from [startIndex] (inclusive) to [endIndex] (exclusive),
+ * added up as specified by [summation]. By default, the whole array is summed.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun DoubleArray.sum(summation: Summation, startIndex: Int = 0, endIndex: Int = size): Double {
+    checkRangeIndexes(startIndex, endIndex, size)
+    return arraySum(this, startIndex, endIndex, summation.ordinal)
+}
+
+/**
+ * Returns the dot product of this array and the [other] one, i.e. the sum of products of their elements.
+ * Products are computed without overflow, their sum overflows the same way as the sequential summation does.
+ *
+ * @throws IllegalArgumentException if the arrays have different sizes.
+ */
+public fun IntArray.dot(other: IntArray): Long {
+    checkSameSize(size, other.size)
+    return arrayDot(this, other)
+}
+
+/**
+ * Returns the dot product of this array and the [other] one, i.e. the sum of products of their elements.
+ * Overflows the same way as the sequential computation does.
+ *
+ * @throws IllegalArgumentException if the arrays have different sizes.
+ */
+public fun LongArray.dot(other: LongArray): Long {
+    checkSameSize(size, other.size)
+    return arrayDot(this, other)
+}
+
+/**
+ * Returns the dot product of this array and the [other] one, i.e. the sum of products of their elements,
+ * added up as specified by [summation].
+ *
+ * @throws IllegalArgumentException if the arrays have different sizes.
+ */
+public fun FloatArray.dot(other: FloatArray, summation: Summation = Summation.FAST): Float {
+    checkSameSize(size, other.size)
+    return arrayDot(this, other, summation.ordinal)
+}
+
+/**
+ * Returns the dot product of this array and the [other] one, i.e. the sum of products of their elements,
+ * added up as specified by [summation].
+ *
+ * @throws IllegalArgumentException if the arrays have different sizes.
+ */
+public fun DoubleArray.dot(other: DoubleArray, summation: Summation = Summation.FAST): Double {
+    checkSameSize(size, other.size)
+    return arrayDot(this, other, summation.ordinal)
+}
+
+/**
+ * Returns the smallest element of this array from [startIndex] (inclusive) to [endIndex] (exclusive).
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws NoSuchElementException if the range is empty.
+ */
+public fun IntArray.min(startIndex: Int, endIndex: Int): Int {
+    checkNotEmpty(startIndex, endIndex, size)
+    return arrayMin(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the largest element of this array from [startIndex] (inclusive) to [endIndex] (exclusive).
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws NoSuchElementException if the range is empty.
+ */
+public fun IntArray.max(startIndex: Int, endIndex: Int): Int {
+    checkNotEmpty(startIndex, endIndex, size)
+    return arrayMax(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the smallest element of this array from [startIndex] (inclusive) to [endIndex] (exclusive).
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws NoSuchElementException if the range is empty.
+ */
+public fun LongArray.min(startIndex: Int, endIndex: Int): Long {
+    checkNotEmpty(startIndex, endIndex, size)
+    return arrayMin(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the largest element of this array from [startIndex] (inclusive) to [endIndex] (exclusive).
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws NoSuchElementException if the range is empty.
+ */
+public fun LongArray.max(startIndex: Int, endIndex: Int): Long {
+    checkNotEmpty(startIndex, endIndex, size)
+    return arrayMax(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the smallest element of this array from [startIndex] (inclusive) to [endIndex] (exclusive),
+ * or `NaN` if any of them is `NaN`.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws NoSuchElementException if the range is empty.
+ */
+public fun FloatArray.min(startIndex: Int, endIndex: Int): Float {
+    checkNotEmpty(startIndex, endIndex, size)
+    return arrayMin(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the largest element of this array from [startIndex] (inclusive) to [endIndex] (exclusive),
+ * or `NaN` if any of them is `NaN`.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws NoSuchElementException if the range is empty.
+ */
+public fun FloatArray.max(startIndex: Int, endIndex: Int): Float {
+    checkNotEmpty(startIndex, endIndex, size)
+    return arrayMax(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the smallest element of this array from [startIndex] (inclusive) to [endIndex] (exclusive),
+ * or `NaN` if any of them is `NaN`.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws NoSuchElementException if the range is empty.
+ */
+public fun DoubleArray.min(startIndex: Int, endIndex: Int): Double {
+    checkNotEmpty(startIndex, endIndex, size)
+    return arrayMin(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the largest element of this array from [startIndex] (inclusive) to [endIndex] (exclusive),
+ * or `NaN` if any of them is `NaN`.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ * @throws NoSuchElementException if the range is empty.
+ */
+public fun DoubleArray.max(startIndex: Int, endIndex: Int): Double {
+    checkNotEmpty(startIndex, endIndex, size)
+    return arrayMax(this, startIndex, endIndex)
+}
@@ -5,6 +5,32 @@
 
 package kotlin.native
 
+// Values must match BitSetOperation in BitSet.cpp.
+internal object BitSetOperation {
+    const val AND = 0
+    const val OR = 1
+    const val XOR = 2
+    const val AND_NOT = 3
+}
+
+@SymbolName("Kotlin_BitSet_cardinality")
+internal external fun bitSetCardinality(bits: LongArray, fromWord: Int, toWord: Int): Int
+
+@SymbolName("Kotlin_BitSet_isEmpty")
+internal external fun bitSetIsEmpty(bits: LongArray): Boolean
+
+@SymbolName("Kotlin_BitSet_nextBit")
+internal external fun bitSetNextBit(bits: LongArray, startIndex: Int, lookFor: Boolean): Int
+
+@SymbolName("Kotlin_BitSet_previousBit")
+internal external fun bitSetPreviousBit(bits: LongArray, startIndex: Int, lookFor: Boolean): Int
+
+@SymbolName("Kotlin_BitSet_operation")
+internal external fun bitSetOperation(bits: LongArray, another: LongArray, operation: Int)
+
+@SymbolName("Kotlin_BitSet_intersects")
+internal external fun bitSetIntersects(bits: LongArray, another: LongArray): Boolean
+
 /**
  * A vector of bits growing if necessary and allowing one to set/clear/read bits from it by a bit index.
  *
@@ -33,7 +59,7 @@ public class BitSet(size: Int = ELEMENT_SIZE) {
 
     /** True if this BitSet contains no bits set to true. */
     val isEmpty: Boolean
-        get() = bits.all { it == ALL_FALSE }
+        get() = bitSetIsEmpty(bits)
 
     /** Actual number of bits available in the set. All bits with indices >= size assumed to be 0 */
     var size: Int = size
@@ -73,14 +99,8 @@ public class BitSet(size: Int = ELEMENT_SIZE) {
         get() = getMaskBetween(this, MAX_BIT_OFFSET)
 
     // Builds a masks with 1 between fromOffset and toOffset (both inclusive).
-    private fun getMaskBetween(fromOffset: Int, toOffset: Int): Long {
-        var res = 0L
-        val maskToAdd = fromOffset.asMask
-        for (i in fromOffset..toOffset) {
-            res = (res shl 1) or maskToAdd
-        }
-        return res
-    }
+    private fun getMaskBetween(fromOffset: Int, toOffset: Int): Long =
+            (ALL_TRUE shl fromOffset) and (ALL_TRUE ushr (MAX_BIT_OFFSET - toOffset))
 
     // Transforms a size in bits to a size in elements of the `bits` array.
     private fun bitToElementSize(bitSize: Int): Int = (bitSize + ELEMENT_SIZE - 1) / ELEMENT_SIZE
@@ -161,9 +181,7 @@ public class BitSet(size: Int = ELEMENT_SIZE) {
             // Set bits in the first element.
             setBitsWithMask(fromIndex, fromOffset.asMaskAfter, value)
             // Set all bits of all elements (excluding border ones) to 0 or 1 depending.
-            for (index in fromIndex + 1 until toIndex) {
-                bits[index] = if (value) ALL_TRUE else ALL_FALSE
-            }
+            bits.fill(if (value) ALL_TRUE else ALL_FALSE, fromIndex + 1, toIndex)
             // Set bits in the last element
             setBitsWithMask(toIndex, toOffset.asMaskBefore, value)
         }
@@ -179,9 +197,7 @@ public class BitSet(size: Int = ELEMENT_SIZE) {
 
     /** Sets all bits in the BitSet to `false`. */
     fun clear() {
-        for (i in bits.indices) {
-            bits[i] = ALL_FALSE
-        }
+        bits.fill(ALL_FALSE)
     }
 
     /** Reverses the bit specified. */
@@ -210,7 +226,7 @@ public class BitSet(size: Int = ELEMENT_SIZE) {
             flipBitsWithMask(fromIndex, mask)
         } else {
             // Flip bits in the first element.
-            flipBitsWithMask(toIndex, toOffset.asMaskAfter)
+            flipBitsWithMask(fromIndex, fromOffset.asMaskAfter)
             // Flip bits between the first and the last elements.
             for (index in fromIndex + 1 until toIndex) {
                 bits[index] = bits[index].inv()
@@ -234,26 +250,8 @@ public class BitSet(size: Int = ELEMENT_SIZE) {
         if (startIndex >= size) {
             return if (lookFor) -1 else startIndex
         }
-        val (startElementIndex, startOffset) = startIndex.asBitCoordinates
-        // Look for the next set bit in the first element.
-        var element = bits[startElementIndex]
-        for (offset in startOffset..MAX_BIT_OFFSET) {
-            val bit = element and (0x1L shl offset) != 0L
-            if (bit == lookFor) {  // Look for not 0 if we need a set bit and look for 0 otherwise.
-                return bitIndex(startElementIndex, offset)
-            }
-        }
-        // Look for in the remaining elements.
-        for (index in startElementIndex + 1..bits.lastIndex) {
-            element = bits[index]
-            for (offset in 0..MAX_BIT_OFFSET) {
-                val bit = element and (0x1L shl offset) != 0L
-                if (bit == lookFor) { // Look for not 0 if we need a set bit and look for 0 otherwise.
-                    return bitIndex(index, offset)
-                }
-            }
-        }
-        return if (lookFor) -1 else size
+        val index = bitSetNextBit(bits, startIndex, lookFor)
+        return if (index != -1 && index < size) index else if (lookFor) -1 else size
     }
 
     /**
@@ -294,26 +292,7 @@ public class BitSet(size: Int = ELEMENT_SIZE) {
             return -1
         }
 
-        val (startElementIndex, startOffset) = correctStartIndex.asBitCoordinates
-        // Look for the next set bit in the first element.
-        var element = bits[startElementIndex]
-        for (offset in startOffset downTo 0) {
-            val bit = element and (0x1L shl offset) != 0L
-            if (bit == lookFor) {  // Look for not 0 if we need a set bit and look for 0 otherwise.
-                return bitIndex(startElementIndex, offset)
-            }
-        }
-        // Look for in the remaining elements.
-        for (index in startElementIndex - 1 downTo 0) {
-            element = bits[index]
-            for (offset in MAX_BIT_OFFSET downTo 0) {
-                val bit = element and (0x1L shl offset) != 0L
-                if (bit == lookFor) {  // Look for not 0 if we need a set bit and look for 0 otherwise.
-                    return bitIndex(index, offset)
-                }
-            }
-        }
-        return -1
+        return bitSetPreviousBit(bits, correctStartIndex, lookFor)
     }
 
     /**
@@ -345,59 +324,52 @@ public class BitSet(size: Int = ELEMENT_SIZE) {
         return bits[elementIndex] and offset.asMask != 0L
     }
 
-    private inline fun doOperation(another: BitSet, operation: Long.(Long) -> Long) {
+    private fun doOperation(another: BitSet, operation: Int) {
         ensureCapacity(another.lastIndex)
-        var index = 0
-        while (index < another.bits.size) {
-            bits[index] = operation(bits[index], another.bits[index])
-            index++
-        }
-        while (index < bits.size) {
-            bits[index] = operation(bits[index], ALL_FALSE)
-            index++
-        }
+        bitSetOperation(bits, another.bits, operation)
     }
 
     /** Performs a logical and operation over corresponding bits of this and [another] BitSets. The result is saved in this BitSet. */
-    fun and(another: BitSet) = doOperation(another, Long::and)
+    fun and(another: BitSet) = doOperation(another, BitSetOperation.AND)
 
     /** Performs a logical or operation over corresponding bits of this and [another] BitSets. The result is saved in this BitSet. */
-    fun or(another: BitSet) = doOperation(another, Long::or)
+    fun or(another: BitSet) = doOperation(another, BitSetOperation.OR)
 
     /** Performs a logical xor operation over corresponding bits of this and [another] BitSets. The result is saved in this BitSet. */
-    fun xor(another: BitSet) = doOperation(another, Long::xor)
+    fun xor(another: BitSet) = doOperation(another, BitSetOperation.XOR)
 
     /** Performs a logical and + not operations over corresponding bits of this and [another] BitSets. The result is saved in this BitSet. */
-    fun andNot(another: BitSet) {
-        ensureCapacity(another.lastIndex)
-        var index = 0
-        while (index < another.bits.size) {
-            bits[index] = bits[index] and another.bits[index].inv()
-            index++
-        }
-        while (index < bits.size) {
-            bits[index] = bits[index] and ALL_TRUE
-            index++
-        }
-    }
+    fun andNot(another: BitSet) = doOperation(another, BitSetOperation.AND_NOT)
 
     /** Returns true if the specified BitSet has any bits set to true that are also set to true in this BitSet. */
-    fun intersects(another: BitSet): Boolean =
-            (0 until minOf(bits.size, another.bits.size)).any { bits[it] and another.bits[it] != 0L }
+    fun intersects(another: BitSet): Boolean = bitSetIntersects(bits, another.bits)
+
+    /** Returns the number of bits set to `true`. */
+    fun cardinality(): Int = bitSetCardinality(bits, 0, bits.size)
+
+    /** Calls [action] with the index of each bit set to `true`, in ascending order. */
+    fun forEachSetBit(action: (Int) -> Unit) {
+        for (elementIndex in bits.indices) {
+            var element = bits[elementIndex]
+            while (element != ALL_FALSE) {
+                action(bitIndex(elementIndex, element.countTrailingZeroBits()))
+                // Clear the lowest set bit.
+                element = element and (element - 1)
+            }
+        }
+    }
 
     override fun toString(): String {
         val sb = StringBuilder()
         var first = true
         sb.append('[')
-        var index = nextSetBit(0)
-        while (index != -1) {
+        forEachSetBit { index ->
             if (!first) {
                 sb.append('|')
             } else {
                 first = false
             }
             sb.append(index)
-            index = nextSetBit(index + 1)
         }
         sb.append(']')
         return sb.toString()
@@ -0,0 +1,320 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native
+
+// Base64 and hex codecs, computed by the runtime with vectorized kernels where available.
+
+@SymbolName("Kotlin_Base64_encode")
+private external fun base64Encode(source: ByteArray, fromIndex: Int, toIndex: Int,
+                                  destination: ByteArray, destinationOffset: Int, urlSafe: Boolean, padding: Boolean): Int
+
+@SymbolName("Kotlin_Base64_encodeToString")
+private external fun base64EncodeToString(source: ByteArray, fromIndex: Int, toIndex: Int,
+                                          urlSafe: Boolean, padding: Boolean, length: Int): String
+
+@SymbolName("Kotlin_Base64_decode")
+private external fun base64Decode(source: ByteArray, fromIndex: Int, toIndex: Int,
+                                  destination: ByteArray, destinationOffset: Int, urlSafe: Boolean): Int
+
+@SymbolName("Kotlin_Base64_decodeString")
+private external fun base64Decode(source: String, fromIndex: Int, toIndex: Int,
+                                  destination: ByteArray, destinationOffset: Int, urlSafe: Boolean): Int
+
+@SymbolName("Kotlin_Hex_encode")
+private external fun hexEncode(source: ByteArray, fromIndex: Int, toIndex: Int,
+                               destination: ByteArray, destinationOffset: Int, upperCase: Boolean)
+
+@SymbolName("Kotlin_Hex_encodeToString")
+private external fun hexEncodeToString(source: ByteArray, fromIndex: Int, toIndex: Int, upperCase: Boolean): String
+
+@SymbolName("Kotlin_Hex_decode")
+private external fun hexDecode(source: ByteArray, fromIndex: Int, toIndex: Int,
+                               destination: ByteArray, destinationOffset: Int): Int
+
+@SymbolName("Kotlin_Hex_decodeString")
+private external fun hexDecode(source: String, fromIndex: Int, toIndex: Int,
+                               destination: ByteArray, destinationOffset: Int): Int
+
+private fun checkDestination(destinationOffset: Int, length: Int, destinationSize: Int) {
+    if (destinationOffset < 0 || destinationOffset > destinationSize - length) {
+        throw IndexOutOfBoundsException(
+                "destinationOffset: $destinationOffset, length: $length, destination size: $destinationSize")
+    }
+}
+
+private fun checkDecoded(size: Int): Int {
+    if (size < 0) throw IllegalArgumentException("Invalid character in the input.")
+    return size
+}
+
+/**
+ * Base64 encoding as specified by RFC 4648, with either the standard or the URL and file name safe alphabet,
+ * with or without padding.
+ *
+ * Decoding accepts the input with or without padding, but not line separators or other characters
+ * outside of the alphabet.
+ */
+public class Base64 private constructor(private val urlSafe: Boolean, private val padding: Boolean) {
+
+    /**
+     * Returns the number of characters [size] bytes are encoded into.
+     *
+     * @throws IllegalArgumentException if the result doesn't fit into [Int].
+     */
+    public fun encodedSize(size: Int): Int {
+        val result = if (padding) (size + 2L) / 3 * 4 else (size * 4L + 2) / 3
+        if (result > Int.MAX_VALUE) throw IllegalArgumentException("Input of $size bytes is too large to encode.")
+        return result.toInt()
+    }
+
+    /**
+     * Encodes the bytes of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive) into a string.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+     */
+    public fun encodeToString(source: ByteArray, startIndex: Int = 0, endIndex: Int = source.size): String {
+        checkRangeIndexes(startIndex, endIndex, source.size)
+        return base64EncodeToString(source, startIndex, endIndex, urlSafe, padding, encodedSize(endIndex - startIndex))
+    }
+
+    /**
+     * Encodes the bytes of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * into a new array of ASCII characters.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+     */
+    public fun encodeToByteArray(source: ByteArray, startIndex: Int = 0, endIndex: Int = source.size): ByteArray {
+        checkRangeIndexes(startIndex, endIndex, source.size)
+        val result = ByteArray(encodedSize(endIndex - startIndex))
+        base64Encode(source, startIndex, endIndex, result, 0, urlSafe, padding)
+        return result
+    }
+
+    /**
+     * Encodes the bytes of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * as ASCII characters into the [destination] array starting at [destinationOffset].
+     * Returns the number of characters written, see [encodedSize].
+     *
+     * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+     */
+    public fun encodeInto(source: ByteArray, destination: ByteArray, destinationOffset: Int = 0,
+                          startIndex: Int = 0, endIndex: Int = source.size): Int {
+        checkRangeIndexes(startIndex, endIndex, source.size)
+        checkDestination(destinationOffset, encodedSize(endIndex - startIndex), destination.size)
+        return base64Encode(source, startIndex, endIndex, destination, destinationOffset, urlSafe, padding)
+    }
+
+    /**
+     * Returns the number of bytes the characters of [source] from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * are decoded into.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the length of the string.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input has an invalid length or padding.
+     */
+    public fun decodedSize(source: CharSequence, startIndex: Int = 0, endIndex: Int = source.length): Int {
+        checkRangeIndexes(startIndex, endIndex, source.length)
+        return decodedSize(endIndex - startIndex, dataEnd(startIndex, endIndex) { source[it] == '=' } - startIndex)
+    }
+
+    /**
+     * Returns the number of bytes the ASCII characters of the [source] array from [startIndex] (inclusive)
+     * to [endIndex] (exclusive) are decoded into.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input has an invalid length or padding.
+     */
+    public fun decodedSize(source: ByteArray, startIndex: Int = 0, endIndex: Int = source.size): Int {
+        checkRangeIndexes(startIndex, endIndex, source.size)
+        return decodedSize(endIndex - startIndex, dataEnd(startIndex, endIndex) { source[it] == '='.toByte() } - startIndex)
+    }
+
+    /**
+     * Decodes the characters of [source] from [startIndex] (inclusive) to [endIndex] (exclusive) into a new array.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the length of the string.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input is not valid Base64.
+     */
+    public fun decode(source: String, startIndex: Int = 0, endIndex: Int = source.length): ByteArray {
+        val result = ByteArray(decodedSize(source, startIndex, endIndex))
+        decodeInto(source, result, 0, startIndex, endIndex)
+        return result
+    }
+
+    /**
+     * Decodes the ASCII characters of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * into a new array.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input is not valid Base64.
+     */
+    public fun decode(source: ByteArray, startIndex: Int = 0, endIndex: Int = source.size): ByteArray {
+        val result = ByteArray(decodedSize(source, startIndex, endIndex))
+        decodeInto(source, result, 0, startIndex, endIndex)
+        return result
+    }
+
+    /**
+     * Decodes the characters of [source] from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * into the [destination] array starting at [destinationOffset]. Returns the number of bytes written, see [decodedSize].
+     *
+     * @throws IndexOutOfBoundsException if the ranges don't fit into the string or the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input is not valid Base64.
+     */
+    public fun decodeInto(source: String, destination: ByteArray, destinationOffset: Int = 0,
+                          startIndex: Int = 0, endIndex: Int = source.length): Int {
+        checkDestination(destinationOffset, decodedSize(source, startIndex, endIndex), destination.size)
+        val dataEnd = dataEnd(startIndex, endIndex) { source[it] == '=' }
+        return checkDecoded(base64Decode(source, startIndex, dataEnd, destination, destinationOffset, urlSafe))
+    }
+
+    /**
+     * Decodes the ASCII characters of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * into the [destination] array starting at [destinationOffset]. Returns the number of bytes written, see [decodedSize].
+     *
+     * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input is not valid Base64.
+     */
+    public fun decodeInto(source: ByteArray, destination: ByteArray, destinationOffset: Int = 0,
+                          startIndex: Int = 0, endIndex: Int = source.size): Int {
+        checkDestination(destinationOffset, decodedSize(source, startIndex, endIndex), destination.size)
+        val dataEnd = dataEnd(startIndex, endIndex) { source[it] == '='.toByte() }
+        return checkDecoded(base64Decode(source, startIndex, dataEnd, destination, destinationOffset, urlSafe))
+    }
+
+    // Skips up to two padding characters.
+    private inline fun dataEnd(startIndex: Int, endIndex: Int, isPadding: (Int) -> Boolean): Int {
+        var end = endIndex
+        while (end > startIndex && endIndex - end < 2 && isPadding(end - 1)) end--
+        return end
+    }
+
+    private fun decodedSize(length: Int, dataLength: Int): Int {
+        if (dataLength % 4 == 1 || (dataLength != length && length % 4 != 0)) {
+            throw IllegalArgumentException("Invalid length or padding of the input.")
+        }
+        return dataLength / 4 * 3 + maxOf(dataLength % 4 - 1, 0)
+    }
+
+    public companion object {
+        /** The standard alphabet with padding. */
+        public val Default: Base64 = Base64(urlSafe = false, padding = true)
+
+        /** The standard alphabet without padding. */
+        public val DefaultNoPadding: Base64 = Base64(urlSafe = false, padding = false)
+
+        /** The URL and file name safe alphabet with padding. */
+        public val UrlSafe: Base64 = Base64(urlSafe = true, padding = true)
+
+        /** The URL and file name safe alphabet without padding. */
+        public val UrlSafeNoPadding: Base64 = Base64(urlSafe = true, padding = false)
+    }
+}
+
+/**
+ * Hexadecimal encoding: two digits per byte, the most significant first.
+ *
+ * Decoding accepts digits of either case.
+ */
+public object Hex {
+    /**
+     * Encodes the bytes of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive) into a string,
+     * with lower case digits unless [upperCase] is set.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the result is too large.
+     */
+    public fun encodeToString(source: ByteArray, startIndex: Int = 0, endIndex: Int = source.size,
+                              upperCase: Boolean = false): String {
+        checkRangeIndexes(startIndex, endIndex, source.size)
+        encodedSize(endIndex - startIndex)
+        return hexEncodeToString(source, startIndex, endIndex, upperCase)
+    }
+
+    /**
+     * Encodes the bytes of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * as ASCII digits into the [destination] array starting at [destinationOffset], with lower case digits
+     * unless [upperCase] is set. Returns the number of characters written.
+     *
+     * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+     */
+    public fun encodeInto(source: ByteArray, destination: ByteArray, destinationOffset: Int = 0,
+                          startIndex: Int = 0, endIndex: Int = source.size, upperCase: Boolean = false): Int {
+        checkRangeIndexes(startIndex, endIndex, source.size)
+        val length = encodedSize(endIndex - startIndex)
+        checkDestination(destinationOffset, length, destination.size)
+        hexEncode(source, startIndex, endIndex, destination, destinationOffset, upperCase)
+        return length
+    }
+
+    /**
+     * Decodes the digits of [source] from [startIndex] (inclusive) to [endIndex] (exclusive) into a new array.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the length of the string.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input is not valid hex.
+     */
+    public fun decode(source: String, startIndex: Int = 0, endIndex: Int = source.length): ByteArray {
+        checkRangeIndexes(startIndex, endIndex, source.length)
+        val result = ByteArray(decodedSize(endIndex - startIndex))
+        checkDecoded(hexDecode(source, startIndex, endIndex, result, 0))
+        return result
+    }
+
+    /**
+     * Decodes the ASCII digits of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * into a new array.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input is not valid hex.
+     */
+    public fun decode(source: ByteArray, startIndex: Int = 0, endIndex: Int = source.size): ByteArray {
+        checkRangeIndexes(startIndex, endIndex, source.size)
+        val result = ByteArray(decodedSize(endIndex - startIndex))
+        checkDecoded(hexDecode(source, startIndex, endIndex, result, 0))
+        return result
+    }
+
+    /**
+     * Decodes the digits of [source] from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * into the [destination] array starting at [destinationOffset]. Returns the number of bytes written.
+     *
+     * @throws IndexOutOfBoundsException if the ranges don't fit into the string or the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input is not valid hex.
+     */
+    public fun decodeInto(source: String, destination: ByteArray, destinationOffset: Int = 0,
+                          startIndex: Int = 0, endIndex: Int = source.length): Int {
+        checkRangeIndexes(startIndex, endIndex, source.length)
+        checkDestination(destinationOffset, decodedSize(endIndex - startIndex), destination.size)
+        return checkDecoded(hexDecode(source, startIndex, endIndex, destination, destinationOffset))
+    }
+
+    /**
+     * Decodes the ASCII digits of the [source] array from [startIndex] (inclusive) to [endIndex] (exclusive)
+     * into the [destination] array starting at [destinationOffset]. Returns the number of bytes written.
+     *
+     * @throws IndexOutOfBoundsException if the ranges don't fit into the arrays.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex], or the input is not valid hex.
+     */
+    public fun decodeInto(source: ByteArray, destination: ByteArray, destinationOffset: Int = 0,
+                          startIndex: Int = 0, endIndex: Int = source.size): Int {
+        checkRangeIndexes(startIndex, endIndex, source.size)
+        checkDestination(destinationOffset, decodedSize(endIndex - startIndex), destination.size)
+        return checkDecoded(hexDecode(source, startIndex, endIndex, destination, destinationOffset))
+    }
+
+    private fun encodedSize(size: Int): Int {
+        if (size > Int.MAX_VALUE / 2) throw IllegalArgumentException("Input of $size bytes is too large to encode.")
+        return size * 2
+    }
+
+    private fun decodedSize(length: Int): Int {
+        if (length % 2 != 0) throw IllegalArgumentException("Odd length of the input.")
+        return length / 2
+    }
+}
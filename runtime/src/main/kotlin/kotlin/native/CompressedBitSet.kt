@@ -0,0 +1,417 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native
+
+/**
+ * A set of non-negative integers, stored compactly when sparse.
+ *
+ * Indices are split into chunks of 65536 by their upper 16 bits, and only non-empty chunks are stored.
+ * A chunk with few elements keeps them in a sorted array, a dense one uses a bitmap (so called roaring bitmap),
+ * which makes memory usage proportional to the number of elements, rather than to the largest index,
+ * while keeping the bulk operations on dense parts word-parallel.
+ */
+public class CompressedBitSet {
+
+    @kotlin.native.internal.CanBePrecreated
+    private companion object {
+        const val CHUNK_SHIFT = 16
+        const val CHUNK_MASK = 0xFFFF
+        const val CHUNK_WORDS = (1 shl CHUNK_SHIFT) / 64
+        // Chunks with more elements are stored as bitmaps, so that a chunk never takes more than 8 KiB.
+        const val MAX_ARRAY_CARDINALITY = 4096
+    }
+
+    private abstract class Chunk {
+        abstract val cardinality: Int
+        abstract operator fun contains(value: Int): Boolean
+        // Return the chunk containing the result, which may be `this` or a new chunk.
+        abstract fun add(value: Int): Chunk
+        abstract fun remove(value: Int): Chunk
+        // Returns the smallest value not less than `from`, or -1.
+        abstract fun next(from: Int): Int
+        abstract fun forEach(base: Int, action: (Int) -> Unit)
+        abstract fun toBitmap(): BitmapChunk
+        abstract fun copy(): Chunk
+    }
+
+    // Sorted distinct values, stored as chars to be compared as unsigned.
+    private class ArrayChunk(var values: CharArray, override var cardinality: Int) : Chunk() {
+        private fun indexOf(value: Int): Int {
+            var low = 0
+            var high = cardinality - 1
+            while (low <= high) {
+                val middle = (low + high) ushr 1
+                val middleValue = values[middle].toInt()
+                when {
+                    middleValue < value -> low = middle + 1
+                    middleValue > value -> high = middle - 1
+                    else -> return middle
+                }
+            }
+            return -(low + 1)
+        }
+
+        override fun contains(value: Int) = indexOf(value) >= 0
+
+        override fun add(value: Int): Chunk {
+            val index = indexOf(value)
+            if (index >= 0) return this
+            if (cardinality == MAX_ARRAY_CARDINALITY) return toBitmap().add(value)
+            val insertion = -(index + 1)
+            if (cardinality == values.size) values = values.copyOf(minOf(maxOf(4, cardinality * 2), MAX_ARRAY_CARDINALITY))
+            values.copyInto(values, insertion + 1, insertion, cardinality)
+            values[insertion] = value.toChar()
+            cardinality++
+            return this
+        }
+
+        override fun remove(value: Int): Chunk {
+            val index = indexOf(value)
+            if (index < 0) return this
+            values.copyInto(values, index, index + 1, cardinality)
+            cardinality--
+            return this
+        }
+
+        override fun next(from: Int): Int {
+            val index = indexOf(from)
+            val position = if (index >= 0) index else -(index + 1)
+            return if (position < cardinality) values[position].toInt() else -1
+        }
+
+        override fun forEach(base: Int, action: (Int) -> Unit) {
+            for (index in 0 until cardinality) action(base or values[index].toInt())
+        }
+
+        override fun toBitmap(): BitmapChunk {
+            val words = LongArray(CHUNK_WORDS)
+            for (index in 0 until cardinality) {
+                val value = values[index].toInt()
+                words[value ushr 6] = words[value ushr 6] or (1L shl value)
+            }
+            return BitmapChunk(words, cardinality)
+        }
+
+        override fun copy(): Chunk = ArrayChunk(values.copyOf(cardinality), cardinality)
+    }
+
+    private class BitmapChunk(val words: LongArray, override var cardinality: Int) : Chunk() {
+        override fun contains(value: Int) = words[value ushr 6] and (1L shl value) != 0L
+
+        override fun add(value: Int): Chunk {
+            val word = words[value ushr 6]
+            val updated = word or (1L shl value)
+            if (updated != word) {
+                words[value ushr 6] = updated
+                cardinality++
+            }
+            return this
+        }
+
+        override fun remove(value: Int): Chunk {
+            val word = words[value ushr 6]
+            val updated = word and (1L shl value).inv()
+            if (updated == word) return this
+            words[value ushr 6] = updated
+            cardinality--
+            return if (cardinality <= MAX_ARRAY_CARDINALITY) toArray() else this
+        }
+
+        override fun next(from: Int): Int = bitSetNextBit(words, from, true)
+
+        override fun forEach(base: Int, action: (Int) -> Unit) {
+            for (wordIndex in words.indices) {
+                var word = words[wordIndex]
+                while (word != 0L) {
+                    action(base or (wordIndex shl 6) or word.countTrailingZeroBits())
+                    word = word and (word - 1)
+                }
+            }
+        }
+
+        override fun toBitmap() = this
+
+        override fun copy(): Chunk = BitmapChunk(words.copyOf(), cardinality)
+
+        fun toArray(): ArrayChunk {
+            val values = CharArray(cardinality)
+            var index = 0
+            forEach(0) { values[index++] = it.toChar() }
+            return ArrayChunk(values, cardinality)
+        }
+
+        // Applies the operation with `another` in place and returns the normalized result, or null if it is empty.
+        fun applyOperation(another: BitmapChunk, operation: Int): Chunk? {
+            bitSetOperation(words, another.words, operation)
+            cardinality = bitSetCardinality(words, 0, CHUNK_WORDS)
+            return when {
+                cardinality == 0 -> null
+                cardinality <= MAX_ARRAY_CARDINALITY -> toArray()
+                else -> this
+            }
+        }
+    }
+
+    // Upper 16 bits of the indices in the corresponding chunks, sorted.
+    private var keys = CharArray(4)
+    private var chunks = arrayOfNulls<Chunk>(4)
+    private var chunkCount = 0
+
+    private fun chunkIndex(key: Int): Int {
+        var low = 0
+        var high = chunkCount - 1
+        while (low <= high) {
+            val middle = (low + high) ushr 1
+            val middleKey = keys[middle].toInt()
+            when {
+                middleKey < key -> low = middle + 1
+                middleKey > key -> high = middle - 1
+                else -> return middle
+            }
+        }
+        return -(low + 1)
+    }
+
+    private fun chunkAt(index: Int): Chunk = chunks[index]!!
+
+    private fun insertChunk(index: Int, key: Int, chunk: Chunk) {
+        if (chunkCount == keys.size) {
+            keys = keys.copyOf(chunkCount * 2)
+            chunks = chunks.copyOf(chunkCount * 2)
+        }
+        keys.copyInto(keys, index + 1, index, chunkCount)
+        chunks.copyInto(chunks, index + 1, index, chunkCount)
+        keys[index] = key.toChar()
+        chunks[index] = chunk
+        chunkCount++
+    }
+
+    private fun removeChunk(index: Int) {
+        keys.copyInto(keys, index, index + 1, chunkCount)
+        chunks.copyInto(chunks, index, index + 1, chunkCount)
+        chunkCount--
+        chunks[chunkCount] = null
+    }
+
+    private fun checkIndex(index: Int) {
+        if (index < 0) {
+            throw IndexOutOfBoundsException()
+        }
+    }
+
+    /** True if this set contains no elements. */
+    val isEmpty: Boolean
+        get() = chunkCount == 0
+
+    /** Returns the number of elements in this set. */
+    fun cardinality(): Int {
+        var result = 0
+        for (index in 0 until chunkCount) result += chunkAt(index).cardinality
+        return result
+    }
+
+    /** Returns `true` if the [index] is in this set. */
+    operator fun get(index: Int): Boolean {
+        checkIndex(index)
+        val chunkIndex = chunkIndex(index ushr CHUNK_SHIFT)
+        return chunkIndex >= 0 && (index and CHUNK_MASK) in chunkAt(chunkIndex)
+    }
+
+    /** Adds the [index] to this set if [value] is `true` or removes it otherwise. */
+    fun set(index: Int, value: Boolean = true) {
+        checkIndex(index)
+        val key = index ushr CHUNK_SHIFT
+        val chunkIndex = chunkIndex(key)
+        if (value) {
+            if (chunkIndex >= 0) {
+                chunks[chunkIndex] = chunkAt(chunkIndex).add(index and CHUNK_MASK)
+            } else {
+                insertChunk(-(chunkIndex + 1), key, ArrayChunk(CharArray(4), 0).add(index and CHUNK_MASK))
+            }
+        } else if (chunkIndex >= 0) {
+            val chunk = chunkAt(chunkIndex).remove(index and CHUNK_MASK)
+            if (chunk.cardinality == 0) removeChunk(chunkIndex) else chunks[chunkIndex] = chunk
+        }
+    }
+
+    /** Removes the [index] from this set. */
+    fun clear(index: Int) = set(index, false)
+
+    /** Removes all elements from this set. */
+    fun clear() {
+        chunks.fill(null)
+        chunkCount = 0
+    }
+
+    /**
+     * Returns the smallest element not less than [startIndex], or -1 if there is no such element.
+     * @throws IndexOutOfBoundException if [startIndex] < 0.
+     */
+    fun nextSetBit(startIndex: Int = 0): Int {
+        checkIndex(startIndex)
+        val key = startIndex ushr CHUNK_SHIFT
+        var chunkIndex = chunkIndex(key)
+        if (chunkIndex >= 0) {
+            val next = chunkAt(chunkIndex).next(startIndex and CHUNK_MASK)
+            if (next != -1) return (key shl CHUNK_SHIFT) or next
+            chunkIndex++
+        } else {
+            chunkIndex = -(chunkIndex + 1)
+        }
+        if (chunkIndex == chunkCount) return -1
+        return (keys[chunkIndex].toInt() shl CHUNK_SHIFT) or chunkAt(chunkIndex).next(0)
+    }
+
+    /** Calls [action] with each element of this set, in ascending order. */
+    fun forEachSetBit(action: (Int) -> Unit) {
+        for (index in 0 until chunkCount) {
+            chunkAt(index).forEach(keys[index].toInt() shl CHUNK_SHIFT, action)
+        }
+    }
+
+    /** Performs a logical or operation with [another] set. The result is saved in this set. */
+    fun or(another: CompressedBitSet) {
+        for (anotherIndex in 0 until another.chunkCount) {
+            val key = another.keys[anotherIndex].toInt()
+            val anotherChunk = another.chunkAt(anotherIndex)
+            val chunkIndex = chunkIndex(key)
+            if (chunkIndex < 0) {
+                insertChunk(-(chunkIndex + 1), key, anotherChunk.copy())
+                continue
+            }
+            val chunk = chunkAt(chunkIndex)
+            chunks[chunkIndex] = if (chunk is ArrayChunk && anotherChunk is ArrayChunk &&
+                    chunk.cardinality + anotherChunk.cardinality <= MAX_ARRAY_CARDINALITY) {
+                var result: Chunk = chunk
+                anotherChunk.forEach(0) { result = result.add(it) }
+                result
+            } else {
+                chunk.toBitmap().applyOperation(anotherChunk.toBitmap(), BitSetOperation.OR)
+            }
+        }
+    }
+
+    /** Performs a logical and operation with [another] set. The result is saved in this set. */
+    fun and(another: CompressedBitSet) = combine(another, BitSetOperation.AND)
+
+    /** Performs a logical xor operation with [another] set. The result is saved in this set. */
+    fun xor(another: CompressedBitSet) {
+        for (anotherIndex in 0 until another.chunkCount) {
+            val key = another.keys[anotherIndex].toInt()
+            if (chunkIndex(key) < 0) insertChunk(-(chunkIndex(key) + 1), key, ArrayChunk(CharArray(0), 0))
+        }
+        combine(another, BitSetOperation.XOR)
+    }
+
+    /** Performs a logical and + not operation with [another] set. The result is saved in this set. */
+    fun andNot(another: CompressedBitSet) = combine(another, BitSetOperation.AND_NOT)
+
+    // Applies the operation to each chunk of this set. Missing chunks of `another` are treated as empty.
+    private fun combine(another: CompressedBitSet, operation: Int) {
+        var index = 0
+        while (index < chunkCount) {
+            val anotherIndex = another.chunkIndex(keys[index].toInt())
+            val result: Chunk? = when {
+                anotherIndex >= 0 -> combineChunks(chunkAt(index), another.chunkAt(anotherIndex), operation)
+                operation == BitSetOperation.AND -> null
+                else -> chunkAt(index)
+            }
+            if (result == null || result.cardinality == 0) {
+                removeChunk(index)
+            } else {
+                chunks[index] = result
+                index++
+            }
+        }
+    }
+
+    private fun combineChunks(chunk: Chunk, anotherChunk: Chunk, operation: Int): Chunk? {
+        if (operation == BitSetOperation.AND && (chunk is ArrayChunk || anotherChunk is ArrayChunk)) {
+            // The result is no larger than the smaller chunk, so filter it instead of building bitmaps.
+            val small = if (chunk.cardinality <= anotherChunk.cardinality) chunk else anotherChunk
+            val large = if (small === chunk) anotherChunk else chunk
+            val values = CharArray(small.cardinality)
+            var count = 0
+            small.forEach(0) { if (it in large) values[count++] = it.toChar() }
+            return if (count == 0) null else ArrayChunk(values, count)
+        }
+        val bitmap = if (chunk is BitmapChunk) chunk else chunk.toBitmap()
+        return bitmap.applyOperation(anotherChunk.toBitmap(), operation)
+    }
+
+    /** Returns `true` if [another] set has any elements that are also in this set. */
+    fun intersects(another: CompressedBitSet): Boolean {
+        for (index in 0 until chunkCount) {
+            val anotherIndex = another.chunkIndex(keys[index].toInt())
+            if (anotherIndex < 0) continue
+            val chunk = chunkAt(index)
+            val anotherChunk = another.chunkAt(anotherIndex)
+            if (chunk is BitmapChunk && anotherChunk is BitmapChunk) {
+                if (bitSetIntersects(chunk.words, anotherChunk.words)) return true
+            } else {
+                val small = if (chunk.cardinality <= anotherChunk.cardinality) chunk else anotherChunk
+                val large = if (small === chunk) anotherChunk else chunk
+                var found = false
+                small.forEach(0) { if (!found && it in large) found = true }
+                if (found) return true
+            }
+        }
+        return false
+    }
+
+    /** Returns a [BitSet] with the same elements. */
+    fun toBitSet(): BitSet {
+        val result = BitSet(0)
+        forEachSetBit { result.set(it) }
+        return result
+    }
+
+    override fun toString(): String {
+        val sb = StringBuilder()
+        var first = true
+        sb.append('[')
+        forEachSetBit { index ->
+            if (!first) {
+                sb.append('|')
+            } else {
+                first = false
+            }
+            sb.append(index)
+        }
+        sb.append(']')
+        return sb.toString()
+    }
+
+    override fun hashCode(): Int {
+        var result = 1
+        forEachSetBit { result = result * 31 + it }
+        return result
+    }
+
+    override fun equals(other: Any?): Boolean {
+        if (this === other) {
+            return true
+        }
+        if (other !is CompressedBitSet || chunkCount != other.chunkCount) {
+            return false
+        }
+        for (index in 0 until chunkCount) {
+            if (keys[index] != other.keys[index]) return false
+            val chunk = chunkAt(index)
+            val otherChunk = other.chunkAt(index)
+            if (chunk.cardinality != otherChunk.cardinality) return false
+            // Chunks are normalized, so equal ones have the same representation.
+            if (chunk is ArrayChunk && otherChunk is ArrayChunk) {
+                for (i in 0 until chunk.cardinality) if (chunk.values[i] != otherChunk.values[i]) return false
+            } else if (chunk is BitmapChunk && otherChunk is BitmapChunk) {
+                if (!chunk.words.contentEquals(otherChunk.words)) return false
+            } else {
+                return false
+            }
+        }
+        return true
+    }
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native
+
+// Hash functions and checksums computed by the runtime over array ranges, without copying.
+
+// Sizes of the native contexts in longs, must match Hashing.cpp.
+private const val SHA1_CONTEXT_SIZE = 12
+private const val SHA256_CONTEXT_SIZE = 13
+
+@SymbolName("Kotlin_ByteArray_cityHash64")
+private external fun arrayCityHash64(array: ByteArray, fromIndex: Int, toIndex: Int): Long
+
+@SymbolName("Kotlin_ByteArray_cityHash64WithSeed")
+private external fun arrayCityHash64(array: ByteArray, fromIndex: Int, toIndex: Int, seed: Long): Long
+
+@SymbolName("Kotlin_String_cityHash64")
+private external fun stringCityHash64(string: String): Long
+
+@SymbolName("Kotlin_ByteArray_crc32c")
+private external fun arrayCrc32c(array: ByteArray, fromIndex: Int, toIndex: Int, crc: Int): Int
+
+@SymbolName("Kotlin_Sha1_init")
+private external fun sha1Init(context: LongArray)
+
+@SymbolName("Kotlin_Sha1_update")
+private external fun sha1Update(context: LongArray, data: ByteArray, fromIndex: Int, toIndex: Int)
+
+@SymbolName("Kotlin_Sha1_digest")
+private external fun sha1Digest(context: LongArray, digest: ByteArray)
+
+@SymbolName("Kotlin_Sha256_init")
+private external fun sha256Init(context: LongArray)
+
+@SymbolName("Kotlin_Sha256_update")
+private external fun sha256Update(context: LongArray, data: ByteArray, fromIndex: Int, toIndex: Int)
+
+@SymbolName("Kotlin_Sha256_digest")
+private external fun sha256Digest(context: LongArray, digest: ByteArray)
+
+/**
+ * Returns the 64-bit CityHash of the bytes of this array from [startIndex] (inclusive) to [endIndex] (exclusive).
+ * By default, the whole array is hashed.
+ *
+ * The hash is not cryptographic, and may change between versions of the runtime, so it must not be persisted.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun ByteArray.cityHash64(startIndex: Int = 0, endIndex: Int = size): Long {
+    checkRangeIndexes(startIndex, endIndex, size)
+    return arrayCityHash64(this, startIndex, endIndex)
+}
+
+/**
+ * Returns the 64-bit CityHash of the bytes of this array from [startIndex] (inclusive) to [endIndex] (exclusive),
+ * with [seed] hashed into the result. By default, the whole array is hashed.
+ *
+ * The hash is not cryptographic, and may change between versions of the runtime, so it must not be persisted.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun ByteArray.cityHash64(seed: Long, startIndex: Int = 0, endIndex: Int = size): Long {
+    checkRangeIndexes(startIndex, endIndex, size)
+    return arrayCityHash64(this, startIndex, endIndex, seed)
+}
+
+/**
+ * Returns the 64-bit CityHash of the UTF-16 code units of this string. [String.hashCode] is the lower half of it.
+ *
+ * The hash is not cryptographic, and may change between versions of the runtime, so it must not be persisted.
+ */
+public fun String.cityHash64(): Long = stringCityHash64(this)
+
+/**
+ * Returns the CRC-32C (Castagnoli) checksum of the bytes of this array from [startIndex] (inclusive)
+ * to [endIndex] (exclusive), continuing the checksum [crc] of the preceding data. By default, the whole array
+ * is checksummed from scratch.
+ *
+ * Uses the CRC32 instructions of the processor when available.
+ *
+ * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of this array.
+ * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+ */
+public fun ByteArray.crc32c(startIndex: Int = 0, endIndex: Int = size, crc: Int = 0): Int {
+    checkRangeIndexes(startIndex, endIndex, size)
+    return arrayCrc32c(this, startIndex, endIndex, crc)
+}
+
+/**
+ * Streaming SHA-1 message digest, using the SHA extensions of the processor when available.
+ *
+ * SHA-1 is not collision resistant, use [Sha256] where it matters.
+ */
+public class Sha1 {
+    private val context = LongArray(SHA1_CONTEXT_SIZE).also { sha1Init(it) }
+
+    /**
+     * Adds the bytes of the [data] array from [startIndex] (inclusive) to [endIndex] (exclusive) to the digest.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+     */
+    public fun update(data: ByteArray, startIndex: Int = 0, endIndex: Int = data.size): Sha1 {
+        checkRangeIndexes(startIndex, endIndex, data.size)
+        sha1Update(context, data, startIndex, endIndex)
+        return this
+    }
+
+    /**
+     * Returns the 20-byte digest of the data added so far, and resets the state.
+     */
+    public fun digest(): ByteArray = ByteArray(DIGEST_SIZE).also { sha1Digest(context, it) }
+
+    /**
+     * Discards the data added so far.
+     */
+    public fun reset() = sha1Init(context)
+
+    public companion object {
+        /** Size of the digest in bytes. */
+        public const val DIGEST_SIZE: Int = 20
+    }
+}
+
+/**
+ * Streaming SHA-256 message digest, using the SHA extensions of the processor when available.
+ */
+public class Sha256 {
+    private val context = LongArray(SHA256_CONTEXT_SIZE).also { sha256Init(it) }
+
+    /**
+     * Adds the bytes of the [data] array from [startIndex] (inclusive) to [endIndex] (exclusive) to the digest.
+     *
+     * @throws IndexOutOfBoundsException if [startIndex] is less than zero or [endIndex] is greater than the size of the array.
+     * @throws IllegalArgumentException if [startIndex] is greater than [endIndex].
+     */
+    public fun update(data: ByteArray, startIndex: Int = 0, endIndex: Int = data.size): Sha256 {
+        checkRangeIndexes(startIndex, endIndex, data.size)
+        sha256Update(context, data, startIndex, endIndex)
+        return this
+    }
+
+    /**
+     * Returns the 32-byte digest of the data added so far, and resets the state.
+     */
+    public fun digest(): ByteArray = ByteArray(DIGEST_SIZE).also { sha256Digest(context, it) }
+
+    /**
+     * Discards the data added so far.
+     */
+    public fun reset() = sha256Init(context)
+
+    public companion object {
+        /** Size of the digest in bytes. */
+        public const val DIGEST_SIZE: Int = 32
+    }
+}
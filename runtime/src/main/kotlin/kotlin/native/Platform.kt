@@ -38,7 +38,8 @@ public enum class CpuArchitecture(val bitness: Int) {
  */
 public enum class MemoryModel {
     STRICT,
-    RELAXED
+    RELAXED,
+    TRACING
 }
 
 /**
@@ -34,6 +34,23 @@ public fun <T> T.freeze(): T {
     return this
 }
 
+/**
+ * Freezes object subgraph reachable from this object, like [freeze] does, and beforehand makes all references
+ * from the objects being frozen to equal strings and boxed primitives point to a single instance of each, so that the duplicates could be reclaimed. It is useful for large frozen lookup tables
+ * built from repeated values.
+ *
+ * Deduplicated values are only distinguishable by identity, and values referred from already frozen objects,
+ * or having weak references to them, are left as is.
+ *
+ * @throws FreezingException if freezing is not possible, the subgraph is not changed in this case
+ * @return the object itself
+ * @see freeze
+ */
+public fun <T> T.freezeDeduplicated(): T {
+    freezeDeduplicatingInternal(this)
+    return this
+}
+
 /**
  * Checks if given object is null or frozen or permanent (i.e. instantiated at compile-time).
  *
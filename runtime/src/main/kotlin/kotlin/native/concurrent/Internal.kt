@@ -77,6 +77,9 @@ external internal fun attachObjectGraphInternal(stable: NativePtr): Any?
 @SymbolName("Kotlin_Worker_freezeInternal")
 internal external fun freezeInternal(it: Any?)
 
+@SymbolName("Kotlin_Worker_freezeDeduplicatingInternal")
+internal external fun freezeDeduplicatingInternal(it: Any?)
+
 @SymbolName("Kotlin_Worker_isFrozenInternal")
 internal external fun isFrozenInternal(it: Any?): Boolean
 
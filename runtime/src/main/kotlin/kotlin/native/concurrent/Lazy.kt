@@ -5,6 +5,7 @@
 
 package kotlin.native.concurrent
 
+import kotlin.native.internal.ExportTypeInfo
 import kotlin.native.internal.Frozen
 import kotlin.native.internal.NoReorderFields
 
@@ -15,6 +16,7 @@ private external fun ensureAcyclicAndSet(where: Any, index: Int, what: Any?): Bo
 internal external fun readHeapRefNoLock(where: Any, index: Int): Any?
 
 @NoReorderFields
+@ExportTypeInfo("theFreezeAwareLazyImplTypeInfo")
 internal class FreezeAwareLazyImpl<out T>(initializer: () -> T) : Lazy<T> {
     // IMPORTANT: due to simplified ensureAcyclicAndSet() semantics fields here must be ordered like this,
     // as an ordinal is used to refer a field.
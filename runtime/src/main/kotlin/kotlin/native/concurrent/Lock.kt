@@ -12,47 +12,254 @@ private object CurrentThread {
     val id = Any().freeze()
 }
 
+/**
+ * Blocks the current thread while the value equals [expected], until [unpark] is called on this atomic
+ * or [timeoutNanos] elapse (negative value means no timeout). May return spuriously.
+ * Returns `false` if the timeout has elapsed.
+ */
+@SymbolName("Kotlin_AtomicInt_parkIfEquals")
+private external fun AtomicInt.parkIfEquals(expected: Int, timeoutNanos: Long): Boolean
+
+/**
+ * Wakes up one or [all] threads blocked in [parkIfEquals] on this atomic.
+ */
+@SymbolName("Kotlin_AtomicInt_unpark")
+private external fun AtomicInt.unpark(all: Boolean)
+
+private fun AtomicInt.getAndSet(new: Int): Int {
+    while (true) {
+        val old = value
+        if (compareAndSet(old, new)) return old
+    }
+}
+
+// Number of attempts to take a contended lock or permit before the thread is blocked:
+// short critical sections usually complete before it is worth a trip to the kernel.
+private const val SPIN_COUNT = 100
+
+private const val UNLOCKED = 0
+private const val LOCKED = 1
+private const val LOCKED_CONTENDED = 2
+
+/**
+ * Reentrant mutual exclusion lock, which can be shared between workers.
+ *
+ * A contended lock is spun on for a short time, after which waiting threads are blocked
+ * until the lock is released.
+ */
 @Frozen
-internal class Lock {
-    private val locker_ = AtomicInt(0)
+public class Lock {
+    // UNLOCKED, LOCKED, or LOCKED_CONTENDED when there may be threads blocked on it.
+    private val state_ = AtomicInt(UNLOCKED)
+    private val owner_ = AtomicInt(0)
     private val reenterCount_ = AtomicInt(0)
 
-    // TODO: make it properly reschedule instead of spinning.
-    fun lock() {
+    /**
+     * Acquires the lock, blocking the current thread until it is available.
+     */
+    public fun lock() {
         val lockData = CurrentThread.id.hashCode()
-        loop@ do {
-            val old = locker_.compareAndSwap(0, lockData)
-            when (old) {
-                lockData -> {
-                    // Was locked by us already.
-                    reenterCount_.increment()
-                    break@loop
-                }
-                0 -> {
-                    // We just got the lock.
-                    assert(reenterCount_.value == 0)
-                    break@loop
-                }
-            }
-        } while (true)
+        if (owner_.value == lockData) {
+            // Was locked by us already.
+            reenterCount_.increment()
+            return
+        }
+        if (!state_.compareAndSet(UNLOCKED, LOCKED)) {
+            lockContended()
+        }
+        assert(reenterCount_.value == 0)
+        owner_.value = lockData
+    }
+
+    /**
+     * Acquires the lock if it is available or already held by the current thread, and returns `true` if so.
+     */
+    public fun tryLock(): Boolean {
+        val lockData = CurrentThread.id.hashCode()
+        if (owner_.value == lockData) {
+            reenterCount_.increment()
+            return true
+        }
+        if (!state_.compareAndSet(UNLOCKED, LOCKED)) return false
+        owner_.value = lockData
+        return true
     }
 
-    fun unlock() {
+    /**
+     * Releases the lock, which must be held by the current thread.
+     */
+    public fun unlock() {
+        checkHeldByCurrentThread()
         if (reenterCount_.value > 0) {
             reenterCount_.decrement()
         } else {
-            val lockData = CurrentThread.id.hashCode()
-            val old = locker_.compareAndSwap(lockData, 0)
-            assert(old == lockData)
+            release()
+        }
+    }
+
+    internal fun checkHeldByCurrentThread() {
+        if (owner_.value != CurrentThread.id.hashCode())
+            throw IllegalStateException("Lock is not held by the current thread")
+    }
+
+    private fun lockContended() {
+        repeat(SPIN_COUNT) {
+            if (state_.value == UNLOCKED && state_.compareAndSet(UNLOCKED, LOCKED)) return
+        }
+        // Mark the lock as contended, so that the owner wakes us up when releasing it.
+        while (state_.getAndSet(LOCKED_CONTENDED) != UNLOCKED) {
+            state_.parkIfEquals(LOCKED_CONTENDED, -1L)
+        }
+    }
+
+    /**
+     * Fully releases the lock, even if it has been reentered, and returns the number of reentrances
+     * to be passed to [reacquire].
+     */
+    internal fun releaseAll(): Int {
+        checkHeldByCurrentThread()
+        val reenterCount = reenterCount_.value
+        reenterCount_.value = 0
+        release()
+        return reenterCount
+    }
+
+    internal fun reacquire(reenterCount: Int) {
+        lock()
+        reenterCount_.value = reenterCount
+    }
+
+    private fun release() {
+        owner_.value = 0
+        if (state_.getAndSet(UNLOCKED) == LOCKED_CONTENDED) {
+            state_.unpark(all = false)
         }
     }
 }
 
-internal inline fun <R> locked(lock: Lock, block: () -> R): R {
-    lock.lock()
+/**
+ * Executes [block] holding the lock.
+ */
+public inline fun <R> Lock.withLock(block: () -> R): R {
+    lock()
     try {
         return block()
     } finally {
-        lock.unlock()
+        unlock()
+    }
+}
+
+internal inline fun <R> locked(lock: Lock, block: () -> R): R = lock.withLock(block)
+
+/**
+ * Condition variable associated with the [lock], which can be shared between workers.
+ *
+ * As usual for condition variables, waiting may return without a signal, so the awaited state
+ * must be checked in a loop.
+ */
+@Frozen
+public class Condition(public val lock: Lock) {
+    // Incremented by every signal, so that a waiter doesn't miss the ones sent after it has released the lock.
+    private val sequence_ = AtomicInt(0)
+
+    /**
+     * Releases the [lock], blocks until signalled and reacquires the lock.
+     * The lock must be held by the current thread.
+     */
+    public fun await() {
+        awaitNanos(-1L)
     }
-}
\ No newline at end of file
+
+    /**
+     * Same as [await], but waits for at most [timeoutMillis] milliseconds.
+     * Returns `false` if the timeout has elapsed.
+     */
+    public fun await(timeoutMillis: Long): Boolean {
+        require(timeoutMillis >= 0) { "Negative timeout: $timeoutMillis" }
+        return awaitNanos(timeoutMillis * 1_000_000L)
+    }
+
+    private fun awaitNanos(timeoutNanos: Long): Boolean {
+        val sequence = sequence_.value
+        val reenterCount = lock.releaseAll()
+        try {
+            return sequence_.parkIfEquals(sequence, timeoutNanos)
+        } finally {
+            lock.reacquire(reenterCount)
+        }
+    }
+
+    /**
+     * Wakes up one of the threads waiting on this condition.
+     */
+    public fun signal() {
+        sequence_.increment()
+        sequence_.unpark(all = false)
+    }
+
+    /**
+     * Wakes up all threads waiting on this condition.
+     */
+    public fun signalAll() {
+        sequence_.increment()
+        sequence_.unpark(all = true)
+    }
+}
+
+/**
+ * Counting semaphore, which can be shared between workers.
+ */
+@Frozen
+public class Semaphore(permits: Int) {
+    init {
+        require(permits >= 0) { "Negative number of permits: $permits" }
+    }
+
+    private val permits_ = AtomicInt(permits)
+    private val waiters_ = AtomicInt(0)
+
+    /**
+     * Number of currently available permits.
+     */
+    public val availablePermits: Int
+        get() = permits_.value
+
+    /**
+     * Takes a permit, blocking the current thread until one is available.
+     */
+    public fun acquire() {
+        repeat(SPIN_COUNT) {
+            if (tryAcquire()) return
+        }
+        waiters_.increment()
+        try {
+            // release() checks waiters after adding a permit, so we either see the permit or get unparked.
+            while (!tryAcquire()) {
+                permits_.parkIfEquals(0, -1L)
+            }
+        } finally {
+            waiters_.decrement()
+        }
+    }
+
+    /**
+     * Takes a permit if one is available, and returns `true` if so.
+     */
+    public fun tryAcquire(): Boolean {
+        while (true) {
+            val permits = permits_.value
+            if (permits == 0) return false
+            if (permits_.compareAndSet(permits, permits - 1)) return true
+        }
+    }
+
+    /**
+     * Returns a permit, waking up a thread waiting for it if there is one.
+     */
+    public fun release() {
+        permits_.increment()
+        if (waiters_.value > 0) {
+            permits_.unpark(all = false)
+        }
+    }
+}
@@ -86,7 +86,7 @@ public class MutableData constructor(capacity: Int = 16) {
     public fun append(data: COpaquePointer?, count: Int): Unit = locked(lock) {
         if (data == null || count <= 0) return
         val where = resizeDataLocked(this.size + count)
-        buffer.usePinned {
+        buffer.useScopedPinned {
             it -> CopyMemory(it.addressOf(where), data, count)
         }
     }
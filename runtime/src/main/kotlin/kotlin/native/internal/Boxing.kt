@@ -29,6 +29,14 @@ external fun inIntBoxCache(value: Int): Boolean
 external fun getCachedLongBox(value: Long): Long?
 @SymbolName("inLongBoxCache")
 external fun inLongBoxCache(value: Long): Boolean
+@SymbolName("getCachedFloatBox")
+external fun getCachedFloatBox(value: Float): Float?
+@SymbolName("inFloatBoxCache")
+external fun inFloatBoxCache(value: Float): Boolean
+@SymbolName("getCachedDoubleBox")
+external fun getCachedDoubleBox(value: Double): Double?
+@SymbolName("inDoubleBoxCache")
+external fun inDoubleBoxCache(value: Double): Boolean
 
 // TODO: functions below are used for ObjCExport, move and rename them correspondigly.
 
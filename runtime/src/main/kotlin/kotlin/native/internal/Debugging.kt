@@ -0,0 +1,41 @@
+/*
+ * Copyright 2010-2018 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.internal
+
+/**
+ * Counters of the memory manager events, to check that the runtime shortcuts are taken.
+ * Not intended for use outside of the runtime tests.
+ */
+object Debugging {
+    /**
+     * How many lazy values of frozen objects were published without checking that they are not reachable
+     * from the value, as freeze epochs have proven it, since the process start. Shared by all threads.
+     */
+    val prunedAcyclicityChecks: Int
+        get() = getPrunedAcyclicityChecks()
+
+    /**
+     * How many times memory cached by the allocator was returned to the OS, by [GC.trimMemory] or
+     * automatically, see [GC.idleTrimInterval], since the process start. Shared by all threads.
+     */
+    val memoryTrims: Int
+        get() = getMemoryTrims()
+
+    /**
+     * How many boxed primitives the current thread has allocated from its pool, see [GC.boxPoolCapacity].
+     */
+    val reusedBoxes: Int
+        get() = getReusedBoxes()
+
+    @SymbolName("Kotlin_native_internal_Debugging_getPrunedAcyclicityChecks")
+    private external fun getPrunedAcyclicityChecks(): Int
+
+    @SymbolName("Kotlin_native_internal_Debugging_getMemoryTrims")
+    private external fun getMemoryTrims(): Int
+
+    @SymbolName("Kotlin_native_internal_Debugging_getReusedBoxes")
+    private external fun getReusedBoxes(): Int
+}
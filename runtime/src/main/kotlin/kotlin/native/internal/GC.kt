@@ -20,6 +20,11 @@ package kotlin.native.internal
  * Depending on application needs it may select to suspend GC for certain phases of
  * its lifetime, and resume it later on, or just completely turn it off, if GC pauses
  * are less desirable than cyclical garbage leaks.
+ * In relaxed memory model objects are shared, so collection stops all threads with Kotlin runtime
+ * at their next allocation. Threads blocked in the runtime (e.g. waiting for a worker job, a future
+ * or a lock) or running C interop calls do not hold it off.
+ * If some thread running Kotlin code does not stop in time, e.g. as it spins without allocations,
+ * the collection is postponed. On Apple targets C interop calls hold it off as well.
  */
 object GC {
     /**
@@ -78,6 +83,54 @@ object GC {
         get() = getTuneThreshold()
         set(value) = setTuneThreshold(value)
 
+    /**
+     * How many boxed primitives the current thread keeps the memory of for reuse after they are released,
+     * so that boxing values outside of the box caches (see `-Xbox-cache` compiler option) doesn't go
+     * to the allocator, as it happens with generic collections of numbers. 0 by default, i.e. the pool is disabled.
+     *
+     * @throws IllegalArgumentException if the value is negative.
+     */
+    var boxPoolCapacity: Int
+        get() = getBoxPoolCapacity()
+        set(value) {
+            require(value >= 0) { "Box pool capacity must not be negative: $value" }
+            setBoxPoolCapacity(value)
+        }
+
+    /**
+     * Collect garbage and return memory no longer used by the current thread, such as pages cached by
+     * the allocator, to the OS where possible. Useful after a spike of allocations in a long running process.
+     */
+    @SymbolName("Kotlin_native_internal_GC_trimMemory")
+    external fun trimMemory()
+
+    /**
+     * How often, in milliseconds, memory cached by the allocator is automatically returned to the OS,
+     * after garbage collection or while a worker waits for jobs. 0 disables automatic trimming.
+     * Initially taken from `KOTLIN_NATIVE_IDLE_TRIM_MS` environment variable, 0 if not set.
+     * Shared by all threads.
+     *
+     * @throws IllegalArgumentException if the value is negative.
+     */
+    var idleTrimInterval: Long
+        get() = getIdleTrimInterval()
+        set(value) {
+            require(value >= 0) { "Idle trim interval must not be negative: $value" }
+            setIdleTrimInterval(value)
+        }
+
+    /**
+     * Resident set size of the process in bytes, or -1 if not available on the platform.
+     */
+    val residentMemory: Long
+        get() = getResidentMemory()
+
+    /**
+     * Peak resident set size of the process in bytes, or -1 if not available on the platform.
+     */
+    val peakResidentMemory: Long
+        get() = getPeakResidentMemory()
+
     /**
      * Detect cyclic references going via atomic references and return list of cycle-inducing objects
      * or `null` if the leak detector is not available. Use [Platform.isMemoryLeakCheckerActive] to check
@@ -113,4 +166,22 @@ object GC {
 
     @SymbolName("Kotlin_native_internal_GC_setTuneThreshold")
     private external fun setTuneThreshold(value: Boolean)
+
+    @SymbolName("Kotlin_native_internal_GC_getBoxPoolCapacity")
+    private external fun getBoxPoolCapacity(): Int
+
+    @SymbolName("Kotlin_native_internal_GC_setBoxPoolCapacity")
+    private external fun setBoxPoolCapacity(value: Int)
+
+    @SymbolName("Kotlin_native_internal_GC_getIdleTrimInterval")
+    private external fun getIdleTrimInterval(): Long
+
+    @SymbolName("Kotlin_native_internal_GC_setIdleTrimInterval")
+    private external fun setIdleTrimInterval(value: Long)
+
+    @SymbolName("Kotlin_native_internal_GC_getResidentMemory")
+    private external fun getResidentMemory(): Long
+
+    @SymbolName("Kotlin_native_internal_GC_getPeakResidentMemory")
+    private external fun getPeakResidentMemory(): Long
 }
\ No newline at end of file
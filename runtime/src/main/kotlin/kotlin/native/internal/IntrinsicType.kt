@@ -37,6 +37,28 @@ class IntrinsicType {
         const val ARE_EQUAL_BY_VALUE    = "ARE_EQUAL_BY_VALUE"
         const val IEEE_754_EQUALS       = "IEEE_754_EQUALS"
 
+        // Vector128
+        const val VECTOR_FLOAT_PLUS               = "VECTOR_FLOAT_PLUS"
+        const val VECTOR_FLOAT_MINUS              = "VECTOR_FLOAT_MINUS"
+        const val VECTOR_FLOAT_TIMES              = "VECTOR_FLOAT_TIMES"
+        const val VECTOR_FLOAT_DIV                = "VECTOR_FLOAT_DIV"
+        const val VECTOR_FLOAT_FMA                = "VECTOR_FLOAT_FMA"
+        const val VECTOR_FLOAT_MIN                = "VECTOR_FLOAT_MIN"
+        const val VECTOR_FLOAT_MAX                = "VECTOR_FLOAT_MAX"
+        const val VECTOR_FLOAT_EQUALS             = "VECTOR_FLOAT_EQUALS"
+        const val VECTOR_FLOAT_LESS               = "VECTOR_FLOAT_LESS"
+        const val VECTOR_INT_PLUS                 = "VECTOR_INT_PLUS"
+        const val VECTOR_INT_MINUS                = "VECTOR_INT_MINUS"
+        const val VECTOR_INT_TIMES                = "VECTOR_INT_TIMES"
+        const val VECTOR_INT_MIN                  = "VECTOR_INT_MIN"
+        const val VECTOR_INT_MAX                  = "VECTOR_INT_MAX"
+        const val VECTOR_INT_EQUALS               = "VECTOR_INT_EQUALS"
+        const val VECTOR_INT_LESS                 = "VECTOR_INT_LESS"
+        const val VECTOR_AND                      = "VECTOR_AND"
+        const val VECTOR_OR                       = "VECTOR_OR"
+        const val VECTOR_XOR                      = "VECTOR_XOR"
+        const val VECTOR_SHUFFLE                  = "VECTOR_SHUFFLE"
+
         // ObjC related stuff
         const val OBJC_GET_MESSENGER            = "OBJC_GET_MESSENGER"
         const val OBJC_GET_MESSENGER_STRET      = "OBJC_GET_MESSENGER_STRET"
@@ -33,6 +33,85 @@ public final class Vector128 private constructor() {
     @TypedIntrinsic(IntrinsicType.EXTRACT_ELEMENT)
     external fun getULongAt(index: Int): ULong
 
+    /*
+     * Lane-wise operations. The `Float` ones treat the vector as four `Float` lanes, the `Int` ones as four `Int` lanes.
+     * Comparisons return a mask vector, with all bits of a lane set when the predicate holds and cleared otherwise.
+     */
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_PLUS)
+    external fun plusFloat(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_MINUS)
+    external fun minusFloat(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_TIMES)
+    external fun timesFloat(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_DIV)
+    external fun divFloat(other: Vector128): Vector128
+
+    /**
+     * Computes `this * multiplier + addend` for each `Float` lane with a single rounding.
+     */
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_FMA)
+    external fun fmaFloat(multiplier: Vector128, addend: Vector128): Vector128
+
+    /**
+     * Lane-wise `if (this < other) this else other`, so the lane of [other] is taken if either lane is NaN.
+     */
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_MIN)
+    external fun minFloat(other: Vector128): Vector128
+
+    /**
+     * Lane-wise `if (this > other) this else other`, so the lane of [other] is taken if either lane is NaN.
+     */
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_MAX)
+    external fun maxFloat(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_EQUALS)
+    external fun equalsFloat(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_FLOAT_LESS)
+    external fun lessFloat(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_INT_PLUS)
+    external fun plusInt(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_INT_MINUS)
+    external fun minusInt(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_INT_TIMES)
+    external fun timesInt(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_INT_MIN)
+    external fun minInt(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_INT_MAX)
+    external fun maxInt(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_INT_EQUALS)
+    external fun equalsInt(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_INT_LESS)
+    external fun lessInt(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_AND)
+    external infix fun and(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_OR)
+    external infix fun or(other: Vector128): Vector128
+
+    @TypedIntrinsic(IntrinsicType.VECTOR_XOR)
+    external infix fun xor(other: Vector128): Vector128
+
+    /**
+     * Returns the vector made of the lanes [i0], [i1], [i2] and [i3] of this one, e.g. `shuffle(3, 2, 1, 0)` reverses them.
+     * Constant lane indices are compiled to a single shuffle instruction.
+     * @throws IndexOutOfBoundsException if any index is outside of `0..3`.
+     */
+    @TypedIntrinsic(IntrinsicType.VECTOR_SHUFFLE)
+    external fun shuffle(i0: Int, i1: Int, i2: Int, i3: Int): Vector128
+
     public override fun toString() =
             "(0x${getUIntAt(0).toString(16)}, 0x${getUIntAt(1).toString(16)}, 0x${getUIntAt(2).toString(16)}, 0x${getUIntAt(3).toString(16)})"
 
@@ -55,3 +134,31 @@ external fun vectorOf(f0: Float, f1: Float, f2: Float, f3: Float): Vector128
 
 @SymbolName("Kotlin_Vector4i32_of")
 external fun vectorOf(f0: Int, f1: Int, f2: Int, f3: Int): Vector128
+
+/**
+ * Loads four [Float] lanes starting at [index] of the array.
+ * @throws ArrayIndexOutOfBoundsException if `index..index + 3` is outside of array boundaries.
+ */
+@SymbolName("Kotlin_FloatArray_getVector128At")
+external fun FloatArray.getVector128At(index: Int): Vector128
+
+/**
+ * Stores four [Float] lanes of [value] starting at [index] of the array.
+ * @throws ArrayIndexOutOfBoundsException if `index..index + 3` is outside of array boundaries.
+ */
+@SymbolName("Kotlin_FloatArray_setVector128At")
+external fun FloatArray.setVector128At(index: Int, value: Vector128)
+
+/**
+ * Loads four [Int] lanes starting at [index] of the array.
+ * @throws ArrayIndexOutOfBoundsException if `index..index + 3` is outside of array boundaries.
+ */
+@SymbolName("Kotlin_IntArray_getVector128At")
+external fun IntArray.getVector128At(index: Int): Vector128
+
+/**
+ * Stores four [Int] lanes of [value] starting at [index] of the array.
+ * @throws ArrayIndexOutOfBoundsException if `index..index + 3` is outside of array boundaries.
+ */
+@SymbolName("Kotlin_IntArray_setVector128At")
+external fun IntArray.setVector128At(index: Int, value: Vector128)
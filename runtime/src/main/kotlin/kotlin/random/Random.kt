@@ -4,34 +4,82 @@
  */
 package kotlin.random
 
-import kotlin.native.concurrent.AtomicLong
-import kotlin.system.getTimeNanos
+import kotlin.native.SymbolName
 
 /**
- * The default implementation of pseudo-random generator using the linear congruential generator.
+ * The default implementation of pseudo-random generator: xoshiro256** implemented in the runtime,
+ * with the state local to each thread and seeded independently.
  */
 internal object NativeRandom : Random() {
-    private const val MULTIPLIER = 0x5deece66dL
-    private val _seed = AtomicLong(mult(getTimeNanos()))
+    override fun nextBits(bitCount: Int): Int =
+            nextInt().ushr(32 - bitCount) and (-bitCount).shr(31)
 
-    /**
-     * Random generator seed value.
-     */
-    private val seed: Long
-        get() = _seed.value
+    // The upper bits of xoshiro256** output are of the best quality.
+    override fun nextInt(): Int = (nextLong() ushr 32).toInt()
 
-    private fun mult(value: Long) = (value xor MULTIPLIER) and ((1L shl 48) - 1)
+    override fun nextLong(): Long = nextRandomLong()
 
-    private fun update(seed: Long): Unit {
-        _seed.value = seed
+    override fun nextDouble(): Double = nextRandomDouble()
+
+    override fun nextBytes(array: ByteArray, fromIndex: Int, toIndex: Int): ByteArray {
+        checkRange(array.size, fromIndex, toIndex)
+        fillRandomBytes(array, fromIndex, toIndex)
+        return array
     }
+}
+
+@SymbolName("Kotlin_Random_nextLong")
+private external fun nextRandomLong(): Long
+
+@SymbolName("Kotlin_Random_nextDouble")
+private external fun nextRandomDouble(): Double
+
+@SymbolName("Kotlin_Random_fillBytes")
+private external fun fillRandomBytes(array: ByteArray, fromIndex: Int, toIndex: Int)
 
-    override fun nextBits(bitCount: Int): Int {
-        update((seed * MULTIPLIER + 0xbL) and ((1L shl 48) - 1))
-        return (seed ushr (48 - bitCount)).toInt()
+@SymbolName("Kotlin_Random_fillInts")
+private external fun fillRandomInts(array: IntArray, fromIndex: Int, toIndex: Int)
+
+@SymbolName("Kotlin_Random_fillDoubles")
+private external fun fillRandomDoubles(array: DoubleArray, fromIndex: Int, toIndex: Int)
+
+// Same checks as in the common Random.nextBytes().
+private fun checkRange(size: Int, fromIndex: Int, toIndex: Int) {
+    require(fromIndex in 0..size && toIndex in 0..size) {
+        "fromIndex ($fromIndex) or toIndex ($toIndex) are out of range: 0..$size."
     }
+    require(fromIndex <= toIndex) { "fromIndex ($fromIndex) must be not greater than toIndex ($toIndex)." }
+}
+
+private val Random.isNative: Boolean
+    get() = this === NativeRandom || this === Random.Default
 
-    override fun nextInt(): Int = nextBits(32)
+/**
+ * Fills the [array] from [fromIndex] (inclusive) to [toIndex] (exclusive) with random [Int] values
+ * and returns it. For the default generator this is done by the runtime in one call.
+ */
+public fun Random.fillInts(array: IntArray, fromIndex: Int = 0, toIndex: Int = array.size): IntArray {
+    checkRange(array.size, fromIndex, toIndex)
+    if (isNative) {
+        fillRandomInts(array, fromIndex, toIndex)
+    } else {
+        for (index in fromIndex until toIndex) array[index] = nextInt()
+    }
+    return array
+}
+
+/**
+ * Fills the [array] from [fromIndex] (inclusive) to [toIndex] (exclusive) with random [Double] values
+ * uniformly distributed in `[0, 1)` and returns it. For the default generator this is done by the runtime in one call.
+ */
+public fun Random.fillDoubles(array: DoubleArray, fromIndex: Int = 0, toIndex: Int = array.size): DoubleArray {
+    checkRange(array.size, fromIndex, toIndex)
+    if (isNative) {
+        fillRandomDoubles(array, fromIndex, toIndex)
+    } else {
+        for (index in fromIndex until toIndex) array[index] = nextDouble()
+    }
+    return array
 }
 
 internal actual fun defaultPlatformRandom(): Random = NativeRandom
@@ -376,6 +376,13 @@ static mi_heap_t* mi_heap_of_block(const void* p) {
   return _mi_segment_page_of(segment,p)->heap;
 }
 
+#if KONAN_MI_MALLOC
+// Only reads the heap pointer of the page, which may be stale when called from another thread.
+mi_heap_t* konan_mi_heap_of_block(const void* p) {
+  return mi_heap_of_block(p);
+}
+#endif
+
 bool mi_heap_contains_block(mi_heap_t* heap, const void* p) {
   mi_assert(heap != NULL);
   if (!mi_heap_is_initialized(heap)) return false;
@@ -209,6 +209,9 @@ mi_decl_export mi_decl_allocator void* mi_heap_recalloc_aligned_at(mi_heap_t* he
 // ------------------------------------------------------
 
 mi_decl_export bool mi_heap_contains_block(mi_heap_t* heap, const void* p);
+#if KONAN_MI_MALLOC
+mi_decl_export mi_heap_t* konan_mi_heap_of_block(const void* p);
+#endif
 
 mi_decl_export bool mi_heap_check_owned(mi_heap_t* heap, const void* p);
 mi_decl_export bool mi_check_owned(const void* p);
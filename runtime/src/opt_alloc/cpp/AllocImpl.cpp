@@ -4,14 +4,73 @@
  */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 extern "C" {
+// Must match mi_option_t from mimalloc.h.
+enum mi_option_e {
+  mi_option_large_os_pages = 5,
+  mi_option_reserve_huge_os_pages = 6
+};
+typedef enum mi_option_e mi_option_t;
+void mi_option_set(mi_option_t, long);
+struct mi_heap_s;
+typedef struct mi_heap_s mi_heap_t;
 void* mi_calloc(size_t, size_t);
 void mi_free(void*);
+mi_heap_t* mi_heap_new();
+void mi_heap_delete(mi_heap_t*);
+void* mi_heap_calloc(mi_heap_t*, size_t, size_t);
+mi_heap_t* konan_mi_heap_of_block(const void*);
+void mi_heap_collect(mi_heap_t*, bool);
+void mi_collect(bool);
 void* konan_calloc_impl(size_t n_elements, size_t elem_size) {
  return mi_calloc(n_elements, elem_size);
 }
 void konan_free_impl (void* mem) {
   mi_free(mem);
 }
+void* konan_heap_create_impl() {
+  return mi_heap_new();
+}
+// Blocks still allocated in the heap are moved to the default heap of the thread.
+void konan_heap_destroy_impl(void* heap) {
+  mi_heap_delete(static_cast<mi_heap_t*>(heap));
+}
+void* konan_heap_calloc_impl(void* heap, size_t n_elements, size_t elem_size) {
+  return mi_heap_calloc(static_cast<mi_heap_t*>(heap), n_elements, elem_size);
+}
+void* konan_heap_of_impl(void* mem) {
+  return konan_mi_heap_of_block(mem);
+}
+// Whether freed pages are reset or decommitted is controlled by MIMALLOC_PAGE_RESET,
+// MIMALLOC_SEGMENT_RESET and MIMALLOC_RESET_DECOMMITS environment variables.
+void konan_trim_impl(void* heap) {
+  if (heap != nullptr)
+    mi_heap_collect(static_cast<mi_heap_t*>(heap), true);
+  mi_collect(true);
+}
 }  // extern "C"
+
+namespace {
+
+// Backs the object heap with huge pages when KOTLIN_NATIVE_HUGE_PAGES is set:
+//  - "madvise": 2MiB pages for mimalloc regions, with MAP_HUGETLB if possible and
+//    MADV_HUGEPAGE (transparent huge pages) otherwise;
+//  - "reserve:N": same, plus N 1GiB pages pre-reserved with MAP_HUGETLB at startup.
+// mimalloc reads its options and page sizes once, when the process is loaded, so they
+// must be set before its own constructor runs.
+__attribute__((constructor(101))) void initHugePages() {
+  const char* value = getenv("KOTLIN_NATIVE_HUGE_PAGES");
+  if (value == nullptr) return;
+  if (strcmp(value, "madvise") == 0) {
+    mi_option_set(mi_option_large_os_pages, 1);
+  } else if (strncmp(value, "reserve:", 8) == 0) {
+    long pages = strtol(value + 8, nullptr, 10);
+    if (pages <= 0) return;
+    mi_option_set(mi_option_large_os_pages, 1);
+    mi_option_set(mi_option_reserve_huge_os_pages, pages);
+  }
+}
+
+}  // namespace
@@ -4,6 +4,9 @@
  */
 #include <stdlib.h>
 #include <stdio.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 extern "C" {
 // Memory operations.
@@ -13,5 +16,21 @@ void* konan_calloc_impl(size_t n_elements, size_t elem_size) {
 void konan_free_impl (void* mem) {
   free(mem);
 }
+// System allocator has no thread local heaps.
+void* konan_heap_create_impl() {
+  return nullptr;
+}
+void konan_heap_destroy_impl(void* heap) {}
+void* konan_heap_calloc_impl(void* heap, size_t n_elements, size_t elem_size) {
+  return calloc(n_elements, elem_size);
+}
+void* konan_heap_of_impl(void* mem) {
+  return nullptr;
+}
+void konan_trim_impl(void* heap) {
+#if defined(__GLIBC__)
+  malloc_trim(0);
+#endif
+}
 }
 
@@ -10,6 +10,7 @@
 extern "C" {
 
 const bool IsStrictMemoryModel = true;
+const bool IsTracingMemoryModel = false;
 
 OBJ_GETTER(AllocInstance, const TypeInfo* typeInfo) {
   RETURN_RESULT_OF(AllocInstanceStrict, typeInfo);
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+#include "Memory.h"
+#include "MemoryPrivate.hpp"
+
+// Note that only C++ part of the runtime goes via those functions, Kotlin uses specialized versions.
+
+extern "C" {
+
+const bool IsStrictMemoryModel = false;
+const bool IsTracingMemoryModel = true;
+
+OBJ_GETTER(AllocInstance, const TypeInfo* typeInfo) {
+  RETURN_RESULT_OF(AllocInstanceTracing, typeInfo);
+}
+
+OBJ_GETTER(AllocArrayInstance, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(AllocArrayInstanceTracing, typeInfo, elements);
+}
+
+OBJ_GETTER(InitInstance,
+    ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
+  RETURN_RESULT_OF(InitInstanceTracing, location, typeInfo, ctor);
+}
+
+OBJ_GETTER(InitSharedInstance,
+    ObjHeader** location, ObjHeader** localLocation, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
+  RETURN_RESULT_OF(InitSharedInstanceTracing, location, localLocation, typeInfo, ctor);
+}
+
+void ReleaseHeapRef(const ObjHeader* object) {
+  ReleaseHeapRefTracing(object);
+}
+
+void ZeroStackRef(ObjHeader** location) {
+  ZeroStackRefTracing(location);
+}
+
+void SetStackRef(ObjHeader** location, const ObjHeader* object) {
+  SetStackRefTracing(location, object);
+}
+
+void SetHeapRef(ObjHeader** location, const ObjHeader* object) {
+  SetHeapRefTracing(location, object);
+}
+
+void UpdateHeapRef(ObjHeader** location, const ObjHeader* object) {
+  UpdateHeapRefTracing(location, object);
+}
+
+void UpdateReturnRef(ObjHeader** returnSlot, const ObjHeader* object) {
+  UpdateReturnRefTracing(returnSlot, object);
+}
+
+void EnterFrame(ObjHeader** start, int parameters, int count) {
+  EnterFrameTracing(start, parameters, count);
+}
+
+void LeaveFrame(ObjHeader** start, int parameters, int count) {
+  LeaveFrameTracing(start, parameters, count);
+}
+
+}  // extern "C"
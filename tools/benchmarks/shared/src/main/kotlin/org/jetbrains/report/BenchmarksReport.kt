@@ -257,7 +257,8 @@ class BenchmarkResult(val name: String, val status: Status,
     enum class Metric(val suffix: String, val value: String) {
         EXECUTION_TIME("", "EXECUTION_TIME"),
         CODE_SIZE(".codeSize", "CODE_SIZE"),
-        COMPILE_TIME(".compileTime", "COMPILE_TIME")
+        COMPILE_TIME(".compileTime", "COMPILE_TIME"),
+        CPU_TIME(".cpuTime", "CPU_TIME")
     }
 
     constructor(name: String, score: Double) : this(name, Status.PASSED, score, Metric.EXECUTION_TIME, 0.0, 0, 0)